@@ -0,0 +1,533 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mqtt5/types.hpp>
+
+#include <boost/mqtt5/impl/codecs/message_decoders.hpp>
+#include <boost/mqtt5/impl/codecs/message_encoders.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "bench_common/bench.hpp"
+
+using namespace boost::mqtt5;
+
+namespace {
+
+const std::string topic = "site/57/device/33/temperature";
+const std::string payload = "21.5";
+
+const publish_props no_props {};
+
+const publish_props some_props = [] {
+    publish_props props;
+    props[prop::message_expiry_interval] = 60;
+    props[prop::content_type] = "text/plain";
+    return props;
+}();
+
+// Properties of a message forwarded through a gateway.
+const publish_props many_props = [] {
+    publish_props props;
+    props[prop::message_expiry_interval] = 60;
+    props[prop::content_type] = "application/json";
+    props[prop::response_topic] = "site/57/device/33/reply";
+    props[prop::correlation_data] = "0123456789abcdef";
+    props[prop::user_property].emplace_back("source", "gateway-7");
+    props[prop::user_property].emplace_back("trace", "4bf92f3577b34da6");
+    return props;
+}();
+
+const puback_props ack_props = [] {
+    puback_props props;
+    props[prop::reason_string] = "No matching subscribers";
+    props[prop::user_property].emplace_back("source", "gateway-7");
+    return props;
+}();
+
+const std::vector<subscribe_topic> subscribe_topics = {
+    { "site/57/device/+/temperature", subscribe_options {} },
+    { "site/57/alarms/#", subscribe_options { qos_e::at_least_once } },
+};
+
+const std::vector<std::string> unsubscribe_topics = {
+    "site/57/device/+/temperature", "site/57/alarms/#"
+};
+
+const std::vector<uint8_t> sub_reason_codes = { 0x00, 0x01 };
+
+std::string publish_packet(
+    const std::string& payload, const publish_props& props
+) {
+    return encoders::encode_publish(
+        1, topic, payload, qos_e::at_least_once, retain_e::no, dup_e::no, props
+    );
+}
+
+std::string publish_packet(const publish_props& props) {
+    return publish_packet(payload, props);
+}
+
+// Decodes the packet the way the Client does: fixed header first,
+// then the rest of the packet.
+template <typename Decode>
+void decode_packet(const std::string& packet, Decode&& decode) {
+    detail::byte_citer it = packet.cbegin(), last = packet.cend();
+    auto header = decoders::decode_fixed_header(it, last);
+    const auto& [control_byte, remain_length] = *header;
+    bench::do_not_optimize(decode(control_byte, remain_length, it));
+}
+
+// As decode_packet, for packets whose Packet Identifier the Client
+// decodes before the rest of the packet.
+template <typename Decode>
+void decode_packet_with_id(const std::string& packet, Decode&& decode) {
+    decode_packet(packet, [&decode](uint8_t, uint32_t remain_length, auto& it) {
+        decoders::decode_packet_id(it);
+        return decode(remain_length - uint32_t(sizeof(uint16_t)), it);
+    });
+}
+
+/*
+    The PUBLISH benchmarks below run for every combination of
+    the Payload sizes and property mixes, as codecs/name/<size>b_<props>.
+*/
+constexpr size_t payload_sizes[] = { 16, 1024, 64 * 1024 };
+
+struct property_mix {
+    const char* name;
+    const publish_props* props;
+};
+
+const property_mix property_mixes[] = {
+    { "no_props", &no_props },
+    { "many_props", &many_props },
+};
+
+template <typename Bench>
+bool register_publish_benchmarks(const std::string& name, Bench bench) {
+    for (size_t size : payload_sizes)
+        for (const auto& mix : property_mixes)
+            bench::registrar {
+                "codecs/" + name + "/" + std::to_string(size) + "b_" + mix.name,
+                [bench, size, mix](bench::state& state) {
+                    bench(state, std::string(size, 'p'), *mix.props);
+                }
+            };
+    return true;
+}
+
+const bool encode_publish_registered = register_publish_benchmarks(
+    "encode_publish",
+    [](bench::state& state, const std::string& payload, const publish_props& props) {
+        state.bytes_per_op(publish_packet(payload, props).size());
+        state.run([&] {
+            bench::do_not_optimize(publish_packet(payload, props));
+        });
+    }
+);
+
+const bool encode_publish_to_registered = register_publish_benchmarks(
+    "encode_publish_to",
+    [](bench::state& state, const std::string& payload, const publish_props& props) {
+        std::string out;
+        state.bytes_per_op(publish_packet(payload, props).size());
+        state.run([&] {
+            out.clear();
+            encoders::encode_publish_to(
+                out, 1, topic, payload, qos_e::at_least_once, retain_e::no,
+                dup_e::no, props
+            );
+            bench::do_not_optimize(out);
+        });
+    }
+);
+
+const bool encode_templated_publish_registered = register_publish_benchmarks(
+    "encode_templated_publish",
+    [](bench::state& state, const std::string& payload, const publish_props& props) {
+        publish_template tmpl {
+            encoders::encode_publish_template(topic, props),
+            sizeof(uint16_t) + topic.size(), false
+        };
+        state.bytes_per_op(publish_packet(payload, props).size());
+        state.run([&] {
+            bench::do_not_optimize(encoders::encode_templated_publish(
+                1, tmpl, payload, qos_e::at_least_once, retain_e::no, dup_e::no
+            ));
+        });
+    }
+);
+
+const bool decode_publish_registered = register_publish_benchmarks(
+    "decode_publish",
+    [](bench::state& state, const std::string& payload, const publish_props& props) {
+        auto packet = publish_packet(payload, props);
+        state.bytes_per_op(packet.size());
+        state.run([&] {
+            decode_packet(packet, [](uint8_t control_byte, uint32_t remain_length, auto& it) {
+                return decoders::decode_publish(control_byte, remain_length, it);
+            });
+        });
+    }
+);
+
+const bool decode_publish_view_registered = register_publish_benchmarks(
+    "decode_publish_view",
+    [](bench::state& state, const std::string& payload, const publish_props& props) {
+        auto packet = publish_packet(payload, props);
+        state.bytes_per_op(packet.size());
+        state.run([&] {
+            decode_packet(packet, [](uint8_t control_byte, uint32_t remain_length, auto& it) {
+                return decoders::decode_publish_view(control_byte, remain_length, it);
+            });
+        });
+    }
+);
+
+const bool decode_publish_raw_props_registered = register_publish_benchmarks(
+    "decode_publish_raw_props",
+    [](bench::state& state, const std::string& payload, const publish_props& props) {
+        auto packet = publish_packet(payload, props);
+        state.bytes_per_op(packet.size());
+        state.run([&] {
+            decode_packet(packet, [](uint8_t control_byte, uint32_t remain_length, auto& it) {
+                return decoders::decode_publish_raw_props(control_byte, remain_length, it);
+            });
+        });
+    }
+);
+
+} // end anonymous namespace
+
+BOOST_MQTT5_BENCHMARK(codecs, encode_connect) {
+    connect_props props;
+    props[prop::session_expiry_interval] = 3600;
+    props[prop::receive_maximum] = uint16_t(100);
+    state.run([&] {
+        bench::do_not_optimize(encoders::encode_connect(
+            "device-33", "user", "password", 60, false, props, std::nullopt
+        ));
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, encode_connack) {
+    connack_props props;
+    props[prop::receive_maximum] = uint16_t(100);
+    props[prop::topic_alias_maximum] = uint16_t(10);
+    state.run([&] {
+        bench::do_not_optimize(encoders::encode_connack(false, 0, props));
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, encode_publish_no_props) {
+    state.bytes_per_op(publish_packet(no_props).size());
+    state.run([&] {
+        bench::do_not_optimize(publish_packet(no_props));
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, encode_publish_props) {
+    state.bytes_per_op(publish_packet(some_props).size());
+    state.run([&] {
+        bench::do_not_optimize(publish_packet(some_props));
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, encode_publish_template) {
+    state.run([&] {
+        bench::do_not_optimize(encoders::encode_publish_template(topic, many_props));
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, encode_puback) {
+    state.run([&] {
+        bench::do_not_optimize(encoders::encode_puback(1, 0, puback_props {}));
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, encode_puback_props) {
+    state.run([&] {
+        bench::do_not_optimize(encoders::encode_puback(1, 0x10, ack_props));
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, encode_pubrec) {
+    state.run([&] {
+        bench::do_not_optimize(encoders::encode_pubrec(1, 0, pubrec_props {}));
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, encode_pubrel) {
+    state.run([&] {
+        bench::do_not_optimize(encoders::encode_pubrel(1, 0, pubrel_props {}));
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, encode_pubcomp) {
+    state.run([&] {
+        bench::do_not_optimize(encoders::encode_pubcomp(1, 0, pubcomp_props {}));
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, encode_subscribe) {
+    state.run([&] {
+        bench::do_not_optimize(
+            encoders::encode_subscribe(1, subscribe_topics, subscribe_props {})
+        );
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, encode_suback) {
+    state.run([&] {
+        bench::do_not_optimize(
+            encoders::encode_suback(1, sub_reason_codes, suback_props {})
+        );
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, encode_unsubscribe) {
+    state.run([&] {
+        bench::do_not_optimize(
+            encoders::encode_unsubscribe(1, unsubscribe_topics, unsubscribe_props {})
+        );
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, encode_unsuback) {
+    state.run([&] {
+        bench::do_not_optimize(
+            encoders::encode_unsuback(1, sub_reason_codes, unsuback_props {})
+        );
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, encode_pingreq) {
+    state.run([&] {
+        bench::do_not_optimize(encoders::encode_pingreq());
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, encode_pingresp) {
+    state.run([&] {
+        bench::do_not_optimize(encoders::encode_pingresp());
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, encode_disconnect) {
+    disconnect_props props;
+    props[prop::reason_string] = "Keep Alive timeout";
+    state.run([&] {
+        bench::do_not_optimize(encoders::encode_disconnect(0x8D, props));
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, encode_auth) {
+    auth_props props;
+    props[prop::authentication_method] = "SCRAM-SHA-256";
+    props[prop::authentication_data] = std::string(32, 'd');
+    state.run([&] {
+        bench::do_not_optimize(encoders::encode_auth(0x18, props));
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, decode_fixed_header) {
+    auto packet = publish_packet(no_props);
+    state.run([&] {
+        detail::byte_citer it = packet.cbegin();
+        bench::do_not_optimize(decoders::decode_fixed_header(it, packet.cend()));
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, decode_connect) {
+    connect_props props;
+    props[prop::session_expiry_interval] = 3600;
+    props[prop::receive_maximum] = uint16_t(100);
+    auto packet = encoders::encode_connect(
+        "device-33", "user", "password", 60, false, props, std::nullopt
+    );
+    state.run([&] {
+        decode_packet(packet, [](uint8_t, uint32_t remain_length, auto& it) {
+            return decoders::decode_connect(remain_length, it);
+        });
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, decode_connack) {
+    connack_props props;
+    props[prop::receive_maximum] = uint16_t(100);
+    props[prop::topic_alias_maximum] = uint16_t(10);
+    auto packet = encoders::encode_connack(false, 0, props);
+    state.run([&] {
+        decode_packet(packet, [](uint8_t, uint32_t remain_length, auto& it) {
+            return decoders::decode_connack(remain_length, it);
+        });
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, decode_publish_no_props) {
+    auto packet = publish_packet(no_props);
+    state.bytes_per_op(packet.size());
+    state.run([&] {
+        decode_packet(packet, [](uint8_t control_byte, uint32_t remain_length, auto& it) {
+            return decoders::decode_publish(control_byte, remain_length, it);
+        });
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, decode_publish_props) {
+    auto packet = publish_packet(some_props);
+    state.bytes_per_op(packet.size());
+    state.run([&] {
+        decode_packet(packet, [](uint8_t control_byte, uint32_t remain_length, auto& it) {
+            return decoders::decode_publish(control_byte, remain_length, it);
+        });
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, decode_publish_view) {
+    auto packet = publish_packet(no_props);
+    state.bytes_per_op(packet.size());
+    state.run([&] {
+        decode_packet(packet, [](uint8_t control_byte, uint32_t remain_length, auto& it) {
+            return decoders::decode_publish_view(control_byte, remain_length, it);
+        });
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, decode_publish_view_many_props) {
+    auto packet = publish_packet(many_props);
+    state.bytes_per_op(packet.size());
+    state.run([&] {
+        decode_packet(packet, [](uint8_t control_byte, uint32_t remain_length, auto& it) {
+            return decoders::decode_publish_view(control_byte, remain_length, it);
+        });
+    });
+}
+
+// Decoding as done with zero-copy receive, where the properties are
+// decoded only if the application asks for them.
+BOOST_MQTT5_BENCHMARK(codecs, decode_publish_raw_props_many_props) {
+    auto packet = publish_packet(many_props);
+    state.bytes_per_op(packet.size());
+    state.run([&] {
+        decode_packet(packet, [](uint8_t control_byte, uint32_t remain_length, auto& it) {
+            return decoders::decode_publish_raw_props(control_byte, remain_length, it);
+        });
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, decode_puback) {
+    // PUBACK with Reason Code and empty properties
+    auto packet = encoders::encode_puback(1, 0x10, puback_props {});
+    state.run([&] {
+        decode_packet_with_id(packet, [](uint32_t remain_length, auto& it) {
+            return decoders::decode_puback(remain_length, it);
+        });
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, decode_puback_props) {
+    auto packet = encoders::encode_puback(1, 0x10, ack_props);
+    state.run([&] {
+        decode_packet_with_id(packet, [](uint32_t remain_length, auto& it) {
+            return decoders::decode_puback(remain_length, it);
+        });
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, decode_pubrec) {
+    auto packet = encoders::encode_pubrec(1, 0x10, pubrec_props {});
+    state.run([&] {
+        decode_packet_with_id(packet, [](uint32_t remain_length, auto& it) {
+            return decoders::decode_pubrec(remain_length, it);
+        });
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, decode_pubrel) {
+    auto packet = encoders::encode_pubrel(1, 0x92, pubrel_props {});
+    state.run([&] {
+        decode_packet_with_id(packet, [](uint32_t remain_length, auto& it) {
+            return decoders::decode_pubrel(remain_length, it);
+        });
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, decode_pubcomp) {
+    auto packet = encoders::encode_pubcomp(1, 0x92, pubcomp_props {});
+    state.run([&] {
+        decode_packet_with_id(packet, [](uint32_t remain_length, auto& it) {
+            return decoders::decode_pubcomp(remain_length, it);
+        });
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, decode_subscribe) {
+    auto packet = encoders::encode_subscribe(1, subscribe_topics, subscribe_props {});
+    state.run([&] {
+        decode_packet_with_id(packet, [](uint32_t remain_length, auto& it) {
+            return decoders::decode_subscribe(remain_length, it);
+        });
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, decode_suback) {
+    auto packet = encoders::encode_suback(1, sub_reason_codes, suback_props {});
+    state.run([&] {
+        decode_packet_with_id(packet, [](uint32_t remain_length, auto& it) {
+            return decoders::decode_suback(remain_length, it);
+        });
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, decode_unsubscribe) {
+    auto packet = encoders::encode_unsubscribe(
+        1, unsubscribe_topics, unsubscribe_props {}
+    );
+    state.run([&] {
+        decode_packet_with_id(packet, [](uint32_t remain_length, auto& it) {
+            return decoders::decode_unsubscribe(remain_length, it);
+        });
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, decode_unsuback) {
+    auto packet = encoders::encode_unsuback(1, sub_reason_codes, unsuback_props {});
+    state.run([&] {
+        decode_packet_with_id(packet, [](uint32_t remain_length, auto& it) {
+            return decoders::decode_unsuback(remain_length, it);
+        });
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, decode_disconnect) {
+    disconnect_props props;
+    props[prop::reason_string] = "Keep Alive timeout";
+    auto packet = encoders::encode_disconnect(0x8D, props);
+    state.run([&] {
+        decode_packet(packet, [](uint8_t, uint32_t remain_length, auto& it) {
+            return decoders::decode_disconnect(remain_length, it);
+        });
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(codecs, decode_auth) {
+    auth_props props;
+    props[prop::authentication_method] = "SCRAM-SHA-256";
+    props[prop::authentication_data] = std::string(32, 'd');
+    auto packet = encoders::encode_auth(0x18, props);
+    state.run([&] {
+        decode_packet(packet, [](uint8_t, uint32_t remain_length, auto& it) {
+            return decoders::decode_auth(remain_length, it);
+        });
+    });
+}
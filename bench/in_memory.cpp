@@ -0,0 +1,168 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mqtt5/mqtt_client.hpp>
+#include <boost/mqtt5/types.hpp>
+
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include <cstddef>
+#include <string>
+
+#include "bench_common/bench.hpp"
+#include "bench_common/memory_broker.hpp"
+
+using namespace boost::mqtt5;
+namespace asio = boost::asio;
+
+/*
+    Publishing and receiving through a Broker in the memory of the process,
+    which measures the overhead of the library without the network stack.
+    Every operation publishes or receives a batch of messages.
+*/
+
+namespace {
+
+constexpr size_t batch_size = 1'000;
+
+const std::string topic = "site/57/device/33/temperature";
+const std::string payload(64, 'p');
+
+using client_type = mqtt_client<bench::memory_stream>;
+
+// A Client connected to the memory_broker of its io_context.
+struct in_memory {
+    asio::io_context ioc;
+    bench::memory_broker& broker = asio::use_service<bench::memory_broker>(ioc);
+    client_type client { ioc };
+
+    explicit in_memory(bool zero_copy_receive = false) {
+        client.brokers("127.0.0.1")
+            .zero_copy_receive(zero_copy_receive)
+            .async_run(asio::detached);
+        run_until([this] { return broker.connected(); });
+    }
+
+    ~in_memory() {
+        client.cancel();
+        ioc.run();
+    }
+
+    template <typename Cond>
+    void run_until(Cond&& cond) {
+        while (!cond())
+            ioc.run_one();
+    }
+
+    template <qos_e qos_type>
+    void publish_batch() {
+        size_t completed = 0;
+        size_t expected = broker.publishes_received() + batch_size;
+        for (size_t i = 0; i < batch_size; ++i)
+            client.async_publish<qos_type>(
+                topic, payload, retain_e::no, publish_props {},
+                [&completed](auto&&...) { ++completed; }
+            );
+        run_until([&] {
+            return completed == batch_size && broker.publishes_received() == expected;
+        });
+    }
+
+    // Receives a batch sent by the broker, prepared with prepare_batch.
+    void receive_batch(qos_e qos) {
+        size_t received = 0;
+        size_t acks_expected = broker.acks_received() +
+            (qos == qos_e::at_most_once ? 0 : batch_size);
+        broker.send_batch();
+        receive(received);
+        run_until([&] {
+            return received == batch_size && broker.acks_received() == acks_expected;
+        });
+    }
+
+    void receive_view_batch() {
+        size_t received = 0;
+        broker.send_batch();
+        receive_view(received);
+        run_until([&] { return received == batch_size; });
+    }
+
+private:
+    void receive(size_t& received) {
+        client.async_receive(
+            [this, &received](error_code ec, std::string, std::string, publish_props) {
+                if (ec || ++received == batch_size)
+                    return;
+                receive(received);
+            }
+        );
+    }
+
+    void receive_view(size_t& received) {
+        client.async_receive_view(
+            [this, &received](error_code ec, publish_view) {
+                if (ec || ++received == batch_size)
+                    return;
+                receive_view(received);
+            }
+        );
+    }
+};
+
+template <qos_e qos_type>
+void publish_benchmark(bench::state& state) {
+    in_memory im;
+    state.items_per_op(batch_size);
+    state.bytes_per_op(batch_size * payload.size());
+    state.report_cpu_time();
+    state.run([&] { im.publish_batch<qos_type>(); });
+}
+
+void receive_benchmark(bench::state& state, qos_e qos) {
+    in_memory im;
+    im.broker.prepare_batch(topic, payload, qos, batch_size);
+    state.items_per_op(batch_size);
+    state.bytes_per_op(batch_size * payload.size());
+    state.report_cpu_time();
+    state.run([&] { im.receive_batch(qos); });
+}
+
+} // end anonymous namespace
+
+BOOST_MQTT5_BENCHMARK(in_memory, publish_qos0) {
+    publish_benchmark<qos_e::at_most_once>(state);
+}
+
+BOOST_MQTT5_BENCHMARK(in_memory, publish_qos1) {
+    publish_benchmark<qos_e::at_least_once>(state);
+}
+
+BOOST_MQTT5_BENCHMARK(in_memory, publish_qos2) {
+    publish_benchmark<qos_e::exactly_once>(state);
+}
+
+BOOST_MQTT5_BENCHMARK(in_memory, receive_qos0) {
+    receive_benchmark(state, qos_e::at_most_once);
+}
+
+BOOST_MQTT5_BENCHMARK(in_memory, receive_qos1) {
+    receive_benchmark(state, qos_e::at_least_once);
+}
+
+BOOST_MQTT5_BENCHMARK(in_memory, receive_qos2) {
+    receive_benchmark(state, qos_e::exactly_once);
+}
+
+BOOST_MQTT5_BENCHMARK(in_memory, receive_view_qos0) {
+    in_memory im(true);
+    im.broker.prepare_batch(topic, payload, qos_e::at_most_once, batch_size);
+    state.items_per_op(batch_size);
+    state.bytes_per_op(batch_size * payload.size());
+    state.report_cpu_time();
+    state.run([&] { im.receive_view_batch(); });
+}
@@ -0,0 +1,206 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MQTT5_BENCH_COMMON_BENCH_HPP
+#define BOOST_MQTT5_BENCH_COMMON_BENCH_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+// Calls to the global operator new, counted by the replacement
+// in run_benchmarks.cpp.
+inline std::atomic<size_t> allocations { 0 };
+
+// Bytes currently allocated with the global operator new by the threads
+// that track them.
+inline std::atomic<size_t> allocated_bytes { 0 };
+
+// Whether the allocations of this thread are added to allocated_bytes.
+// Threads running a Broker turn it off, so that only the memory of
+// the Clients is reported.
+inline thread_local bool track_allocated_bytes = true;
+
+// Prevents the compiler from optimizing away the computation of value.
+template <typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+class state {
+    using clock = std::chrono::steady_clock;
+
+    static constexpr auto min_duration = std::chrono::milliseconds(200);
+
+    std::string _name;
+    size_t _bytes_per_op = 0;
+    size_t _items_per_op = 1;
+    bool _report_cpu_time = false;
+
+    size_t _iterations = 0;
+    double _ns_per_op = 0;
+    double _allocs_per_op = 0;
+    double _cpu_ns_per_op = 0;
+
+    std::vector<double> _latencies;
+    std::vector<std::pair<std::string, double>> _counters;
+
+public:
+    explicit state(std::string name) : _name(std::move(name)) {}
+
+    const std::string& name() const { return _name; }
+
+    // Bytes processed by a single invocation of the measured function.
+    void bytes_per_op(size_t bytes) { _bytes_per_op = bytes; }
+
+    // Items (messages, routes...) processed by a single invocation.
+    void items_per_op(size_t items) { _items_per_op = items; }
+
+    // Also reports the items per second and the CPU time
+    // of the whole process per item.
+    void report_cpu_time() { _report_cpu_time = true; }
+
+    // Reports a value measured by the benchmark itself,
+    // replacing the previous value of the counter with the same name.
+    void counter(std::string_view name, double value) {
+        for (auto& [n, v] : _counters)
+            if (n == name) {
+                v = value;
+                return;
+            }
+        _counters.emplace_back(std::string(name), value);
+    }
+
+    // Records the latency of a single message, reported as percentiles.
+    // Only the samples of the final measurement round are kept.
+    void add_latency(std::chrono::nanoseconds latency) {
+        _latencies.push_back(std::chrono::duration<double, std::micro>(latency).count());
+    }
+
+    // Calls op() until the measurement takes at least min_duration.
+    template <typename Op>
+    void run(Op&& op) {
+        size_t iterations = 1;
+        for (;;) {
+            _latencies.clear();
+            auto allocs = allocations.load(std::memory_order_relaxed);
+            auto cpu_start = std::clock();
+            auto start = clock::now();
+            for (size_t i = 0; i < iterations; ++i)
+                op();
+            auto elapsed = clock::now() - start;
+            auto cpu_elapsed = std::clock() - cpu_start;
+
+            if (elapsed >= min_duration) {
+                _iterations = iterations;
+                _ns_per_op = std::chrono::duration<double, std::nano>(elapsed).count() /
+                    static_cast<double>(iterations);
+                _allocs_per_op = static_cast<double>(
+                    allocations.load(std::memory_order_relaxed) - allocs
+                ) / static_cast<double>(iterations);
+                _cpu_ns_per_op = static_cast<double>(cpu_elapsed) * 1e9 /
+                    CLOCKS_PER_SEC / static_cast<double>(iterations);
+                return;
+            }
+            iterations *= elapsed < min_duration / 10 ? 10 : 2;
+        }
+    }
+
+    void report() {
+        double ns_per_item = _ns_per_op / static_cast<double>(_items_per_op);
+        std::printf(
+            "%-48s %12zu iters %12.1f ns/op %12.1f ns/item %10.2f allocs/op",
+            _name.c_str(), _iterations, _ns_per_op, ns_per_item, _allocs_per_op
+        );
+        if (_bytes_per_op) {
+            double mb_per_s = static_cast<double>(_bytes_per_op) / _ns_per_op * 1e3;
+            std::printf(" %10.1f MB/s", mb_per_s);
+        }
+        if (_report_cpu_time) {
+            double cpu_ns_per_item = _cpu_ns_per_op / static_cast<double>(_items_per_op);
+            std::printf(
+                " %12.0f items/s %10.1f cpu ns/item",
+                1e9 / ns_per_item, cpu_ns_per_item
+            );
+        }
+        for (const auto& [n, v] : _counters)
+            std::printf(" %12.1f %s", v, n.c_str());
+        if (!_latencies.empty()) {
+            std::sort(_latencies.begin(), _latencies.end());
+            std::printf(
+                " %10.1f us p50 %10.1f us p99 %10.1f us p99.9",
+                percentile(0.5), percentile(0.99), percentile(0.999)
+            );
+        }
+        std::printf("\n");
+    }
+
+private:
+    // Nearest-rank percentile of the sorted latencies.
+    double percentile(double p) const {
+        auto rank = static_cast<size_t>(p * static_cast<double>(_latencies.size()));
+        return _latencies[(std::min)(rank, _latencies.size() - 1)];
+    }
+};
+
+struct benchmark {
+    std::string name;
+    std::function<void (state&)> func;
+};
+
+inline std::vector<benchmark>& registry() {
+    static std::vector<benchmark> benchmarks;
+    return benchmarks;
+}
+
+struct registrar {
+    registrar(std::string name, std::function<void (state&)> func) {
+        registry().push_back({ std::move(name), std::move(func) });
+    }
+};
+
+// Runs all benchmarks whose name contains the filter.
+inline int run_all(std::string_view filter) {
+    for (const auto& b : registry()) {
+        if (b.name.find(filter) == std::string::npos)
+            continue;
+        state st(b.name);
+        b.func(st);
+        st.report();
+    }
+    return 0;
+}
+
+} // end namespace bench
+
+#define BOOST_MQTT5_BENCH_CONCAT_(a, b) a##b
+#define BOOST_MQTT5_BENCH_CONCAT(a, b) BOOST_MQTT5_BENCH_CONCAT_(a, b)
+
+#define BOOST_MQTT5_BENCHMARK(suite, name) \
+    static void suite##_##name(bench::state&); \
+    static bench::registrar BOOST_MQTT5_BENCH_CONCAT(suite##_##name##_registrar_, __LINE__) { \
+        #suite "/" #name, &suite##_##name \
+    }; \
+    static void suite##_##name(bench::state& state)
+
+#endif // !BOOST_MQTT5_BENCH_COMMON_BENCH_HPP
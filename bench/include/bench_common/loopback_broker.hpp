@@ -0,0 +1,357 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MQTT5_BENCH_COMMON_LOOPBACK_BROKER_HPP
+#define BOOST_MQTT5_BENCH_COMMON_LOOPBACK_BROKER_HPP
+
+#include <boost/mqtt5/types.hpp>
+
+#include <boost/mqtt5/impl/codecs/message_decoders.hpp>
+#include <boost/mqtt5/impl/codecs/message_encoders.hpp>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+namespace asio = boost::asio;
+using error_code = boost::system::error_code;
+
+/*
+    A minimal single-threaded MQTT 5 Broker on the loopback interface,
+    for measuring the Client over real sockets without an external Broker.
+
+    It accepts any number of Clients and routes PUBLISH packets between
+    them by their Subscriptions, with the QoS flows on both sides.
+    It has no sessions, retained messages, Will messages, Topic Aliases
+    or flow control and ignores the properties of the packets it receives.
+*/
+class loopback_broker {
+    class session : public std::enable_shared_from_this<session> {
+        struct subscription {
+            std::string filter;
+            boost::mqtt5::qos_e max_qos;
+            bool no_local;
+        };
+
+        static constexpr size_t read_size = 64 * 1024;
+
+        loopback_broker& _broker;
+        asio::ip::tcp::socket _socket;
+
+        std::string _read_buff;
+        size_t _read_end = 0;
+
+        std::string _outbound;
+        std::string _writing;
+        bool _write_in_progress = false;
+
+        std::vector<subscription> _subscriptions;
+        uint16_t _last_packet_id = 0;
+
+    public:
+        session(loopback_broker& broker, asio::ip::tcp::socket socket) :
+            _broker(broker), _socket(std::move(socket))
+        {}
+
+        void start() {
+            do_read();
+        }
+
+        void close() {
+            error_code ec;
+            _socket.close(ec);
+        }
+
+        // Sends the PUBLISH packet if one of the Subscriptions matches
+        // the Topic.
+        void deliver(
+            const session* publisher, std::string_view topic,
+            std::string_view payload, boost::mqtt5::qos_e qos
+        ) {
+            using namespace boost::mqtt5;
+
+            auto sub = std::find_if(
+                _subscriptions.begin(), _subscriptions.end(),
+                [this, publisher, topic](const subscription& s) {
+                    return !(s.no_local && publisher == this) &&
+                        matches(s.filter, topic);
+                }
+            );
+            if (sub == _subscriptions.end())
+                return;
+
+            auto sub_qos = (std::min)(qos, sub->max_qos);
+            uint16_t packet_id = sub_qos == qos_e::at_most_once ?
+                0 : next_packet_id();
+            encoders::encode_publish_to(
+                _outbound, packet_id, topic, payload,
+                sub_qos, retain_e::no, dup_e::no, {}
+            );
+            do_write();
+        }
+
+    private:
+        uint16_t next_packet_id() {
+            if (++_last_packet_id == 0)
+                _last_packet_id = 1;
+            return _last_packet_id;
+        }
+
+        void do_read() {
+            if (_read_buff.size() < _read_end + read_size)
+                _read_buff.resize(_read_end + read_size);
+
+            _socket.async_read_some(
+                asio::buffer(&_read_buff[_read_end], read_size),
+                [self = shared_from_this()](error_code ec, size_t bytes) {
+                    if (ec)
+                        return self->_broker.remove(self.get());
+                    self->_read_end += bytes;
+                    if (!self->handle_packets())
+                        return self->_broker.remove(self.get());
+                    self->do_write();
+                    self->do_read();
+                }
+            );
+        }
+
+        // Returns false if the connection is to be closed.
+        bool handle_packets() {
+            using namespace boost::mqtt5;
+
+            auto first = _read_buff.cbegin();
+            auto last = first + static_cast<std::ptrdiff_t>(_read_end);
+            auto it = first;
+            for (;;) {
+                auto packet_begin = it;
+                auto header = decoders::decode_fixed_header(it, last);
+                if (!header) {
+                    it = packet_begin;
+                    break;
+                }
+                auto [control_byte, remain_length] = *header;
+                if (static_cast<size_t>(std::distance(it, last)) < remain_length) {
+                    it = packet_begin;
+                    break;
+                }
+                auto packet_end = it + static_cast<std::ptrdiff_t>(remain_length);
+                if (!handle_packet(control_byte, remain_length, it))
+                    return false;
+                it = packet_end;
+            }
+
+            auto consumed = static_cast<size_t>(std::distance(first, it));
+            _read_buff.erase(0, consumed);
+            _read_end -= consumed;
+            return true;
+        }
+
+        bool handle_packet(
+            uint8_t control_byte, uint32_t remain_length,
+            std::string::const_iterator it
+        ) {
+            using namespace boost::mqtt5;
+
+            switch (control_byte >> 4) {
+                case 0b0001: // CONNECT
+                    _outbound += encoders::encode_connack(false, uint8_t(0x00), {});
+                    return true;
+                case 0b0011: { // PUBLISH
+                    auto msg = decoders::decode_publish(control_byte, remain_length, it);
+                    if (!msg)
+                        return false;
+                    auto& [topic, packet_id, flags, props, payload] = *msg;
+                    auto qos = qos_e((flags >> 1) & 0b11);
+                    if (qos == qos_e::at_least_once)
+                        _outbound += encoders::encode_puback(*packet_id, uint8_t(0x00), {});
+                    else if (qos == qos_e::exactly_once)
+                        _outbound += encoders::encode_pubrec(*packet_id, uint8_t(0x00), {});
+                    _broker.route(this, topic, payload, qos);
+                    return true;
+                }
+                case 0b0101: // PUBREC
+                    _outbound += encoders::encode_pubrel(
+                        *decoders::decode_packet_id(it), uint8_t(0x00), {}
+                    );
+                    return true;
+                case 0b0110: // PUBREL
+                    _outbound += encoders::encode_pubcomp(
+                        *decoders::decode_packet_id(it), uint8_t(0x00), {}
+                    );
+                    return true;
+                case 0b0100: // PUBACK
+                case 0b0111: // PUBCOMP
+                    return true;
+                case 0b1000: { // SUBSCRIBE
+                    auto packet_id = *decoders::decode_packet_id(it);
+                    auto msg = decoders::decode_subscribe(
+                        remain_length - sizeof(uint16_t), it
+                    );
+                    if (!msg)
+                        return false;
+                    std::vector<uint8_t> reason_codes;
+                    for (auto& [filter, options] : std::get<1>(*msg)) {
+                        auto max_qos = qos_e(options & 0b11);
+                        bool no_local = options & 0b0100;
+                        _subscriptions.push_back({ std::move(filter), max_qos, no_local });
+                        reason_codes.push_back(uint8_t(max_qos));
+                    }
+                    _outbound += encoders::encode_suback(packet_id, reason_codes, {});
+                    return true;
+                }
+                case 0b1010: { // UNSUBSCRIBE
+                    auto packet_id = *decoders::decode_packet_id(it);
+                    auto msg = decoders::decode_unsubscribe(
+                        remain_length - sizeof(uint16_t), it
+                    );
+                    if (!msg)
+                        return false;
+                    std::vector<uint8_t> reason_codes;
+                    for (const auto& filter : std::get<1>(*msg)) {
+                        auto sub = std::remove_if(
+                            _subscriptions.begin(), _subscriptions.end(),
+                            [&filter](const subscription& s) { return s.filter == filter; }
+                        );
+                        // Success or No subscription existed
+                        reason_codes.push_back(sub == _subscriptions.end() ? 0x11 : 0x00);
+                        _subscriptions.erase(sub, _subscriptions.end());
+                    }
+                    _outbound += encoders::encode_unsuback(packet_id, reason_codes, {});
+                    return true;
+                }
+                case 0b1100: // PINGREQ
+                    _outbound += encoders::encode_pingresp();
+                    return true;
+                default: // DISCONNECT, AUTH
+                    return false;
+            }
+        }
+
+        void do_write() {
+            if (_write_in_progress || _outbound.empty())
+                return;
+
+            _write_in_progress = true;
+            _writing.clear();
+            _writing.swap(_outbound);
+            asio::async_write(
+                _socket, asio::buffer(_writing),
+                [self = shared_from_this()](error_code ec, size_t) {
+                    self->_write_in_progress = false;
+                    if (!ec)
+                        self->do_write();
+                }
+            );
+        }
+    };
+
+    asio::ip::tcp::acceptor _acceptor;
+    std::vector<std::shared_ptr<session>> _sessions;
+
+public:
+    explicit loopback_broker(asio::io_context& ioc) :
+        _acceptor(ioc, { asio::ip::address_v4::loopback(), 0 })
+    {
+        do_accept();
+    }
+
+    loopback_broker(const loopback_broker&) = delete;
+    loopback_broker& operator=(const loopback_broker&) = delete;
+
+    ~loopback_broker() {
+        for (auto& s : _sessions)
+            s->close();
+    }
+
+    uint16_t port() const {
+        return _acceptor.local_endpoint().port();
+    }
+
+    size_t num_sessions() const noexcept {
+        return _sessions.size();
+    }
+
+    // Matches the Topic against the Topic Filter with the wildcards
+    // '+' (single level) and '#' (multi-level).
+    static bool matches(std::string_view filter, std::string_view topic) {
+        // Topics starting with '$' do not match filters starting with a wildcard
+        if (!topic.empty() && topic[0] == '$' &&
+            !filter.empty() && (filter[0] == '+' || filter[0] == '#'))
+            return false;
+
+        for (;;) {
+            auto f_end = filter.find('/');
+            auto f_level = filter.substr(0, f_end);
+            if (f_level == "#")
+                return true;
+
+            auto t_end = topic.find('/');
+            auto t_level = topic.substr(0, t_end);
+            if (f_level != "+" && f_level != t_level)
+                return false;
+
+            if (f_end == std::string_view::npos || t_end == std::string_view::npos)
+                // "a/#" also matches "a"
+                return f_end == t_end || filter.substr(f_end + 1) == "#";
+
+            filter.remove_prefix(f_end + 1);
+            topic.remove_prefix(t_end + 1);
+        }
+    }
+
+private:
+    void do_accept() {
+        _acceptor.async_accept(
+            [this](error_code ec, asio::ip::tcp::socket socket) {
+                if (ec)
+                    return;
+                socket.set_option(asio::ip::tcp::no_delay(true), ec);
+                auto s = std::make_shared<session>(*this, std::move(socket));
+                _sessions.push_back(s);
+                s->start();
+                do_accept();
+            }
+        );
+    }
+
+    void route(
+        const session* publisher, std::string_view topic,
+        std::string_view payload, boost::mqtt5::qos_e qos
+    ) {
+        for (auto& s : _sessions)
+            s->deliver(publisher, topic, payload, qos);
+    }
+
+    void remove(const session* s) {
+        auto it = std::find_if(
+            _sessions.begin(), _sessions.end(),
+            [s](const auto& p) { return p.get() == s; }
+        );
+        if (it == _sessions.end())
+            return;
+        (*it)->close();
+        _sessions.erase(it);
+    }
+};
+
+} // end namespace bench
+
+#endif // !BOOST_MQTT5_BENCH_COMMON_LOOPBACK_BROKER_HPP
@@ -0,0 +1,392 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MQTT5_BENCH_COMMON_MEMORY_BROKER_HPP
+#define BOOST_MQTT5_BENCH_COMMON_MEMORY_BROKER_HPP
+
+#include <boost/mqtt5/types.hpp>
+
+#include <boost/mqtt5/impl/codecs/message_encoders.hpp>
+
+#include <boost/asio/any_completion_handler.hpp>
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/associated_cancellation_slot.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/execution_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/prepend.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace bench {
+
+namespace asio = boost::asio;
+using error_code = boost::system::error_code;
+
+/*
+    A Broker living in the memory of the process, for measuring the Client
+    without the cost of the network stack. The Client connects to it
+    through a memory_stream created on the same execution context.
+
+    The broker answers CONNECT, PINGREQ and the acknowledgements of
+    the QoS flows, counts the PUBLISH packets it receives and sends
+    batches of PUBLISH packets to the Client on request.
+    Only a single Client per execution context is supported.
+*/
+class memory_broker : public asio::execution_context::service {
+    using base = asio::execution_context::service;
+    using read_handler = asio::any_completion_handler<void (error_code, size_t)>;
+
+    std::string _inbound;
+    std::string _outbound;
+    size_t _outbound_pos = 0;
+
+    asio::any_io_executor _read_ex;
+    void* _read_data = nullptr;
+    size_t _read_size = 0;
+    read_handler _read_handler;
+
+    std::string _batch;
+    size_t _batch_size = 0;
+
+    bool _connected = false;
+    size_t _publishes_received = 0;
+    size_t _bytes_received = 0;
+    size_t _acks_received = 0;
+
+public:
+    static inline asio::execution_context::id id {};
+
+    explicit memory_broker(asio::execution_context& context) : base(context) {}
+
+    bool connected() const noexcept {
+        return _connected;
+    }
+
+    // PUBLISH packets received after the CONNECT packet.
+    size_t publishes_received() const noexcept {
+        return _publishes_received;
+    }
+
+    // Bytes of the PUBLISH packets received after the CONNECT packet.
+    size_t bytes_received() const noexcept {
+        return _bytes_received;
+    }
+
+    // PUBACK and PUBCOMP packets received for the PUBLISH packets
+    // sent with send_batch.
+    size_t acks_received() const noexcept {
+        return _acks_received;
+    }
+
+    // Encodes the batch of PUBLISH packets sent by send_batch, with
+    // Packet Identifiers from 1 to num_packets.
+    void prepare_batch(
+        std::string_view topic, std::string_view payload,
+        boost::mqtt5::qos_e qos, size_t num_packets
+    ) {
+        _batch.clear();
+        _batch_size = num_packets;
+        for (size_t i = 0; i < num_packets; ++i)
+            boost::mqtt5::encoders::encode_publish_to(
+                _batch, qos == boost::mqtt5::qos_e::at_most_once ? 0 : uint16_t(i + 1),
+                topic, payload, qos, boost::mqtt5::retain_e::no,
+                boost::mqtt5::dup_e::no, {}
+            );
+    }
+
+    // Sends the batch to the Client. With QoS 1 and 2, a batch must not
+    // be sent again before all its packets are acknowledged.
+    size_t send_batch() {
+        send(_batch);
+        return _batch_size;
+    }
+
+    // Handlers are invoked as if by post, on their associated executor
+    // or on ex if they have none.
+    template <typename MutableBuffer, typename Handler>
+    void async_read(
+        const asio::any_io_executor& ex, const MutableBuffer& buffer,
+        Handler&& handler
+    ) {
+        cancel_read();
+
+        auto slot = asio::get_associated_cancellation_slot(handler);
+        if (slot.is_connected())
+            slot.assign([this](asio::cancellation_type_t) { cancel_read(); });
+
+        _read_ex = ex;
+        _read_data = buffer.data();
+        _read_size = buffer.size();
+        _read_handler = std::move(handler);
+        complete_read();
+    }
+
+    template <typename ConstBufferSequence, typename Handler>
+    void async_write(
+        const asio::any_io_executor& ex, const ConstBufferSequence& buffers,
+        Handler&& handler
+    ) {
+        size_t bytes_written = 0;
+        for (
+            auto it = asio::buffer_sequence_begin(buffers);
+            it != asio::buffer_sequence_end(buffers); ++it
+        ) {
+            _inbound.append(static_cast<const char*>(it->data()), it->size());
+            bytes_written += it->size();
+        }
+        handle_inbound();
+
+        asio::post(ex, asio::prepend(std::move(handler), error_code {}, bytes_written));
+    }
+
+    void cancel_read() {
+        complete_read_with(asio::error::operation_aborted, 0);
+    }
+
+    void close_connection() {
+        cancel_read();
+        _inbound.clear();
+        _outbound.clear();
+        _outbound_pos = 0;
+        _connected = false;
+    }
+
+private:
+    void shutdown() override {
+        _read_handler = {};
+    }
+
+    void send(std::string_view packets) {
+        _outbound.append(packets.data(), packets.size());
+        complete_read();
+    }
+
+    void handle_inbound() {
+        size_t pos = 0;
+        for (;;) {
+            // fixed header: control byte and Remaining Length
+            uint32_t remain_length = 0;
+            size_t header_size = 1;
+            bool complete = false;
+            for (unsigned shift = 0; shift < 4 * 7; shift += 7) {
+                if (pos + header_size >= _inbound.size())
+                    break;
+                auto byte = uint8_t(_inbound[pos + header_size++]);
+                remain_length |= uint32_t(byte & 0b0111'1111) << shift;
+                if (!(byte & 0b1000'0000)) {
+                    complete = true;
+                    break;
+                }
+            }
+            if (!complete || _inbound.size() - pos - header_size < remain_length)
+                break;
+
+            handle_packet(
+                uint8_t(_inbound[pos]),
+                std::string_view(_inbound).substr(pos + header_size, remain_length)
+            );
+            pos += header_size + remain_length;
+        }
+        _inbound.erase(0, pos);
+    }
+
+    void handle_packet(uint8_t control_byte, std::string_view body) {
+        using namespace boost::mqtt5;
+
+        switch (control_byte >> 4) {
+            case 0b0001: // CONNECT
+                _connected = true;
+                return send(encoders::encode_connack(false, uint8_t(0x00), {}));
+            case 0b0011: { // PUBLISH
+                ++_publishes_received;
+                _bytes_received += body.size();
+                auto qos = qos_e((control_byte >> 1) & 0b11);
+                if (qos == qos_e::at_most_once)
+                    return;
+                size_t topic_size = (uint8_t(body[0]) << 8) | uint8_t(body[1]);
+                auto packet_id = packet_id_at(body, 2 + topic_size);
+                if (qos == qos_e::at_least_once)
+                    return send(encoders::encode_puback(packet_id, 0, {}));
+                return send(encoders::encode_pubrec(packet_id, 0, {}));
+            }
+            case 0b0101: // PUBREC
+                return send(encoders::encode_pubrel(packet_id_at(body, 0), 0, {}));
+            case 0b0110: // PUBREL
+                return send(encoders::encode_pubcomp(packet_id_at(body, 0), 0, {}));
+            case 0b0100: // PUBACK
+            case 0b0111: // PUBCOMP
+                ++_acks_received;
+                return;
+            case 0b1100: // PINGREQ
+                return send(encoders::encode_pingresp());
+            default:
+                return;
+        }
+    }
+
+    static uint16_t packet_id_at(std::string_view body, size_t pos) {
+        return uint16_t((uint8_t(body[pos]) << 8) | uint8_t(body[pos + 1]));
+    }
+
+    void complete_read() {
+        if (!_read_handler || _outbound_pos == _outbound.size())
+            return;
+
+        size_t bytes = (std::min)(_read_size, _outbound.size() - _outbound_pos);
+        std::memcpy(_read_data, _outbound.data() + _outbound_pos, bytes);
+        _outbound_pos += bytes;
+        if (_outbound_pos == _outbound.size()) {
+            _outbound.clear();
+            _outbound_pos = 0;
+        }
+        complete_read_with(error_code {}, bytes);
+    }
+
+    void complete_read_with(error_code ec, size_t bytes) {
+        if (!_read_handler)
+            return;
+        auto slot = asio::get_associated_cancellation_slot(_read_handler);
+        if (slot.is_connected())
+            slot.clear();
+        asio::post(_read_ex, asio::prepend(std::move(_read_handler), ec, bytes));
+        _read_handler = {};
+    }
+};
+
+// A stream connected to the memory_broker of its execution context.
+class memory_stream {
+public:
+    using executor_type = asio::any_io_executor;
+    using protocol_type = asio::ip::tcp;
+    using endpoint_type = asio::ip::tcp::endpoint;
+
+private:
+    executor_type _ex;
+    memory_broker* _broker = nullptr;
+    endpoint_type _remote_ep;
+
+public:
+    explicit memory_stream(executor_type ex) : _ex(std::move(ex)) {}
+
+    memory_stream(const memory_stream&) = delete;
+    memory_stream& operator=(const memory_stream&) = delete;
+
+    ~memory_stream() {
+        error_code ec;
+        close(ec);
+    }
+
+    executor_type get_executor() const noexcept {
+        return _ex;
+    }
+
+    void open(const protocol_type&, error_code& ec) {
+        ec = {};
+        _broker = &asio::use_service<memory_broker>(_ex.context());
+    }
+
+    void cancel(error_code& ec) {
+        ec = {};
+    }
+
+    void close(error_code& ec) {
+        ec = {};
+        if (_broker && is_connected())
+            _broker->close_connection();
+        _broker = nullptr;
+        _remote_ep = {};
+    }
+
+    bool is_open() const {
+        return _broker != nullptr;
+    }
+
+    bool is_connected() const {
+        return _remote_ep != endpoint_type {};
+    }
+
+    endpoint_type remote_endpoint(error_code& ec) {
+        ec = is_connected() ? error_code {} : asio::error::not_connected;
+        return _remote_ep;
+    }
+
+    template <typename SettableSocketOption>
+    void set_option(const SettableSocketOption&, error_code&) {}
+
+    template <typename ConnectToken>
+    decltype(auto) async_connect(const endpoint_type& ep, ConnectToken&& token) {
+        auto initiation = [this](auto handler, const endpoint_type& ep) {
+            error_code ec;
+            if (!is_open())
+                open(ep.protocol(), ec);
+            _remote_ep = ep;
+            asio::post(get_executor(), asio::prepend(std::move(handler), ec));
+        };
+
+        return asio::async_initiate<ConnectToken, void (error_code)>(
+            std::move(initiation), token, ep
+        );
+    }
+
+    template <typename ConstBufferSequence, typename WriteToken>
+    decltype(auto) async_write_some(
+        const ConstBufferSequence& buffers, WriteToken&& token
+    ) {
+        auto initiation = [this](auto handler, const ConstBufferSequence& buffers) {
+            if (!is_connected())
+                return asio::post(
+                    get_executor(),
+                    asio::prepend(std::move(handler), asio::error::not_connected, size_t(0))
+                );
+            _broker->async_write(get_executor(), buffers, std::move(handler));
+        };
+
+        return asio::async_initiate<WriteToken, void (error_code, size_t)>(
+            std::move(initiation), token, buffers
+        );
+    }
+
+    template <typename MutableBufferSequence, typename ReadToken>
+    decltype(auto) async_read_some(
+        const MutableBufferSequence& buffers, ReadToken&& token
+    ) {
+        auto initiation = [this](auto handler, const MutableBufferSequence& buffers) {
+            if (!is_connected())
+                return asio::post(
+                    get_executor(),
+                    asio::prepend(std::move(handler), asio::error::not_connected, size_t(0))
+                );
+            _broker->async_read(
+                get_executor(), *asio::buffer_sequence_begin(buffers),
+                std::move(handler)
+            );
+        };
+
+        return asio::async_initiate<ReadToken, void (error_code, size_t)>(
+            std::move(initiation), token, buffers
+        );
+    }
+};
+
+template <typename ShutdownHandler>
+void async_shutdown(memory_stream&, ShutdownHandler&& handler) {
+    return std::move(handler)(error_code {});
+}
+
+} // end namespace bench
+
+#endif // !BOOST_MQTT5_BENCH_COMMON_MEMORY_BROKER_HPP
@@ -0,0 +1,88 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MQTT5_BENCH_COMMON_SINK_BROKER_HPP
+#define BOOST_MQTT5_BENCH_COMMON_SINK_BROKER_HPP
+
+#include <boost/mqtt5/impl/codecs/message_encoders.hpp>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace bench {
+
+namespace asio = boost::asio;
+using error_code = boost::system::error_code;
+
+// Accepts a single Client on the loopback interface, answers its
+// CONNECT packet with a CONNACK packet and discards everything else.
+class sink_broker {
+    asio::ip::tcp::acceptor _acceptor;
+    asio::ip::tcp::socket _socket;
+    std::array<char, 64 * 1024> _buff {};
+
+    bool _connected = false;
+    size_t _bytes_received = 0;
+
+public:
+    explicit sink_broker(asio::io_context& ioc) :
+        _acceptor(ioc, { asio::ip::address_v4::loopback(), 0 }),
+        _socket(ioc)
+    {
+        _acceptor.async_accept(_socket, [this](error_code ec) {
+            if (!ec)
+                do_read();
+        });
+    }
+
+    uint16_t port() const {
+        return _acceptor.local_endpoint().port();
+    }
+
+    bool connected() const noexcept {
+        return _connected;
+    }
+
+    // Bytes received after the CONNECT packet.
+    size_t bytes_received() const noexcept {
+        return _bytes_received;
+    }
+
+private:
+    void do_read() {
+        _socket.async_read_some(
+            asio::buffer(_buff),
+            [this](error_code ec, size_t bytes) {
+                if (ec)
+                    return;
+                if (!_connected) {
+                    // the Client writes nothing else before the CONNACK
+                    auto connack = boost::mqtt5::encoders::encode_connack(
+                        false, uint8_t(0x00), {}
+                    );
+                    asio::write(_socket, asio::buffer(connack), ec);
+                    _connected = true;
+                }
+                else
+                    _bytes_received += bytes;
+                do_read();
+            }
+        );
+    }
+};
+
+} // end namespace bench
+
+#endif // !BOOST_MQTT5_BENCH_COMMON_SINK_BROKER_HPP
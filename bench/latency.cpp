@@ -0,0 +1,128 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mqtt5/mqtt_client.hpp>
+#include <boost/mqtt5/types.hpp>
+
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "bench_common/bench.hpp"
+#include "bench_common/loopback_broker.hpp"
+
+using namespace boost::mqtt5;
+namespace asio = boost::asio;
+
+/*
+    Latency of a message from async_publish on one Client to the completion
+    of async_receive on another, through a loopback_broker running on its
+    own thread. Every operation is a single round, so that messages
+    never queue behind each other.
+*/
+
+namespace {
+
+const std::string topic = "site/57/device/33/temperature";
+const std::string payload(64, 'p');
+
+using client_type = mqtt_client<asio::ip::tcp::socket>;
+using clock = std::chrono::steady_clock;
+
+// A publishing and a subscribed Client, connected to a loopback_broker.
+struct ping_pong {
+    asio::io_context broker_ioc;
+    bench::loopback_broker broker { broker_ioc };
+    std::thread broker_thread;
+
+    asio::io_context ioc;
+    client_type publisher { ioc };
+    client_type subscriber { ioc };
+
+    ping_pong() {
+        broker_thread = std::thread([this] { broker_ioc.run(); });
+
+        subscriber.brokers("127.0.0.1", broker.port())
+            .async_run(asio::detached);
+        publisher.brokers("127.0.0.1", broker.port())
+            .async_run(asio::detached);
+
+        bool subscribed = false;
+        subscriber.async_subscribe(
+            subscribe_topic { topic, subscribe_options { qos_e::exactly_once } },
+            subscribe_props {},
+            [&subscribed](auto&&...) { subscribed = true; }
+        );
+        run_until([&] { return subscribed; });
+
+        // also waits for the publisher to connect
+        round_trip<qos_e::exactly_once>();
+    }
+
+    ~ping_pong() {
+        publisher.cancel();
+        subscriber.cancel();
+        ioc.run();
+        broker_ioc.stop();
+        broker_thread.join();
+    }
+
+    template <typename Cond>
+    void run_until(Cond&& cond) {
+        while (!cond())
+            ioc.run_one();
+    }
+
+    // Returns the time from the start of async_publish to the completion
+    // of async_receive, and waits for the QoS flow of the publisher.
+    template <qos_e qos_type>
+    std::chrono::nanoseconds round_trip() {
+        bool published = false, received = false;
+        clock::time_point received_at;
+
+        subscriber.async_receive(
+            [&received, &received_at](error_code, std::string, std::string, publish_props) {
+                received_at = clock::now();
+                received = true;
+            }
+        );
+
+        auto start = clock::now();
+        publisher.async_publish<qos_type>(
+            topic, payload, retain_e::no, publish_props {},
+            [&published](auto&&...) { published = true; }
+        );
+        run_until([&] { return published && received; });
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(received_at - start);
+    }
+};
+
+template <qos_e qos_type>
+void latency_benchmark(bench::state& state) {
+    ping_pong pp;
+    state.bytes_per_op(payload.size());
+    state.report_cpu_time();
+    state.run([&] { state.add_latency(pp.round_trip<qos_type>()); });
+}
+
+} // end anonymous namespace
+
+BOOST_MQTT5_BENCHMARK(latency, publish_receive_qos0) {
+    latency_benchmark<qos_e::at_most_once>(state);
+}
+
+BOOST_MQTT5_BENCHMARK(latency, publish_receive_qos1) {
+    latency_benchmark<qos_e::at_least_once>(state);
+}
+
+BOOST_MQTT5_BENCHMARK(latency, publish_receive_qos2) {
+    latency_benchmark<qos_e::exactly_once>(state);
+}
@@ -0,0 +1,77 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mqtt5/types.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <utility>
+
+#include "bench_common/bench.hpp"
+
+using namespace boost::mqtt5;
+
+namespace {
+
+constexpr size_t batch_size = 1'000;
+
+const publish_props some_props = [] {
+    publish_props props;
+    props[prop::message_expiry_interval] = 60;
+    props[prop::content_type] = "text/plain";
+    return props;
+}();
+
+// Moves the properties through a queue, as received messages are
+// moved through the Client's receive channel.
+void move_through_queue(const publish_props& props, bench::state& state) {
+    std::deque<publish_props> queue;
+    state.items_per_op(batch_size);
+    state.run([&] {
+        for (size_t i = 0; i < batch_size; ++i)
+            queue.push_back(props);
+        for (size_t i = 0; i < batch_size; ++i) {
+            auto p = std::move(queue.front());
+            queue.pop_front();
+            bench::do_not_optimize(p);
+        }
+    });
+}
+
+} // end anonymous namespace
+
+BOOST_MQTT5_BENCHMARK(properties, construct_empty) {
+    state.run([&] {
+        publish_props props;
+        bench::do_not_optimize(props);
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(properties, move_empty) {
+    publish_props props;
+    state.run([&] {
+        publish_props moved = std::move(props);
+        bench::do_not_optimize(moved);
+        props = std::move(moved);
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(properties, queue_empty) {
+    move_through_queue(publish_props {}, state);
+}
+
+BOOST_MQTT5_BENCHMARK(properties, queue_two_props) {
+    move_through_queue(some_props, state);
+}
+
+BOOST_MQTT5_BENCHMARK(properties, read_absent) {
+    const publish_props props;
+    state.run([&] {
+        bench::do_not_optimize(props[prop::content_type].has_value());
+    });
+}
@@ -0,0 +1,171 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mqtt5/mqtt_client.hpp>
+#include <boost/mqtt5/types.hpp>
+
+#include <boost/mqtt5/impl/codecs/message_encoders.hpp>
+
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+
+#include <cstddef>
+#include <string>
+
+#include "bench_common/bench.hpp"
+#include "bench_common/sink_broker.hpp"
+
+using namespace boost::mqtt5;
+namespace asio = boost::asio;
+
+namespace {
+
+constexpr size_t batch_size = 1'000;
+
+const std::string topic = "site/57/device/33/temperature";
+const std::string payload = "21.5";
+const publish_props no_props {};
+
+// Small Payloads, where encoding the Topic and the properties dominates.
+const std::string payload_100b(100, 'p');
+const publish_props some_props = [] {
+    publish_props props;
+    props[prop::message_expiry_interval] = 60;
+    props[prop::content_type] = "application/json";
+    props[prop::user_property].emplace_back("source", "gateway-7");
+    return props;
+}();
+
+const size_t publish_size = encoders::encode_publish(
+    0, topic, payload, qos_e::at_most_once, retain_e::no, dup_e::no, no_props
+).size();
+
+// A Client connected to a sink_broker over the loopback interface.
+struct loopback {
+    asio::io_context ioc;
+    bench::sink_broker broker { ioc };
+    mqtt_client<asio::ip::tcp::socket> client { ioc };
+    size_t expected_bytes = publish_size;
+
+    loopback() {
+        client.brokers("127.0.0.1", broker.port())
+            .async_run(asio::detached);
+
+        // the first PUBLISH is written once the CONNACK is received
+        bool written = false;
+        client.async_publish<qos_e::at_most_once>(
+            topic, payload, retain_e::no, no_props,
+            [&written](error_code) { written = true; }
+        );
+        run_until([&] { return written; });
+    }
+
+    ~loopback() {
+        client.cancel();
+        ioc.run();
+    }
+
+    template <typename Cond>
+    void run_until(Cond&& cond) {
+        while (!cond())
+            ioc.run_one();
+    }
+
+    // Runs until the broker has received num_packets more PUBLISH packets.
+    void drain(size_t num_packets) {
+        expected_bytes += num_packets * publish_size;
+        run_until([&] { return broker.bytes_received() >= expected_bytes; });
+    }
+};
+
+} // end anonymous namespace
+
+BOOST_MQTT5_BENCHMARK(publish, encode_qos0) {
+    state.bytes_per_op(publish_size);
+    state.run([&] {
+        bench::do_not_optimize(encoders::encode_publish(
+            0, topic, payload, qos_e::at_most_once, retain_e::no, dup_e::no, no_props
+        ));
+    });
+}
+
+// Encoding into a buffer that is reused, as done by try_publish.
+BOOST_MQTT5_BENCHMARK(publish, encode_to_qos0) {
+    std::string out;
+    state.bytes_per_op(publish_size);
+    state.run([&] {
+        out.clear();
+        encoders::encode_publish_to(
+            out, 0, topic, payload, qos_e::at_most_once, retain_e::no, dup_e::no, no_props
+        );
+        bench::do_not_optimize(out);
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(publish, encode_qos1_100b) {
+    state.run([&] {
+        bench::do_not_optimize(encoders::encode_publish(
+            1, topic, payload_100b, qos_e::at_least_once, retain_e::no, dup_e::no,
+            some_props
+        ));
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(publish, encode_templated_qos1_100b) {
+    auto tmpl = mqtt_client<asio::ip::tcp::socket>::make_publish_template(
+        topic, some_props
+    );
+    state.run([&] {
+        bench::do_not_optimize(encoders::encode_templated_publish(
+            1, tmpl, payload_100b, qos_e::at_least_once, retain_e::no, dup_e::no
+        ));
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(publish, async_publish_qos0_loopback) {
+    loopback lb;
+    state.items_per_op(batch_size);
+    state.bytes_per_op(batch_size * publish_size);
+    state.run([&] {
+        size_t completed = 0;
+        for (size_t i = 0; i < batch_size; ++i)
+            lb.client.async_publish<qos_e::at_most_once>(
+                topic, payload, retain_e::no, no_props,
+                [&completed](error_code) { ++completed; }
+            );
+        lb.run_until([&] { return completed == batch_size; });
+        lb.drain(batch_size);
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(publish, try_publish_loopback) {
+    loopback lb;
+    state.items_per_op(batch_size);
+    state.bytes_per_op(batch_size * publish_size);
+    state.run([&] {
+        for (size_t i = 0; i < batch_size; ++i)
+            bench::do_not_optimize(
+                lb.client.try_publish(topic, payload, retain_e::no, no_props)
+            );
+        lb.drain(batch_size);
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(publish, try_publish_validated_topic_loopback) {
+    loopback lb;
+    auto validated_topic = mqtt_client<asio::ip::tcp::socket>::make_topic(topic);
+    state.items_per_op(batch_size);
+    state.bytes_per_op(batch_size * publish_size);
+    state.run([&] {
+        for (size_t i = 0; i < batch_size; ++i)
+            bench::do_not_optimize(
+                lb.client.try_publish(validated_topic, payload, retain_e::no, no_props)
+            );
+        lb.drain(batch_size);
+    });
+}
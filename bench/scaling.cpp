@@ -0,0 +1,176 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mqtt5/mqtt_client.hpp>
+#include <boost/mqtt5/types.hpp>
+
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/post.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_common/bench.hpp"
+#include "bench_common/loopback_broker.hpp"
+
+using namespace boost::mqtt5;
+namespace asio = boost::asio;
+
+/*
+    The fixed costs of a Client in a process running a large fleet of them,
+    against a loopback_broker on its own thread. The Clients are spread
+    over one or several io_contexts, each run by its own thread.
+
+    The connect benchmarks report the time to connect the whole fleet and
+    the heap memory of a connected, idle Client, which does not include
+    the memory of the sockets in the kernel. The keep-alive benchmarks
+    report the CPU time of the whole process, including the Broker,
+    where one item is one second of one idle Client sending PINGREQs
+    every second.
+
+    Every Client uses two file descriptors in the process, so larger
+    fleets need a higher limit of open files (ulimit -n).
+*/
+
+namespace {
+
+constexpr size_t num_clients = 400;
+
+using client_type = mqtt_client<asio::ip::tcp::socket>;
+using clock = std::chrono::steady_clock;
+
+// The Broker and its thread, shared by the fleets of a benchmark.
+struct broker_thread {
+    asio::io_context ioc;
+    bench::loopback_broker broker { ioc };
+    uint16_t port = broker.port();
+    std::thread thread;
+
+    broker_thread() {
+        thread = std::thread([this] {
+            bench::track_allocated_bytes = false;
+            ioc.run();
+        });
+    }
+
+    ~broker_thread() {
+        ioc.stop();
+        thread.join();
+    }
+};
+
+// num_clients Clients spread evenly over num_contexts io_contexts.
+class fleet {
+    struct context {
+        asio::io_context ioc;
+        std::vector<std::unique_ptr<client_type>> clients;
+        std::thread thread;
+    };
+
+    std::list<context> _contexts;
+    std::atomic<size_t> _connected { 0 };
+
+public:
+    // Starts the Clients and waits until all of them are connected.
+    fleet(uint16_t port, size_t num_contexts, uint16_t keep_alive = 60) {
+        for (size_t i = 0; i < num_contexts; ++i) {
+            auto& ctx = _contexts.emplace_back();
+            size_t clients_in_ctx = num_clients / num_contexts +
+                (i < num_clients % num_contexts ? 1 : 0);
+
+            // the Clients are created and used only on the thread of their io_context
+            asio::post(ctx.ioc, [this, &ctx, port, keep_alive, clients_in_ctx] {
+                for (size_t j = 0; j < clients_in_ctx; ++j) {
+                    auto& c = ctx.clients.emplace_back(
+                        std::make_unique<client_type>(ctx.ioc)
+                    );
+                    c->brokers("127.0.0.1", port)
+                        .keep_alive(keep_alive)
+                        .async_run(asio::detached);
+
+                    // the PUBLISH is written once the CONNACK is received
+                    c->async_publish<qos_e::at_most_once>(
+                        "fleet/connected", "", retain_e::no, publish_props {},
+                        [this](error_code) { ++_connected; }
+                    );
+                }
+            });
+            ctx.thread = std::thread([&ctx] { ctx.ioc.run(); });
+        }
+
+        while (_connected.load() < num_clients)
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+
+    fleet(const fleet&) = delete;
+    fleet& operator=(const fleet&) = delete;
+
+    ~fleet() {
+        for (auto& ctx : _contexts)
+            asio::post(ctx.ioc, [&ctx] {
+                for (auto& c : ctx.clients)
+                    c->cancel();
+            });
+        for (auto& ctx : _contexts)
+            ctx.thread.join();
+    }
+};
+
+void connect_benchmark(bench::state& state, size_t num_contexts) {
+    broker_thread bt;
+    state.items_per_op(num_clients);
+    state.run([&] {
+        auto bytes_before = bench::allocated_bytes.load();
+        auto start = clock::now();
+
+        fleet f(bt.port, num_contexts);
+
+        auto connect_time = clock::now() - start;
+        auto bytes = static_cast<double>(bench::allocated_bytes.load()) -
+            static_cast<double>(bytes_before);
+        state.counter(
+            "ms connect",
+            std::chrono::duration<double, std::milli>(connect_time).count()
+        );
+        state.counter("bytes/client", bytes / num_clients);
+    });
+}
+
+void keep_alive_benchmark(bench::state& state, size_t num_contexts) {
+    broker_thread bt;
+    fleet f(bt.port, num_contexts, 1);
+    state.items_per_op(num_clients);
+    state.report_cpu_time();
+    state.run([] { std::this_thread::sleep_for(std::chrono::seconds(1)); });
+}
+
+} // end anonymous namespace
+
+BOOST_MQTT5_BENCHMARK(scaling, connect_1_context) {
+    connect_benchmark(state, 1);
+}
+
+BOOST_MQTT5_BENCHMARK(scaling, connect_4_contexts) {
+    connect_benchmark(state, 4);
+}
+
+BOOST_MQTT5_BENCHMARK(scaling, keep_alive_1_context) {
+    keep_alive_benchmark(state, 1);
+}
+
+BOOST_MQTT5_BENCHMARK(scaling, keep_alive_4_contexts) {
+    keep_alive_benchmark(state, 4);
+}
@@ -0,0 +1,62 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "bench_common/bench.hpp"
+
+namespace {
+
+// Precedes every allocation, keeping the returned memory aligned.
+struct alignas(std::max_align_t) block_header {
+    std::size_t size;
+    bool tracked;
+};
+
+} // end anonymous namespace
+
+// Counts the allocations reported as allocs/op and the allocated bytes.
+// The array and nothrow forms of operator new and delete call these.
+void* operator new(std::size_t size) {
+    bench::allocations.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(sizeof(block_header) + size);
+    if (!p)
+        throw std::bad_alloc();
+
+    auto header = static_cast<block_header*>(p);
+    header->size = size;
+    header->tracked = bench::track_allocated_bytes;
+    if (header->tracked)
+        bench::allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    return header + 1;
+}
+
+void operator delete(void* p) noexcept {
+    if (!p)
+        return;
+    auto header = static_cast<block_header*>(p) - 1;
+    if (header->tracked)
+        bench::allocated_bytes.fetch_sub(header->size, std::memory_order_relaxed);
+    std::free(header);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    operator delete(p);
+}
+
+int main(int argc, char* argv[]) {
+    return bench::run_all(argc > 1 ? argv[1] : "");
+}
+
+/*
+* usage: ./boost_mqtt5-benchmarks [filter]
+* example: ./boost_mqtt5-benchmarks topic_router/
+*
+* runs every benchmark whose name ("suite/name") contains the filter
+*/
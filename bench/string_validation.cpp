@@ -0,0 +1,59 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mqtt5/detail/topic_validation.hpp>
+#include <boost/mqtt5/detail/utf8_mqtt.hpp>
+
+#include <string>
+
+#include "bench_common/bench.hpp"
+
+using namespace boost::mqtt5;
+
+namespace {
+
+const std::string topic = "site/57/device/33/temperature";
+const std::string topic_filter = "site/57/device/+/temperature";
+
+// A 1 KiB user property value, half of it in Cyrillic.
+const std::string ascii_value(1024, 'v');
+const std::string mixed_value = [] {
+    std::string s(512, 'v');
+    while (s.size() < 1024)
+        s += "\xD0\xB6"; // U+0436
+    return s;
+}();
+
+} // end anonymous namespace
+
+BOOST_MQTT5_BENCHMARK(string_validation, topic_name) {
+    state.bytes_per_op(topic.size());
+    state.run([&] {
+        bench::do_not_optimize(detail::validate_topic_name(topic));
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(string_validation, topic_filter) {
+    state.bytes_per_op(topic_filter.size());
+    state.run([&] {
+        bench::do_not_optimize(detail::validate_topic_filter(topic_filter));
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(string_validation, utf8_ascii_1k) {
+    state.bytes_per_op(ascii_value.size());
+    state.run([&] {
+        bench::do_not_optimize(detail::validate_mqtt_utf8(ascii_value));
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(string_validation, utf8_mixed_1k) {
+    state.bytes_per_op(mixed_value.size());
+    state.run([&] {
+        bench::do_not_optimize(detail::validate_mqtt_utf8(mixed_value));
+    });
+}
@@ -0,0 +1,143 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mqtt5/topic_router.hpp>
+#include <boost/mqtt5/types.hpp>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bench_common/bench.hpp"
+
+using namespace boost::mqtt5;
+
+namespace {
+
+constexpr size_t num_filters = 10'000;
+
+// Filters of the form "site/{s}/device/{d}/{metric}", with every tenth
+// filter replaced by a single-level wildcard one and every hundredth
+// by a multi-level wildcard one.
+std::vector<std::string> make_filters() {
+    std::vector<std::string> filters;
+    filters.reserve(num_filters);
+    for (size_t i = 0; i < num_filters; ++i) {
+        auto site = std::to_string(i / 100);
+        auto device = std::to_string(i % 100);
+        if (i % 100 == 0)
+            filters.push_back("site/" + site + "/#");
+        else if (i % 10 == 0)
+            filters.push_back("site/" + site + "/device/+/status");
+        else
+            filters.push_back("site/" + site + "/device/" + device + "/temperature");
+    }
+    return filters;
+}
+
+topic_router& router_10k(size_t& hits) {
+    static size_t* hits_ptr = nullptr;
+    static topic_router router = [] {
+        topic_router r;
+        for (const auto& filter : make_filters())
+            r.add(filter, [](auto, auto, const auto&) { ++*hits_ptr; });
+        return r;
+    }();
+    hits_ptr = &hits;
+    return router;
+}
+
+const publish_props no_props {};
+
+} // end anonymous namespace
+
+BOOST_MQTT5_BENCHMARK(topic_router, add_10k) {
+    auto filters = make_filters();
+    state.items_per_op(filters.size());
+    state.run([&] {
+        topic_router router;
+        for (const auto& filter : filters)
+            router.add(filter, [](auto, auto, const auto&) {});
+        bench::do_not_optimize(router);
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(topic_router, route_exact_10k) {
+    size_t hits = 0;
+    auto& router = router_10k(hits);
+    std::string_view topic = "site/57/device/33/temperature";
+    state.run([&] {
+        bench::do_not_optimize(router.route(topic, "21.5", no_props));
+    });
+    bench::do_not_optimize(hits);
+}
+
+BOOST_MQTT5_BENCHMARK(topic_router, route_wildcard_10k) {
+    size_t hits = 0;
+    auto& router = router_10k(hits);
+    std::string_view topic = "site/57/device/33/status";
+    state.run([&] {
+        bench::do_not_optimize(router.route(topic, "online", no_props));
+    });
+    bench::do_not_optimize(hits);
+}
+
+BOOST_MQTT5_BENCHMARK(topic_router, route_miss_10k) {
+    size_t hits = 0;
+    auto& router = router_10k(hits);
+    std::string_view topic = "building/57/device/33/temperature";
+    state.run([&] {
+        bench::do_not_optimize(router.route(topic, "21.5", no_props));
+    });
+    bench::do_not_optimize(hits);
+}
+
+// Baseline: matching every received Topic against every filter in user code.
+BOOST_MQTT5_BENCHMARK(topic_router, linear_scan_10k) {
+    auto filters = make_filters();
+    std::string_view topic = "site/57/device/33/temperature";
+
+    auto matches = [](std::string_view filter, std::string_view topic) {
+        while (true) {
+            auto fpos = filter.find('/');
+            auto tpos = topic.find('/');
+            auto flvl = filter.substr(0, fpos);
+            auto tlvl = topic.substr(0, tpos);
+            if (flvl == "#")
+                return true;
+            if (flvl != "+" && flvl != tlvl)
+                return false;
+            if (fpos == std::string_view::npos || tpos == std::string_view::npos)
+                return fpos == tpos || filter.substr(fpos + 1) == "#";
+            filter.remove_prefix(fpos + 1);
+            topic.remove_prefix(tpos + 1);
+        }
+    };
+
+    state.run([&] {
+        size_t n = 0;
+        for (const auto& filter : filters)
+            n += matches(filter, topic);
+        bench::do_not_optimize(n);
+    });
+}
+
+BOOST_MQTT5_BENCHMARK(topic_router, route_subscription_id_10k) {
+    size_t hits = 0;
+    topic_router router;
+    for (size_t i = 0; i < num_filters; ++i)
+        router.add_subscription([&hits](auto, auto, const auto&) { ++hits; });
+
+    publish_props props;
+    props[prop::subscription_identifier] = 5733;
+    std::string_view topic = "site/57/device/33/temperature";
+    state.run([&] {
+        bench::do_not_optimize(router.route(topic, "21.5", props));
+    });
+    bench::do_not_optimize(hits);
+}
@@ -14,6 +14,7 @@
 #include <boost/mqtt5/mqtt_client.hpp>
 #include <boost/mqtt5/property_types.hpp>
 #include <boost/mqtt5/reason_codes.hpp>
+#include <boost/mqtt5/topic_router.hpp>
 #include <boost/mqtt5/types.hpp>
 
 #endif // !BOOST_MQTT5_HPP
@@ -18,23 +18,30 @@
 #include <boost/asio/bind_cancellation_slot.hpp>
 #include <boost/asio/execution.hpp>
 #include <boost/asio/require.hpp>
+#include <boost/container/deque.hpp>
 #include <boost/system/error_code.hpp>
 
-#include <deque>
+#include <memory>
 
 namespace boost::mqtt5::detail {
 
 namespace asio = boost::asio;
 using error_code = boost::system::error_code;
 
-class async_mutex {
+template <typename Allocator = std::allocator<void>>
+class basic_async_mutex {
 public:
     using executor_type = asio::any_io_executor;
+    using allocator_type = Allocator;
 private:
     using queued_op_t = asio::any_completion_handler<
         void (error_code)
     >;
-    using queue_t = std::deque<queued_op_t>;
+    // allocates nothing while the mutex is not contended
+    using queue_t = boost::container::deque<
+        queued_op_t,
+        typename std::allocator_traits<Allocator>::template rebind_alloc<queued_op_t>
+    >;
 
     // Handler with assigned tracking executor.
     // Objects of this type are type-erased by any_completion_handler
@@ -81,9 +88,11 @@ private:
     // The helper stores queue iterator to operation since the iterator
     // would not be invalidated by other queue operations.
     class cancel_waiting_op {
-        queue_t::iterator _ihandler;
+        typename queue_t::iterator _ihandler;
     public:
-        explicit cancel_waiting_op(queue_t::iterator ih) : _ihandler(ih) {}
+        explicit cancel_waiting_op(typename queue_t::iterator ih) :
+            _ihandler(ih)
+        {}
 
         void operator()(asio::cancellation_type_t type) {
             if (type == asio::cancellation_type_t::none)
@@ -105,12 +114,15 @@ private:
 
 public:
     template <typename Executor>
-    explicit async_mutex(Executor&& ex) : _ex(std::forward<Executor>(ex)) {}
+    explicit basic_async_mutex(Executor&& ex, const Allocator& alloc = {}) :
+        _waiting(typename queue_t::allocator_type(alloc)),
+        _ex(std::forward<Executor>(ex))
+    {}
 
-    async_mutex(const async_mutex&) = delete;
-    async_mutex& operator=(const async_mutex&) = delete;
+    basic_async_mutex(const basic_async_mutex&) = delete;
+    basic_async_mutex& operator=(const basic_async_mutex&) = delete;
 
-    ~async_mutex() {
+    ~basic_async_mutex() {
         cancel();
     }
 
@@ -118,6 +130,10 @@ public:
         return _ex;
     }
 
+    allocator_type get_allocator() const noexcept {
+        return allocator_type(_waiting.get_allocator());
+    }
+
     bool is_locked() const noexcept {
         return _locked;
     }
@@ -129,7 +145,7 @@ public:
     decltype(auto) lock(CompletionToken&& token) noexcept {
         using Signature = void (error_code);
 
-        auto initiation = [] (auto handler, async_mutex& self) {
+        auto initiation = [] (auto handler, basic_async_mutex& self) {
             self.execute_or_queue(std::move(handler));
         };
 
@@ -211,6 +227,8 @@ private:
     }
 };
 
+using async_mutex = basic_async_mutex<>;
+
 } // end namespace boost::mqtt5::detail
 
 #endif // !BOOST_MQTT5_ASYNC_MUTEX_HPP
@@ -10,14 +10,18 @@
 
 #include <boost/mqtt5/types.hpp>
 
+#include <boost/asio/associated_allocator.hpp>
 #include <boost/asio/associated_executor.hpp>
+#include <boost/asio/bind_allocator.hpp>
 #include <boost/asio/execution.hpp>
 #include <boost/asio/prefer.hpp>
+#include <boost/asio/recycling_allocator.hpp>
 #include <boost/asio/write.hpp>
 #include <boost/type_traits/detected_or.hpp>
 #include <boost/type_traits/is_detected.hpp>
 #include <boost/type_traits/remove_cv_ref.hpp>
 
+#include <memory>
 #include <type_traits>
 
 namespace boost::mqtt5 {
@@ -58,6 +62,44 @@ tracking_executor(const Handler& handler, const DfltExecutor& ex) {
     );
 }
 
+// client allocator
+
+template <typename Allocator>
+constexpr bool is_default_allocator = std::is_same_v<
+    typename std::allocator_traits<Allocator>::template rebind_alloc<void>,
+    std::allocator<void>
+>;
+
+// Internal operations and queues recycle their memory
+// unless the Client is given an allocator.
+template <typename Allocator>
+using internal_allocator_t = std::conditional_t<
+    is_default_allocator<Allocator>,
+    asio::recycling_allocator<void>,
+    typename std::allocator_traits<Allocator>::template rebind_alloc<void>
+>;
+
+template <typename Allocator>
+internal_allocator_t<Allocator> internal_allocator(const Allocator& alloc) {
+    if constexpr (is_default_allocator<Allocator>)
+        return {};
+    else
+        return internal_allocator_t<Allocator>(alloc);
+}
+
+// Handlers without an associated allocator use the allocator of the Client.
+template <typename Handler, typename Allocator>
+auto with_default_allocator(Handler&& handler, const Allocator& alloc) {
+    if constexpr (is_default_allocator<Allocator>)
+        return std::decay_t<Handler>(std::forward<Handler>(handler));
+    else {
+        auto handler_alloc = asio::get_associated_allocator(handler, alloc);
+        return asio::bind_allocator(
+            std::move(handler_alloc), std::forward<Handler>(handler)
+        );
+    }
+}
+
 
 // tls handshake
 
@@ -9,8 +9,9 @@
 #define BOOST_MQTT5_CHANNEL_TRAITS_HPP
 
 #include <boost/asio/error.hpp>
+#include <boost/container/deque.hpp>
 
-#include <deque>
+#include <memory>
 #include <type_traits>
 
 namespace boost::mqtt5::detail {
@@ -18,9 +19,11 @@ namespace boost::mqtt5::detail {
 namespace asio = boost::asio;
 using error_code = boost::system::error_code;
 
-template <typename Element>
+// Unlike std::deque, boost::container::deque allocates nothing
+// until the first element is stored, so idle channels hold no memory.
+template <typename Element, typename Allocator = std::allocator<Element>>
 class bounded_deque {
-    std::deque<Element> _buffer;
+    boost::container::deque<Element, Allocator> _buffer;
     static constexpr size_t MAX_SIZE = 65535;
 
 public:
@@ -55,26 +58,49 @@ public:
     }
 };
 
-template <typename... Signatures>
+// The channel default-constructs its buffer and cannot pass it the
+// Client's allocator. A default-constructed Allocator is equivalent
+// to the Client's only if all its instances compare equal, so stateful
+// allocators fall back to std::allocator instead of silently allocating
+// from a default-constructed state.
+template <typename Allocator>
+constexpr bool is_channel_allocator_v =
+    std::is_default_constructible_v<Allocator> &&
+    std::allocator_traits<Allocator>::is_always_equal::value;
+
+template <typename Allocator, typename Element>
+using channel_allocator_t = typename std::allocator_traits<
+    std::conditional_t<
+        is_channel_allocator_v<Allocator>,
+        Allocator, std::allocator<void>
+    >
+>::template rebind_alloc<Element>;
+
+template <typename Allocator = std::allocator<void>, typename... Signatures>
 struct channel_traits {
     template <typename... NewSignatures>
     struct rebind {
-        using other = channel_traits<NewSignatures...>;
+        using other = channel_traits<Allocator, NewSignatures...>;
     };
 };
 
-template <typename R, typename... Args>
-struct channel_traits<R(error_code, Args...)> {
+template <typename Allocator, typename R, typename... Args>
+struct channel_traits<Allocator, R(error_code, Args...)> {
     static_assert(sizeof...(Args) > 0);
 
     template <typename... NewSignatures>
     struct rebind {
-        using other = channel_traits<NewSignatures...>;
+        using other = channel_traits<Allocator, NewSignatures...>;
     };
 
     template <typename Element>
     struct container {
-        using type = bounded_deque<Element>;
+        using allocator_type = channel_allocator_t<Allocator, Element>;
+        static_assert(
+            std::allocator_traits<allocator_type>::is_always_equal::value,
+            "The channel buffer must not depend on the state of its allocator"
+        );
+        using type = bounded_deque<Element, allocator_type>;
     };
 
     using receive_cancelled_signature = R(error_code, Args...);
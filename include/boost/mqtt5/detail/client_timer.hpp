@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MQTT5_CLIENT_TIMER_HPP
+#define BOOST_MQTT5_CLIENT_TIMER_HPP
+
+#include <boost/mqtt5/detail/timer_wheel.hpp>
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <variant>
+
+namespace boost::mqtt5::detail {
+
+namespace asio = boost::asio;
+using error_code = boost::system::error_code;
+
+// A timer used for the deadlines of the Client: an asio::steady_timer
+// by default, or a wheel_timer sharing the timer_wheel of the execution
+// context with the other Clients in the low-footprint mode.
+class client_timer {
+public:
+    using executor_type = asio::any_io_executor;
+
+private:
+    std::variant<asio::steady_timer, wheel_timer> _timer;
+
+public:
+    explicit client_timer(const executor_type& ex) :
+        _timer(std::in_place_type<asio::steady_timer>, ex)
+    {}
+
+    client_timer(const client_timer&) = delete;
+    client_timer& operator=(const client_timer&) = delete;
+
+    // Must not be called while a wait is pending.
+    void use_wheel(bool enable) {
+        if (enable == std::holds_alternative<wheel_timer>(_timer))
+            return;
+
+        auto ex = get_executor();
+        if (enable)
+            _timer.emplace<wheel_timer>(ex);
+        else
+            _timer.emplace<asio::steady_timer>(ex);
+    }
+
+    executor_type get_executor() const noexcept {
+        return std::visit(
+            [](const auto& timer) -> executor_type {
+                return timer.get_executor();
+            },
+            _timer
+        );
+    }
+
+    size_t expires_after(duration d) {
+        return std::visit(
+            [d](auto& timer) { return timer.expires_after(d); }, _timer
+        );
+    }
+
+    size_t cancel() {
+        return std::visit([](auto& timer) { return timer.cancel(); }, _timer);
+    }
+
+    template <typename CompletionToken>
+    decltype(auto) async_wait(CompletionToken&& token) {
+        using Signature = void (error_code);
+
+        auto initiation = [](auto handler, client_timer& self) {
+            std::visit(
+                [&handler](auto& timer) {
+                    timer.async_wait(std::move(handler));
+                },
+                self._timer
+            );
+        };
+
+        return asio::async_initiate<CompletionToken, Signature>(
+            initiation, token, std::ref(*this)
+        );
+    }
+};
+
+} // end namespace boost::mqtt5::detail
+
+#endif // !BOOST_MQTT5_CLIENT_TIMER_HPP
@@ -10,12 +10,14 @@
 
 #include <boost/mqtt5/types.hpp>
 
+#include <boost/mqtt5/detail/packet_buffers.hpp>
+
 #include <boost/assert.hpp>
-#include <boost/smart_ptr/allocate_unique.hpp>
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
-#include <memory>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -48,23 +50,29 @@ enum class control_code_e : std::uint8_t {
 constexpr struct with_pid_ {} with_pid {};
 constexpr struct no_pid_ {} no_pid {};
 
-template <typename Allocator>
+/*
+    The encoded packet is held by value. Its storage comes from, and is
+    returned to, packet_buffers rather than the Client's allocator, so that
+    sending packets in steady traffic does not allocate.
+*/
 class control_packet {
     uint16_t _packet_id;
-
-    using alloc_type = Allocator;
-    using deleter = boost::alloc_deleter<std::string, alloc_type>;
-    std::unique_ptr<std::string, deleter> _packet;
-
-    control_packet(
-        const Allocator& a,
-        uint16_t packet_id, std::string packet
-    ) :
-        _packet_id(packet_id),
-        _packet(boost::allocate_unique<std::string>(a, std::move(packet)))
-    {}
+    std::string _packet;
+
+    control_packet(uint16_t packet_id, std::string packet) :
+        _packet_id(packet_id), _packet(std::move(packet))
+    {
+        // The packet is moved between handlers while it is being written,
+        // so its bytes must not be stored inline in the string.
+        if (_packet.capacity() <= packet_buffers::small_capacity())
+            _packet.reserve(packet_buffers::small_capacity() + 1);
+    }
 
 public:
+    ~control_packet() {
+        packet_buffers::release(std::move(_packet));
+    }
+
     control_packet(control_packet&&) noexcept = default;
     control_packet(const control_packet&) = delete;
 
@@ -76,11 +84,10 @@ public:
         typename ...Args
     >
     static control_packet of(
-        with_pid_, const Allocator& alloc,
-        EncodeFun&& encode, uint16_t packet_id, Args&&... args
+        with_pid_, EncodeFun&& encode, uint16_t packet_id, Args&&... args
     ) {
         return control_packet {
-            alloc, packet_id, encode(packet_id, std::forward<Args>(args)...)
+            packet_id, encode(packet_id, std::forward<Args>(args)...)
         };
     }
 
@@ -89,20 +96,19 @@ public:
         typename ...Args
     >
     static control_packet of(
-        no_pid_, const Allocator& alloc,
-        EncodeFun&& encode, Args&&... args
+        no_pid_, EncodeFun&& encode, Args&&... args
     ) {
         return control_packet {
-            alloc, uint16_t(0), encode(std::forward<Args>(args)...)
+            uint16_t(0), encode(std::forward<Args>(args)...)
         };
     }
 
     size_t size() const {
-        return _packet->size();
+        return _packet.size();
     }
 
     control_code_e control_code() const {
-        return control_code_e(uint8_t(*(_packet->data())) & 0b11110000);
+        return control_code_e(uint8_t(_packet[0]) & 0b11110000);
     }
 
     uint16_t packet_id() const {
@@ -111,19 +117,74 @@ public:
 
     qos_e qos() const {
         BOOST_ASSERT(control_code() == control_code_e::publish);
-        auto byte = (uint8_t(*(_packet->data())) & 0b00000110) >> 1;
+        auto byte = (uint8_t(_packet[0]) & 0b00000110) >> 1;
         return qos_e(byte);
     }
 
     control_packet& set_dup() {
         BOOST_ASSERT(control_code() == control_code_e::publish);
-        auto& byte = *(_packet->data());
+        auto& byte = _packet[0];
         byte |= 0b00001000;
         return *this;
     }
 
     std::string_view wire_data() const {
-        return *_packet;
+        return _packet;
+    }
+};
+
+/*
+    A packet short enough to be copied into the write request when sent,
+    so that it needs neither heap storage nor to be kept alive until written:
+    PINGREQ, and PUBACK, PUBREC, PUBREL and PUBCOMP packets with
+    Reason Code Success and no properties.
+*/
+class short_packet {
+public:
+    static constexpr size_t max_size = 5;
+
+private:
+    std::array<char, max_size> _data {};
+    uint8_t _size = 0;
+
+    short_packet() = default;
+
+public:
+    static short_packet pingreq() {
+        short_packet p;
+        p._data[0] = char(control_code_e::pingreq);
+        p._data[1] = 0;
+        p._size = 2;
+        return p;
+    }
+
+    // The Reason Code is written out even though it may be omitted,
+    // so that the packet is equal to the one the encoders produce.
+    static short_packet ack(control_code_e code, uint16_t packet_id) {
+        BOOST_ASSERT(
+            code == control_code_e::puback || code == control_code_e::pubrec ||
+            code == control_code_e::pubrel || code == control_code_e::pubcomp
+        );
+        // PUBREL has reserved fixed header flags 0b0010
+        uint8_t flags = code == control_code_e::pubrel ? 0b0010 : 0;
+
+        short_packet p;
+        p._data[0] = char(uint8_t(code) | flags);
+        p._data[1] = 3;
+        p._data[2] = char(packet_id >> 8);
+        p._data[3] = char(packet_id & 0xff);
+        p._data[4] = 0; // Reason Code Success
+        p._size = 5;
+        return p;
+    }
+
+    uint16_t packet_id() const {
+        BOOST_ASSERT(_size == 5);
+        return uint16_t((uint8_t(_data[2]) << 8) | uint8_t(_data[3]));
+    }
+
+    std::string_view wire_data() const {
+        return { _data.data(), _size };
     }
 };
 
@@ -150,6 +211,10 @@ public:
     packet_id_allocator& operator=(packet_id_allocator&&) noexcept = default;
     packet_id_allocator& operator=(const packet_id_allocator&) = delete;
 
+    bool exhausted() const noexcept {
+        return _free_ids.empty();
+    }
+
     uint16_t allocate() {
         if (_free_ids.empty()) return 0;
         auto& last = _free_ids.back();
@@ -12,16 +12,33 @@
 #include <boost/mqtt5/types.hpp>
 
 #include <boost/mqtt5/detail/any_authenticator.hpp>
+#include <boost/mqtt5/detail/subscription_registry.hpp>
+#include <boost/mqtt5/detail/topic_aliases.hpp>
 
 #include <chrono>
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <tuple>
 
 namespace boost::mqtt5::detail {
 
 using byte_citer = std::string::const_iterator;
 
+// PUBLISH decoded in place (zero-copy receive), followed by
+// the receive buffer its topic and payload refer to
+using shared_publish_message = std::tuple<
+    std::string_view, // topic
+    std::optional<uint16_t>, // packet_id
+    uint8_t, // dup_e, qos_e, retain_e
+    std::string_view, // encoded publish props
+    std::string_view, // payload
+    std::shared_ptr<const std::string>, // receive buffer
+    std::shared_ptr<const std::string> // topic resolved from a Topic Alias
+>;
+
 using time_stamp = std::chrono::time_point<std::chrono::steady_clock>;
 using duration = time_stamp::duration;
 
@@ -83,6 +100,9 @@ struct mqtt_ctx {
     connack_props ca_props;
     session_state state;
     any_authenticator authenticator;
+    inbound_topic_aliases inbound_aliases;
+    outbound_topic_aliases outbound_aliases;
+    subscription_registry subscriptions;
 
     mqtt_ctx() = default;
 
@@ -90,7 +110,10 @@ struct mqtt_ctx {
         creds(other.creds), will_msg(other.will_msg),
         keep_alive(other.keep_alive), co_props(other.co_props),
         ca_props {}, state {},
-        authenticator(other.authenticator)
+        authenticator(other.authenticator),
+        inbound_aliases {},
+        outbound_aliases(other.outbound_aliases.enabled()),
+        subscriptions(other.subscriptions.enabled())
     {}
 };
 
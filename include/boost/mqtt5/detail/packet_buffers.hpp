@@ -0,0 +1,78 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MQTT5_PACKET_BUFFERS_HPP
+#define BOOST_MQTT5_PACKET_BUFFERS_HPP
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace boost::mqtt5::detail {
+
+/*
+    Recycles the storage of encoded control packets, so that encoding
+    packets in steady traffic does not allocate.
+
+    Buffers are kept per thread, as packets are encoded and released
+    within the Client's executor. A buffer released on another thread
+    than the one that acquired it moves to that thread's pool.
+    Buffers of large packets are not kept.
+*/
+class packet_buffers {
+    static constexpr size_t max_buffers = 32;
+    static constexpr size_t max_capacity = 64 * 1024;
+
+    static std::vector<std::string>& pool() {
+        static thread_local std::vector<std::string> buffers = [] {
+            std::vector<std::string> v;
+            v.reserve(max_buffers);
+            return v;
+        }();
+        return buffers;
+    }
+
+public:
+    // Returns an empty buffer with a capacity of at least size bytes.
+    static std::string acquire(size_t size) {
+        auto& buffers = pool();
+        std::string s;
+        if (!buffers.empty()) {
+            s = std::move(buffers.back());
+            buffers.pop_back();
+        }
+        s.reserve(size);
+        return s;
+    }
+
+    static void release(std::string&& s) noexcept {
+        // small strings are stored inline, there is nothing to recycle
+        if (s.capacity() <= small_capacity() || s.capacity() > max_capacity)
+            return;
+
+        auto& buffers = pool();
+        if (buffers.size() == buffers.capacity())
+            return;
+
+        s.clear();
+        buffers.push_back(std::move(s));
+    }
+
+    static size_t size() noexcept {
+        return pool().size();
+    }
+
+    // The capacity up to which a string stores its characters inline.
+    static size_t small_capacity() noexcept {
+        return std::string().capacity();
+    }
+};
+
+} // end namespace boost::mqtt5::detail
+
+#endif // !BOOST_MQTT5_PACKET_BUFFERS_HPP
@@ -0,0 +1,147 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MQTT5_RAW_PROPS_HPP
+#define BOOST_MQTT5_RAW_PROPS_HPP
+
+#include <boost/mqtt5/property_types.hpp>
+
+#include <boost/mqtt5/impl/codecs/byte_reader.hpp>
+
+#include <cstdint>
+#include <string_view>
+
+namespace boost::mqtt5::detail {
+
+// A property of a PUBLISH packet as it is encoded. Integer values are
+// stored in number, strings and binary data in first, and the value
+// of a User Property in second.
+struct raw_property {
+    uint8_t id = 0;
+    uint32_t number = 0;
+    std::string_view first;
+    std::string_view second;
+};
+
+/*
+    Reads of the properties of a PUBLISH packet in their encoded form
+    (without the Property Length), used to deliver received messages
+    without decoding the properties up front.
+*/
+class raw_publish_props {
+    using reader_type = decoders::basic_byte_reader<const char*>;
+
+    reader_type _reader;
+
+public:
+    raw_publish_props() = default;
+
+    explicit raw_publish_props(std::string_view raw) :
+        _reader(raw.data(), raw.data() + raw.size())
+    {}
+
+    bool at_end() const noexcept {
+        return _reader.at_end();
+    }
+
+    // The position after the last property read.
+    const char* position() const noexcept {
+        return _reader.position();
+    }
+
+    // Reads the next property. Returns false and stops at the end
+    // if the property is malformed or not a PUBLISH property.
+    bool next(raw_property& p) {
+        auto reader = _reader;
+        bool rv = reader.read(p.id);
+        if (rv) {
+            p.number = 0;
+            p.first = p.second = {};
+            rv = read_value(reader, p);
+        }
+        if (rv)
+            _reader = reader;
+        else
+            _reader.read_rest();
+        return rv;
+    }
+
+private:
+    static bool read_value(reader_type& reader, raw_property& p) {
+        switch (p.id) {
+            case prop::payload_format_indicator_t:
+                return read_number<uint8_t>(reader, p.number);
+            case prop::message_expiry_interval_t:
+                return read_number<uint32_t>(reader, p.number);
+            case prop::topic_alias_t:
+                return read_number<uint16_t>(reader, p.number);
+            case prop::subscription_identifier_t:
+                // Variable Byte Integer
+                return read_number<int32_t>(reader, p.number);
+            case prop::content_type_t:
+            case prop::response_topic_t:
+            case prop::correlation_data_t:
+                return reader.read(p.first);
+            case prop::user_property_t:
+                return reader.read(p.first) && reader.read(p.second);
+            default:
+                return false;
+        }
+    }
+
+    template <typename T>
+    static bool read_number(reader_type& reader, uint32_t& number) {
+        T val;
+        if (!reader.read(val))
+            return false;
+        number = uint32_t(val);
+        return true;
+    }
+};
+
+// Decodes the encoded properties of a PUBLISH packet into props.
+template <typename Props>
+bool decode_raw_publish_props(std::string_view raw, Props& props) {
+    raw_publish_props reader(raw);
+    raw_property p;
+    while (!reader.at_end()) {
+        if (!reader.next(p))
+            return false;
+
+        switch (p.id) {
+            case prop::payload_format_indicator_t:
+                props[prop::payload_format_indicator] = uint8_t(p.number);
+                break;
+            case prop::message_expiry_interval_t:
+                props[prop::message_expiry_interval] = p.number;
+                break;
+            case prop::topic_alias_t:
+                props[prop::topic_alias] = uint16_t(p.number);
+                break;
+            case prop::subscription_identifier_t:
+                props[prop::subscription_identifier].push_back(int32_t(p.number));
+                break;
+            case prop::content_type_t:
+                props[prop::content_type] = std::string(p.first);
+                break;
+            case prop::response_topic_t:
+                props[prop::response_topic] = std::string(p.first);
+                break;
+            case prop::correlation_data_t:
+                props[prop::correlation_data] = std::string(p.first);
+                break;
+            case prop::user_property_t:
+                props[prop::user_property].emplace_back(p.first, p.second);
+                break;
+        }
+    }
+    return true;
+}
+
+} // end namespace boost::mqtt5::detail
+
+#endif // !BOOST_MQTT5_RAW_PROPS_HPP
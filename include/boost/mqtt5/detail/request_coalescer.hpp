@@ -0,0 +1,208 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MQTT5_REQUEST_COALESCER_HPP
+#define BOOST_MQTT5_REQUEST_COALESCER_HPP
+
+#include <boost/mqtt5/error.hpp>
+#include <boost/mqtt5/reason_codes.hpp>
+#include <boost/mqtt5/types.hpp>
+
+#include <boost/mqtt5/detail/control_packet.hpp>
+#include <boost/mqtt5/detail/internal_types.hpp>
+#include <boost/mqtt5/detail/subscription_registry.hpp>
+
+#include <boost/mqtt5/impl/codecs/message_decoders.hpp>
+#include <boost/mqtt5/impl/codecs/message_encoders.hpp>
+
+#include <boost/asio/any_completion_handler.hpp>
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/prepend.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace boost::mqtt5::detail {
+
+namespace asio = boost::asio;
+
+inline bool equal_props(const unsubscribe_props& a, const unsubscribe_props& b) {
+    return a[prop::user_property] == b[prop::user_property];
+}
+
+struct subscribe_traits {
+    using topic_type = subscribe_topic;
+    using props_type = subscribe_props;
+    using ack_props_type = suback_props;
+
+    static constexpr auto ack_code = control_code_e::suback;
+    static constexpr auto ack_category = reason_codes::category::suback;
+    static constexpr const char* ack_name = "SUBACK";
+
+    static size_t topic_size(const topic_type& topic) {
+        // Topic Filter (UTF-8 Encoded String) and Subscription Options
+        return 2 + topic.topic_filter.size() + 1;
+    }
+
+    static std::string encode(
+        uint16_t packet_id,
+        const std::vector<topic_type>& topics, const props_type& props
+    ) {
+        return encoders::encode_subscribe(packet_id, topics, props);
+    }
+
+    static auto decode_ack(uint32_t remain_length, byte_citer& it) {
+        return decoders::decode_suback(remain_length, it);
+    }
+};
+
+struct unsubscribe_traits {
+    using topic_type = std::string;
+    using props_type = unsubscribe_props;
+    using ack_props_type = unsuback_props;
+
+    static constexpr auto ack_code = control_code_e::unsuback;
+    static constexpr auto ack_category = reason_codes::category::unsuback;
+    static constexpr const char* ack_name = "UNSUBACK";
+
+    static size_t topic_size(const topic_type& topic) {
+        // Topic Filter (UTF-8 Encoded String)
+        return 2 + topic.size();
+    }
+
+    static std::string encode(
+        uint16_t packet_id,
+        const std::vector<topic_type>& topics, const props_type& props
+    ) {
+        return encoders::encode_unsubscribe(packet_id, topics, props);
+    }
+
+    static auto decode_ack(uint32_t remain_length, byte_citer& it) {
+        return decoders::decode_unsuback(remain_length, it);
+    }
+};
+
+/*
+    SUBSCRIBE (or UNSUBSCRIBE) requests collected during a single executor
+    turn, to be sent in as few packets as possible.
+
+    Requests are merged only if their properties are equal, as properties
+    apply to all Topic Filters in a packet, and a request is never split
+    across packets. The Reason Codes in the reply are handed back
+    to each request in the order its Topic Filters were sent.
+
+    The requests are queued with std::allocator, as documented
+    in the allocators section.
+*/
+template <typename Traits>
+class request_coalescer {
+public:
+    using topic_type = typename Traits::topic_type;
+    using props_type = typename Traits::props_type;
+    using ack_props_type = typename Traits::ack_props_type;
+
+    using handler_type = asio::any_completion_handler<
+        void (error_code, std::vector<uint8_t>, ack_props_type)
+    >;
+
+    struct request {
+        std::vector<topic_type> topics;
+        props_type props;
+        handler_type handler;
+    };
+
+private:
+    std::vector<request> _pending;
+    bool _enabled = false;
+
+public:
+    request_coalescer() = default;
+
+    void enable(bool enable) {
+        _enabled = enable;
+    }
+
+    bool enabled() const noexcept {
+        return _enabled;
+    }
+
+    // Returns true if the request is the first one to be coalesced,
+    // in which case the caller must schedule the flush.
+    bool add(request req) {
+        _pending.push_back(std::move(req));
+        return _pending.size() == 1;
+    }
+
+    // Takes all pending requests, divided into packets.
+    std::vector<std::vector<request>> take(size_t max_packet_size) {
+        auto pending = std::move(_pending);
+
+        struct packet {
+            std::vector<request> requests;
+            size_t size;
+        };
+        std::vector<packet> open; // last packet of each distinct props
+        std::vector<std::vector<request>> ret;
+
+        for (auto& req : pending) {
+            size_t req_size = 0;
+            for (const auto& topic : req.topics)
+                req_size += Traits::topic_size(topic);
+
+            auto it = std::find_if(
+                open.begin(), open.end(),
+                [&req](const packet& p) {
+                    return equal_props(p.requests.front().props, req.props);
+                }
+            );
+
+            if (
+                it != open.end() &&
+                packet_size(it->size + req_size) > max_packet_size
+            ) {
+                ret.push_back(std::move(it->requests));
+                open.erase(it);
+                it = open.end();
+            }
+
+            if (it == open.end()) {
+                // Packet Identifier and properties
+                auto header_size = 2 + encoders::prop::props_(req.props).byte_size();
+                it = open.insert(open.end(), packet { {}, header_size });
+            }
+
+            it->size += req_size;
+            it->requests.push_back(std::move(req));
+        }
+
+        for (auto& p : open)
+            ret.push_back(std::move(p.requests));
+        return ret;
+    }
+
+    void cancel(const asio::any_io_executor& ex) {
+        auto pending = std::move(_pending);
+        for (auto& req : pending)
+            asio::post(
+                ex,
+                asio::prepend(
+                    std::move(req.handler),
+                    error_code(asio::error::operation_aborted),
+                    std::vector<uint8_t> {}, ack_props_type {}
+                )
+            );
+    }
+};
+
+} // end namespace boost::mqtt5::detail
+
+#endif // !BOOST_MQTT5_REQUEST_COALESCER_HPP
@@ -0,0 +1,251 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MQTT5_SUBSCRIPTION_REGISTRY_HPP
+#define BOOST_MQTT5_SUBSCRIPTION_REGISTRY_HPP
+
+#include <boost/mqtt5/types.hpp>
+
+#include <boost/mqtt5/impl/codecs/message_encoders.hpp>
+
+#include <boost/container_hash/hash.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace boost::mqtt5::detail {
+
+// Size of a packet with the given Remaining Length.
+inline size_t packet_size(size_t remaining_length) {
+    size_t varlen_size = remaining_length < 128 ? 1 :
+        remaining_length < 16'384 ? 2 :
+        remaining_length < 2'097'152 ? 3 : 4;
+    return 1 + varlen_size + remaining_length;
+}
+
+inline bool equal_props(const subscribe_props& a, const subscribe_props& b) {
+    const auto& a_id = a[prop::subscription_identifier];
+    const auto& b_id = b[prop::subscription_identifier];
+    if (a_id.has_value() != b_id.has_value())
+        return false;
+    if (a_id.has_value() && *a_id != *b_id)
+        return false;
+    return a[prop::user_property] == b[prop::user_property];
+}
+
+// Consistent with equal_props.
+inline size_t props_hash(const subscribe_props& props) {
+    size_t seed = 0;
+    const auto& id = props[prop::subscription_identifier];
+    boost::hash_combine(seed, id.has_value());
+    if (id.has_value())
+        boost::hash_combine(seed, *id);
+    for (const auto& [key, value] : props[prop::user_property]) {
+        boost::hash_combine(seed, key);
+        boost::hash_combine(seed, value);
+    }
+    return seed;
+}
+
+/*
+    Subscriptions the Server has granted to the Client, kept so that
+    they can be re-established when the Server does not have a Session
+    for the Client after a reconnect.
+
+    A Subscription is keyed by its Topic Filter, as subscribing to the same
+    Topic Filter again replaces the existing Subscription. Subscriptions are
+    re-subscribed in the order of their Topic Filters.
+    SUBSCRIBE properties (Subscription Identifier, User Properties) apply
+    to all Topic Filters in the packet, so Subscriptions with equal
+    properties share a single group and are re-subscribed together.
+*/
+class subscription_registry {
+    struct entry {
+        subscribe_options options;
+        size_t group;
+    };
+
+    struct group {
+        subscribe_props props;
+        size_t hash = 0;
+        size_t refs = 0;
+    };
+
+    std::map<std::string, entry, std::less<>> _entries;
+    std::vector<group> _groups;
+    size_t _last_group = 0;
+
+    // groups in use by the hash of their properties
+    std::unordered_multimap<size_t, size_t> _group_index;
+    // unused groups, as a min-heap so that the lowest is reused first
+    std::vector<size_t> _free_groups;
+
+    uint32_t _round = 0;
+    bool _enabled = false;
+
+public:
+    struct batch {
+        std::vector<subscribe_topic> topics;
+        subscribe_props props;
+    };
+
+    subscription_registry() = default;
+
+    explicit subscription_registry(bool enabled) : _enabled(enabled) {}
+
+    void enable(bool enable) {
+        _enabled = enable;
+        if (!enable)
+            clear();
+    }
+
+    bool enabled() const noexcept {
+        return _enabled;
+    }
+
+    bool empty() const noexcept {
+        return _entries.empty();
+    }
+
+    size_t size() const noexcept {
+        return _entries.size();
+    }
+
+    void clear() {
+        _entries.clear();
+        _groups.clear();
+        _last_group = 0;
+        _group_index.clear();
+        _free_groups.clear();
+    }
+
+    // Changes every time the Subscriptions are re-subscribed, so that
+    // SUBSCRIBE packets of an interrupted round are not resent.
+    uint32_t round() const noexcept {
+        return _round;
+    }
+
+    void add(const subscribe_topic& topic, const subscribe_props& props) {
+        if (!_enabled)
+            return;
+
+        auto group = find_group(props);
+        ++_groups[group].refs;
+
+        auto [it, inserted] = _entries.try_emplace(
+            topic.topic_filter, entry { topic.sub_opts, group }
+        );
+        if (!inserted) {
+            release_group(it->second.group);
+            it->second = entry { topic.sub_opts, group };
+        }
+    }
+
+    void remove(const std::string& topic_filter) {
+        auto it = _entries.find(topic_filter);
+        if (it == _entries.end())
+            return;
+
+        release_group(it->second.group);
+        _entries.erase(it);
+    }
+
+    // Splits the Subscriptions into as few SUBSCRIBE packets as possible,
+    // none of them larger than max_packet_size (unless it consists of
+    // a single Topic Filter that does not fit on its own).
+    std::vector<batch> batches(size_t max_packet_size) {
+        ++_round;
+
+        std::vector<std::vector<subscribe_topic>> grouped(_groups.size());
+        for (const auto& [topic_filter, e] : _entries)
+            grouped[e.group].push_back({ topic_filter, e.options });
+
+        std::vector<batch> ret;
+        for (size_t g = 0; g < grouped.size(); ++g) {
+            if (grouped[g].empty())
+                continue;
+
+            const auto& props = _groups[g].props;
+            // Packet Identifier and properties
+            size_t header_size = 2 + encoders::prop::props_(props).byte_size();
+
+            batch current { {}, props };
+            size_t payload_size = 0;
+            for (auto& topic : grouped[g]) {
+                // Topic Filter (UTF-8 Encoded String) and Subscription Options
+                size_t topic_size = 2 + topic.topic_filter.size() + 1;
+                if (
+                    !current.topics.empty() &&
+                    packet_size(header_size + payload_size + topic_size) >
+                        max_packet_size
+                ) {
+                    ret.push_back(std::move(current));
+                    current = batch { {}, props };
+                    payload_size = 0;
+                }
+                payload_size += topic_size;
+                current.topics.push_back(std::move(topic));
+            }
+            ret.push_back(std::move(current));
+        }
+        return ret;
+    }
+
+private:
+    size_t find_group(const subscribe_props& props) {
+        // consecutive additions usually come from the same SUBSCRIBE
+        if (
+            _last_group < _groups.size() && _groups[_last_group].refs &&
+            equal_props(_groups[_last_group].props, props)
+        )
+            return _last_group;
+
+        auto hash = props_hash(props);
+        auto [first, last] = _group_index.equal_range(hash);
+        for (auto it = first; it != last; ++it)
+            if (equal_props(_groups[it->second].props, props))
+                return _last_group = it->second;
+
+        size_t free_group = _groups.size();
+        if (!_free_groups.empty()) {
+            std::pop_heap(
+                _free_groups.begin(), _free_groups.end(), std::greater<> {}
+            );
+            free_group = _free_groups.back();
+            _free_groups.pop_back();
+        }
+        else
+            _groups.emplace_back();
+
+        _groups[free_group] = group { props, hash, 0 };
+        _group_index.emplace(hash, free_group);
+        return _last_group = free_group;
+    }
+
+    void release_group(size_t g) {
+        if (--_groups[g].refs != 0)
+            return;
+
+        auto [first, last] = _group_index.equal_range(_groups[g].hash);
+        _group_index.erase(std::find_if(
+            first, last, [g](const auto& i) { return i.second == g; }
+        ));
+        _groups[g].props = subscribe_props {};
+        _free_groups.push_back(g);
+        std::push_heap(_free_groups.begin(), _free_groups.end(), std::greater<> {});
+    }
+};
+
+} // end namespace boost::mqtt5::detail
+
+#endif // !BOOST_MQTT5_SUBSCRIPTION_REGISTRY_HPP
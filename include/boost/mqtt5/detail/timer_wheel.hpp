@@ -0,0 +1,365 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MQTT5_TIMER_WHEEL_HPP
+#define BOOST_MQTT5_TIMER_WHEEL_HPP
+
+#include <boost/mqtt5/detail/internal_types.hpp>
+
+#include <boost/asio/any_completion_handler.hpp>
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/associated_cancellation_slot.hpp>
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/cancellation_type.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/execution.hpp>
+#include <boost/asio/execution_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/prefer.hpp>
+#include <boost/asio/query.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace boost::mqtt5::detail {
+
+namespace asio = boost::asio;
+using error_code = boost::system::error_code;
+
+/*
+    A hashed timer wheel shared by all wheel_timers of an execution context.
+
+    Waits are placed in one of num_slots slots by their expiry, rounded up
+    to the next tick, and a single steady_timer advances the wheel one slot
+    per tick while any wait is pending. Waits further than one revolution
+    away are kept in their slot for the number of revolutions remaining.
+    Arming and cancelling a wait is O(1); each tick visits one slot.
+
+    Completion handlers are invoked as if by post, on their associated
+    executor or on the executor of the wheel_timer if they have none.
+*/
+class timer_wheel : public asio::execution_context::service {
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    static constexpr auto tick = std::chrono::milliseconds(100);
+    static constexpr size_t num_slots = 512;
+
+    static inline asio::execution_context::id id {};
+
+    // Intrusive doubly-linked list node.
+    struct hook {
+        hook* prev = this;
+        hook* next = this;
+
+        bool linked() const noexcept {
+            return next != this;
+        }
+
+        void link_before(hook& h) noexcept {
+            prev = h.prev;
+            next = &h;
+            h.prev->next = this;
+            h.prev = this;
+        }
+
+        void unlink() noexcept {
+            prev->next = next;
+            next->prev = prev;
+            prev = next = this;
+        }
+    };
+
+    // A pending wait, embedded in its wheel_timer.
+    struct entry : hook {
+        uint64_t rounds = 0;
+        bool scheduled = false;
+        asio::any_completion_handler<void (error_code)> handler;
+        asio::any_io_executor executor;
+    };
+
+private:
+    using base = asio::execution_context::service;
+
+    struct completion {
+        asio::any_completion_handler<void (error_code)> handler;
+        asio::any_io_executor executor;
+    };
+
+    std::mutex _mutex;
+    std::array<hook, num_slots> _slots;
+    hook _unscheduled; // waits that never expire
+
+    size_t _num_scheduled = 0;
+    uint64_t _current_tick = 0;
+    clock_type::time_point _tick_time;
+    std::optional<asio::steady_timer> _tick_timer;
+    bool _ticking = false;
+    bool _shut_down = false;
+
+public:
+    explicit timer_wheel(asio::execution_context& context) : base(context) {}
+
+    timer_wheel(const timer_wheel&) = delete;
+    timer_wheel& operator=(const timer_wheel&) = delete;
+
+    // Number of pending waits, including those that never expire.
+    size_t num_waits() {
+        std::lock_guard lock(_mutex);
+        size_t count = 0;
+        for (auto* h = _unscheduled.next; h != &_unscheduled; h = h->next)
+            ++count;
+        return count + _num_scheduled;
+    }
+
+    template <typename Handler>
+    void schedule(
+        entry& e, clock_type::time_point expiry,
+        Handler&& handler, const asio::any_io_executor& ex
+    ) {
+        auto work = asio::prefer(
+            asio::get_associated_executor(handler, ex),
+            asio::execution::outstanding_work.tracked
+        );
+
+        std::lock_guard lock(_mutex);
+        if (_shut_down)
+            return;
+
+        e.handler = std::forward<Handler>(handler);
+        e.executor = std::move(work);
+
+        if (expiry == clock_type::time_point::max()) {
+            e.link_before(_unscheduled);
+            return;
+        }
+
+        if (!_ticking)
+            start_ticking(ex);
+
+        auto ticks = (std::max)(
+            (expiry - _tick_time + tick - clock_type::duration(1)) / tick,
+            clock_type::duration::rep(1)
+        );
+        auto slot = (_current_tick + ticks) % num_slots;
+        e.rounds = (ticks - 1) / num_slots;
+        e.scheduled = true;
+        e.link_before(_slots[slot]);
+        ++_num_scheduled;
+    }
+
+    // Completes the pending wait, if any, with operation_aborted.
+    size_t cancel(entry& e) {
+        std::unique_lock lock(_mutex);
+        if (!e.linked())
+            return 0;
+        auto c = unlink(e);
+        lock.unlock();
+
+        complete(std::move(c), asio::error::operation_aborted);
+        return 1;
+    }
+
+    // Removes the pending wait, if any, without invoking its handler.
+    void remove(entry& e) {
+        std::unique_lock lock(_mutex);
+        if (!e.linked())
+            return;
+        auto c = unlink(e);
+        lock.unlock();
+        // the handler is destroyed without the lock held
+    }
+
+private:
+    void shutdown() override {
+        std::vector<completion> pending;
+        {
+            std::lock_guard lock(_mutex);
+            _shut_down = true;
+            for (auto& s : _slots)
+                unlink_all(s, pending);
+            unlink_all(_unscheduled, pending);
+            _ticking = false;
+            _tick_timer.reset();
+        }
+        // the handlers are destroyed without the lock held
+    }
+
+    void unlink_all(hook& list, std::vector<completion>& out) {
+        while (list.linked())
+            out.push_back(unlink(static_cast<entry&>(*list.next)));
+    }
+
+    completion unlink(entry& e) {
+        e.unlink();
+        if (std::exchange(e.scheduled, false))
+            --_num_scheduled;
+        if (_num_scheduled == 0 && _ticking) {
+            _ticking = false;
+            _tick_timer->cancel();
+        }
+        return { std::move(e.handler), std::move(e.executor) };
+    }
+
+    void start_ticking(const asio::any_io_executor& ex) {
+        if (!_tick_timer)
+            _tick_timer.emplace(ex);
+        _ticking = true;
+        _tick_time = clock_type::now();
+        wait_tick();
+    }
+
+    void wait_tick() {
+        _tick_timer->expires_at(_tick_time + tick);
+        _tick_timer->async_wait([this](error_code ec) { on_tick(ec); });
+    }
+
+    void on_tick(error_code ec) {
+        std::vector<completion> expired;
+        {
+            std::lock_guard lock(_mutex);
+            if (ec == asio::error::operation_aborted || !_ticking)
+                return;
+
+            auto now = clock_type::now();
+            while (_tick_time + tick <= now && _num_scheduled) {
+                _tick_time += tick;
+                advance(expired);
+            }
+
+            if (_num_scheduled)
+                wait_tick();
+            else
+                _ticking = false;
+        }
+
+        for (auto& c : expired)
+            complete(std::move(c), error_code {});
+    }
+
+    void advance(std::vector<completion>& expired) {
+        auto& slot = _slots[++_current_tick % num_slots];
+        for (auto* h = slot.next; h != &slot;) {
+            auto& e = static_cast<entry&>(*h);
+            h = h->next;
+            if (e.rounds == 0) {
+                e.unlink();
+                e.scheduled = false;
+                --_num_scheduled;
+                expired.push_back({ std::move(e.handler), std::move(e.executor) });
+            }
+            else
+                --e.rounds;
+        }
+    }
+
+    static void complete(completion c, error_code ec) {
+        auto ex = std::move(c.executor);
+        asio::post(
+            ex,
+            [h = std::move(c.handler), ec]() mutable {
+                // cleared on the executor of the handler, never while
+                // the cancellation slot is emitting a signal
+                h.get_cancellation_slot().clear();
+                std::move(h)(ec);
+            }
+        );
+    }
+};
+
+// A timer with the interface of asio::steady_timer
+// whose waits are driven by the timer_wheel of its execution context.
+class wheel_timer {
+public:
+    using executor_type = asio::any_io_executor;
+    using clock_type = timer_wheel::clock_type;
+
+private:
+    executor_type _ex;
+    timer_wheel& _wheel;
+    timer_wheel::entry _entry;
+    clock_type::time_point _expiry = clock_type::now();
+
+    class cancel_wait {
+        wheel_timer& _timer;
+    public:
+        explicit cancel_wait(wheel_timer& timer) : _timer(timer) {}
+
+        void operator()(asio::cancellation_type_t type) {
+            if (type != asio::cancellation_type_t::none)
+                _timer.cancel();
+        }
+    };
+
+public:
+    explicit wheel_timer(const executor_type& ex) :
+        _ex(ex),
+        _wheel(asio::use_service<timer_wheel>(
+            asio::query(ex, asio::execution::context)
+        ))
+    {}
+
+    wheel_timer(const wheel_timer&) = delete;
+    wheel_timer& operator=(const wheel_timer&) = delete;
+
+    ~wheel_timer() {
+        cancel();
+    }
+
+    executor_type get_executor() const noexcept {
+        return _ex;
+    }
+
+    // Cancels the pending wait, like asio::steady_timer::expires_after.
+    // A duration too long to be represented never expires.
+    size_t expires_after(duration d) {
+        auto now = clock_type::now();
+        auto max_wait = clock_type::time_point::max() - now;
+        _expiry = d >= max_wait ? clock_type::time_point::max() : now + d;
+        return cancel();
+    }
+
+    size_t cancel() {
+        return _wheel.cancel(_entry);
+    }
+
+    template <typename CompletionToken>
+    decltype(auto) async_wait(CompletionToken&& token) {
+        using Signature = void (error_code);
+
+        // a wheel_timer has at most one pending wait
+        cancel();
+
+        auto initiation = [](auto handler, wheel_timer& self) {
+            auto slot = asio::get_associated_cancellation_slot(handler);
+            if (slot.is_connected())
+                slot.template emplace<cancel_wait>(self);
+            self._wheel.schedule(
+                self._entry, self._expiry, std::move(handler), self._ex
+            );
+        };
+
+        return asio::async_initiate<CompletionToken, Signature>(
+            initiation, token, std::ref(*this)
+        );
+    }
+};
+
+} // end namespace boost::mqtt5::detail
+
+#endif // !BOOST_MQTT5_TIMER_WHEEL_HPP
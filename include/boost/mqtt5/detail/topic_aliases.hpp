@@ -0,0 +1,225 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MQTT5_TOPIC_ALIASES_HPP
+#define BOOST_MQTT5_TOPIC_ALIASES_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace boost::mqtt5::detail {
+
+/*
+    Topic Aliases the Server has mapped in PUBLISH packets sent to the Client.
+
+    The mapping is valid only for the lifetime of a Network Connection
+    and the maximum alias is the Topic Alias Maximum the Client sent in CONNECT.
+    Topics are shared so that messages received in zero-copy mode can keep
+    referring to them after the Server remaps the alias.
+*/
+class inbound_topic_aliases {
+    std::vector<std::shared_ptr<const std::string>> _topics; // alias - 1
+    uint16_t _max = 0;
+
+public:
+    inbound_topic_aliases() = default;
+
+    void reset(uint16_t max) {
+        _topics.clear();
+        _max = max;
+    }
+
+    uint16_t max() const noexcept {
+        return _max;
+    }
+
+    bool valid(uint16_t alias) const noexcept {
+        return alias != 0 && alias <= _max;
+    }
+
+    void insert(uint16_t alias, std::string_view topic) {
+        if (_topics.size() < alias)
+            _topics.resize(alias);
+
+        auto& mapped = _topics[alias - 1];
+        if (!mapped || *mapped != topic)
+            mapped = std::make_shared<const std::string>(topic);
+    }
+
+    std::shared_ptr<const std::string> find(uint16_t alias) const {
+        if (alias == 0 || alias > _topics.size())
+            return nullptr;
+        return _topics[alias - 1];
+    }
+};
+
+/*
+    Topic Aliases the Client assigns automatically to Topics it publishes to.
+
+    Up to the Topic Alias Maximum the Server sent in CONNACK, every Topic
+    is assigned an alias; when all aliases are in use, the least recently
+    used one is reassigned.
+
+    The first PUBLISH with a new alias carries both the Topic and the alias.
+    The alias alone is used only after that PUBLISH has been written,
+    as PUBLISH packets are not necessarily written in the order they were
+    created (Receive Maximum throttling). For the same reason an alias is
+    never reassigned while a PUBLISH using it has not been written yet.
+
+    The generation changes whenever the mappings are discarded, so that
+    PUBLISH packets created for the previous Network Connection
+    can be recognized and sent without the alias.
+*/
+class outbound_topic_aliases {
+    static constexpr uint16_t nil = 0;
+
+    struct entry {
+        std::shared_ptr<const std::string> topic;
+        uint32_t in_flight = 0; // PUBLISH packets using the alias not yet written
+        bool confirmed = false; // a PUBLISH mapping the alias has been written
+        uint16_t prev = nil, next = nil; // LRU list, most recent first
+    };
+
+    std::vector<entry> _entries; // alias - 1
+    std::unordered_map<std::string_view, uint16_t> _aliases;
+    uint16_t _lru_head = nil, _lru_tail = nil;
+
+    uint16_t _max = 0;
+    uint32_t _generation = 0;
+    bool _enabled = false;
+
+public:
+    struct assignment {
+        uint16_t alias = 0;
+        bool alias_only = false; // send an empty Topic
+        std::shared_ptr<const std::string> topic;
+        uint32_t generation = 0;
+    };
+
+    outbound_topic_aliases() = default;
+
+    explicit outbound_topic_aliases(bool enabled) : _enabled(enabled) {}
+
+    void enable(bool enable) {
+        _enabled = enable;
+    }
+
+    bool enabled() const noexcept {
+        return _enabled;
+    }
+
+    void reset(uint16_t max) {
+        _entries.clear();
+        _aliases.clear();
+        _lru_head = _lru_tail = nil;
+        _max = _enabled ? max : 0;
+        ++_generation;
+    }
+
+    uint32_t generation() const noexcept {
+        return _generation;
+    }
+
+    // Returns an assignment with alias 0 if the Topic cannot be aliased.
+    assignment acquire(std::string_view topic) {
+        if (_max == 0)
+            return {};
+
+        uint16_t alias = nil;
+        if (auto it = _aliases.find(topic); it != _aliases.end())
+            alias = it->second;
+        else if (_entries.size() < _max) {
+            _entries.emplace_back();
+            alias = static_cast<uint16_t>(_entries.size());
+            map(alias, topic);
+        }
+        else if ((alias = find_unused()) != nil) {
+            _aliases.erase(*at(alias).topic);
+            unlink(alias);
+            at(alias) = entry {};
+            map(alias, topic);
+        }
+        else
+            return {};
+
+        auto& e = at(alias);
+        ++e.in_flight;
+        touch(alias);
+        return { alias, e.confirmed, e.topic, _generation };
+    }
+
+    // Called once the PUBLISH created with the assignment has been written
+    // (written == true) or discarded.
+    void release(const assignment& a, bool written) {
+        if (a.alias == nil || a.generation != _generation)
+            return;
+
+        auto& e = at(a.alias);
+        if (e.topic != a.topic)
+            return;
+
+        --e.in_flight;
+        if (written)
+            e.confirmed = true;
+    }
+
+private:
+    entry& at(uint16_t alias) {
+        return _entries[alias - 1];
+    }
+
+    void map(uint16_t alias, std::string_view topic) {
+        auto& e = at(alias);
+        e.topic = std::make_shared<const std::string>(topic);
+        _aliases.emplace(*e.topic, alias);
+    }
+
+    // Least recently used alias that is not used by any unwritten PUBLISH.
+    uint16_t find_unused() {
+        for (auto alias = _lru_tail; alias != nil; alias = at(alias).prev)
+            if (at(alias).in_flight == 0)
+                return alias;
+        return nil;
+    }
+
+    void unlink(uint16_t alias) {
+        auto& e = at(alias);
+        if (e.prev != nil)
+            at(e.prev).next = e.next;
+        else if (_lru_head == alias)
+            _lru_head = e.next;
+
+        if (e.next != nil)
+            at(e.next).prev = e.prev;
+        else if (_lru_tail == alias)
+            _lru_tail = e.prev;
+
+        e.prev = e.next = nil;
+    }
+
+    void touch(uint16_t alias) {
+        if (_lru_head == alias)
+            return;
+
+        unlink(alias);
+        auto& e = at(alias);
+        e.next = _lru_head;
+        if (_lru_head != nil)
+            at(_lru_head).prev = alias;
+        _lru_head = alias;
+        if (_lru_tail == nil)
+            _lru_tail = alias;
+    }
+};
+
+} // end namespace boost::mqtt5::detail
+
+#endif // !BOOST_MQTT5_TOPIC_ALIASES_HPP
@@ -0,0 +1,268 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MQTT5_TOPIC_TRIE_HPP
+#define BOOST_MQTT5_TOPIC_TRIE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace boost::mqtt5::detail {
+
+/*
+    Maps (already validated) Topic Filters to values and matches
+    Topic Names against them.
+
+    Every node represents one Topic level. Nodes are stored in a single
+    vector and refer to each other by index. Children of a node are kept
+    in a vector sorted by the level name; the single-level wildcard child
+    is kept apart and the multi-level wildcard, which can only be the last
+    level of a filter, is stored as a value of its parent node.
+*/
+class topic_trie {
+public:
+    using value_type = uint32_t;
+    static constexpr value_type npos = (std::numeric_limits<value_type>::max)();
+
+private:
+    using node_id = uint32_t;
+    static constexpr node_id root = 0;
+
+    static constexpr char level_separator = '/';
+    static constexpr std::string_view single_lvl_wildcard = "+";
+    static constexpr std::string_view multi_lvl_wildcard = "#";
+
+    struct node {
+        std::vector<std::pair<std::string, node_id>> children;
+        node_id parent = npos;
+        node_id single_lvl = npos;
+        value_type value = npos; // filter ending at this level
+        value_type multi_lvl = npos; // filter ending with "/#" at this level
+
+        bool empty() const {
+            return children.empty() && single_lvl == npos &&
+                value == npos && multi_lvl == npos;
+        }
+    };
+
+    std::vector<node> _nodes;
+    std::vector<node_id> _free_nodes;
+    size_t _size = 0;
+
+public:
+    topic_trie() : _nodes(1) {}
+
+    size_t size() const noexcept {
+        return _size;
+    }
+
+    bool empty() const noexcept {
+        return _size == 0;
+    }
+
+    void clear() {
+        _nodes.clear();
+        _nodes.emplace_back();
+        _free_nodes.clear();
+        _size = 0;
+    }
+
+    // Returns the value previously associated with the filter, or npos.
+    value_type insert(std::string_view filter, value_type value) {
+        node_id id = root;
+        std::optional<std::string_view> rest = filter;
+        for (auto level = next_level(rest); level; level = next_level(rest)) {
+            if (*level == multi_lvl_wildcard)
+                return replace_value(_nodes[id].multi_lvl, value);
+            id = find_or_add_child(id, *level);
+        }
+        return replace_value(_nodes[id].value, value);
+    }
+
+    value_type find(std::string_view filter) const {
+        node_id id = root;
+        std::optional<std::string_view> rest = filter;
+        for (auto level = next_level(rest); level; level = next_level(rest)) {
+            if (*level == multi_lvl_wildcard)
+                return _nodes[id].multi_lvl;
+            id = find_child(id, *level);
+            if (id == npos)
+                return npos;
+        }
+        return _nodes[id].value;
+    }
+
+    // Returns the value that was associated with the filter, or npos.
+    value_type erase(std::string_view filter) {
+        node_id id = root;
+        value_type* slot = nullptr;
+        std::optional<std::string_view> rest = filter;
+        for (auto level = next_level(rest); level; level = next_level(rest)) {
+            if (*level == multi_lvl_wildcard) {
+                slot = &_nodes[id].multi_lvl;
+                break;
+            }
+            id = find_child(id, *level);
+            if (id == npos)
+                return npos;
+        }
+        if (!slot)
+            slot = &_nodes[id].value;
+
+        auto rv = std::exchange(*slot, npos);
+        if (rv != npos) {
+            --_size;
+            prune(id);
+        }
+        return rv;
+    }
+
+    // Invokes f(value) for every filter matching the Topic Name.
+    template <typename Func>
+    void match(std::string_view topic, Func&& f) const {
+        // Topic Names beginning with '$' are not matched by filters
+        // beginning with a wildcard character [MQTT-4.7.2-1].
+        bool wildcard_root = topic.empty() || topic.front() != '$';
+        match(root, topic, wildcard_root, f);
+    }
+
+private:
+    template <typename Func>
+    void match(
+        node_id id, std::optional<std::string_view> rest,
+        bool wildcards, Func& f
+    ) const {
+        const node& n = _nodes[id];
+
+        // "a/#" matches "a" as well as all of its sub-levels
+        if (wildcards && n.multi_lvl != npos)
+            f(n.multi_lvl);
+
+        auto level = next_level(rest);
+        if (!level) {
+            if (n.value != npos)
+                f(n.value);
+            return;
+        }
+
+        if (auto child = find_child(id, *level); child != npos)
+            match(child, rest, true, f);
+
+        if (wildcards && n.single_lvl != npos)
+            match(n.single_lvl, rest, true, f);
+    }
+
+    // Splits the next level off the front of a Topic.
+    // Returns std::nullopt when there are no levels left.
+    static std::optional<std::string_view> next_level(
+        std::optional<std::string_view>& rest
+    ) {
+        if (!rest)
+            return std::nullopt;
+
+        auto pos = rest->find(level_separator);
+        auto level = rest->substr(0, pos);
+        if (pos == std::string_view::npos)
+            rest.reset();
+        else
+            rest->remove_prefix(pos + 1);
+        return level;
+    }
+
+    value_type replace_value(value_type& slot, value_type value) {
+        auto rv = std::exchange(slot, value);
+        if (rv == npos)
+            ++_size;
+        return rv;
+    }
+
+    static auto level_less() {
+        return [](const auto& child, std::string_view level) {
+            return std::string_view { child.first } < level;
+        };
+    }
+
+    node_id find_child(node_id id, std::string_view level) const {
+        if (level == single_lvl_wildcard)
+            return _nodes[id].single_lvl;
+
+        const auto& children = _nodes[id].children;
+        auto it = std::lower_bound(
+            children.begin(), children.end(), level, level_less()
+        );
+        if (it == children.end() || it->first != level)
+            return npos;
+        return it->second;
+    }
+
+    node_id find_or_add_child(node_id id, std::string_view level) {
+        if (level == single_lvl_wildcard) {
+            if (_nodes[id].single_lvl == npos) {
+                auto child = new_node(id);
+                _nodes[id].single_lvl = child;
+            }
+            return _nodes[id].single_lvl;
+        }
+
+        auto& children = _nodes[id].children;
+        auto it = std::lower_bound(
+            children.begin(), children.end(), level, level_less()
+        );
+        if (it != children.end() && it->first == level)
+            return it->second;
+
+        auto pos = std::distance(children.begin(), it);
+        auto child = new_node(id); // may reallocate _nodes
+        auto& siblings = _nodes[id].children;
+        siblings.emplace(siblings.begin() + pos, std::string(level), child);
+        return child;
+    }
+
+    node_id new_node(node_id parent) {
+        node_id id;
+        if (!_free_nodes.empty()) {
+            id = _free_nodes.back();
+            _free_nodes.pop_back();
+        }
+        else {
+            id = static_cast<node_id>(_nodes.size());
+            _nodes.emplace_back();
+        }
+        _nodes[id].parent = parent;
+        return id;
+    }
+
+    // Removes the node and its ancestors if they no longer lead to any filter.
+    void prune(node_id id) {
+        while (id != root && _nodes[id].empty()) {
+            auto parent = _nodes[id].parent;
+            auto& pnode = _nodes[parent];
+
+            if (pnode.single_lvl == id)
+                pnode.single_lvl = npos;
+            else
+                pnode.children.erase(std::find_if(
+                    pnode.children.begin(), pnode.children.end(),
+                    [id](const auto& child) { return child.second == id; }
+                ));
+
+            _nodes[id] = node {};
+            _free_nodes.push_back(id);
+            id = parent;
+        }
+    }
+};
+
+} // end namespace boost::mqtt5::detail
+
+#endif // !BOOST_MQTT5_TOPIC_TRIE_HPP
@@ -63,6 +63,13 @@ inline validation_result validate_topic_filter(std::string_view str) {
     int last_c = -1;
     validation_result result;
     while (!str.empty()) {
+        if (is_plain_ascii(str.front())) {
+            size_t n = plain_ascii_prefix(str);
+            last_c = str[n - 1];
+            str.remove_prefix(n);
+            continue;
+        }
+
         int c = pop_front_unichar(str);
 
         // can be used at any level, but must occupy an entire level
@@ -8,11 +8,23 @@
 #ifndef BOOST_MQTT5_UTF8_MQTT_HPP
 #define BOOST_MQTT5_UTF8_MQTT_HPP
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <string>
 #include <string_view>
 #include <utility>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BOOST_MQTT5_UTF8_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace boost::mqtt5::detail {
 
 enum class validation_result : uint8_t {
@@ -70,6 +82,89 @@ inline validation_result validate_mqtt_utf8_char(int c) {
     return validation_result::invalid;
 }
 
+// Printable ASCII characters other than the wildcards,
+// which are valid in any MQTT UTF-8 string.
+inline bool is_plain_ascii(char c) {
+    auto u = static_cast<unsigned char>(c);
+    return u > 0x1F && u < 0x7F && u != '#' && u != '+';
+}
+
+// Returns the length of the leading run of plain ASCII characters in s.
+// Topics and most string properties consist solely of such characters,
+// so they are checked a block at a time before falling back to decoding
+// code points one by one.
+inline size_t plain_ascii_prefix(std::string_view s) {
+    const char* first = s.data();
+    const char* it = first;
+    const char* last = first + s.size();
+
+#if defined(__AVX2__)
+    {
+        const __m256i lower = _mm256_set1_epi8(0x1F);
+        const __m256i upper = _mm256_set1_epi8(0x7F);
+        const __m256i multi_lvl = _mm256_set1_epi8('#');
+        const __m256i single_lvl = _mm256_set1_epi8('+');
+
+        for (; last - it >= 32; it += 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(it));
+            // signed comparison, bytes >= 0x80 are negative
+            __m256i printable = _mm256_and_si256(
+                _mm256_cmpgt_epi8(v, lower), _mm256_cmpgt_epi8(upper, v)
+            );
+            __m256i wildcard = _mm256_or_si256(
+                _mm256_cmpeq_epi8(v, multi_lvl), _mm256_cmpeq_epi8(v, single_lvl)
+            );
+            if (_mm256_movemask_epi8(_mm256_andnot_si256(wildcard, printable)) != -1)
+                break;
+        }
+    }
+#endif
+
+#if defined(BOOST_MQTT5_UTF8_SSE2)
+    {
+        const __m128i lower = _mm_set1_epi8(0x1F);
+        const __m128i upper = _mm_set1_epi8(0x7F);
+        const __m128i multi_lvl = _mm_set1_epi8('#');
+        const __m128i single_lvl = _mm_set1_epi8('+');
+
+        for (; last - it >= 16; it += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+            // signed comparison, bytes >= 0x80 are negative
+            __m128i printable = _mm_and_si128(
+                _mm_cmpgt_epi8(v, lower), _mm_cmplt_epi8(v, upper)
+            );
+            __m128i wildcard = _mm_or_si128(
+                _mm_cmpeq_epi8(v, multi_lvl), _mm_cmpeq_epi8(v, single_lvl)
+            );
+            if (_mm_movemask_epi8(_mm_andnot_si128(wildcard, printable)) != 0xFFFF)
+                break;
+        }
+    }
+#endif
+
+    // eight characters at a time in a 64-bit word
+    constexpr uint64_t ones = 0x0101010101010101;
+    constexpr uint64_t highs = ones * 0x80;
+    auto has_zero = [](uint64_t w) { return (w - ones) & ~w & highs; };
+
+    for (; last - it >= 8; it += 8) {
+        uint64_t w;
+        std::memcpy(&w, it, sizeof(w));
+        uint64_t below = (w - ones * 0x20) & ~w & highs; // < 0x20
+        uint64_t above = ((w + ones) | w) & highs; // > 0x7E
+        if (
+            below | above |
+            has_zero(w ^ (ones * '#')) | has_zero(w ^ (ones * '+'))
+        )
+            break;
+    }
+
+    while (it != last && is_plain_ascii(*it))
+        ++it;
+
+    return static_cast<size_t>(it - first);
+}
+
 inline bool is_valid_string_size(size_t sz) {
     constexpr size_t max_sz = 65535;
     return sz <= max_sz;
@@ -90,6 +185,11 @@ validation_result validate_impl(
 
     validation_result result;
     while (!str.empty()) {
+        if (is_plain_ascii(str.front())) {
+            str.remove_prefix(plain_ascii_prefix(str));
+            continue;
+        }
+
         int c = pop_front_unichar(str);
 
         result = validate_mqtt_utf8_char(c);
@@ -113,4 +213,6 @@ inline bool is_valid_string_pair(
 
 } // namespace boost::mqtt5::detail
 
+#undef BOOST_MQTT5_UTF8_SSE2
+
 #endif //BOOST_MQTT5_UTF8_MQTT_HPP
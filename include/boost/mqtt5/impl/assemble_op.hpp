@@ -24,8 +24,10 @@
 #include <boost/assert.hpp>
 #include <boost/system/error_code.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -64,17 +66,22 @@ class assemble_op {
     struct on_read {};
 
     static constexpr uint32_t max_recv_size = 65'536;
+    static constexpr uint32_t low_footprint_read_size = 256;
+    static constexpr uint32_t replacement_read_size = 4'096;
 
     client_service& _svc;
     handler_type _handler;
 
-    std::string& _read_buff;
+    std::shared_ptr<std::string>& _read_buff;
     data_span& _data_span;
 
+    // Size of the packet being assembled, once its fixed header is read.
+    uint32_t _packet_size = 0;
+
 public:
     assemble_op(
         client_service& svc, handler_type&& handler,
-        std::string& read_buff, data_span& active_span
+        std::shared_ptr<std::string>& read_buff, data_span& active_span
     ) :
         _svc(svc),
         _handler(std::move(handler)),
@@ -99,18 +106,16 @@ public:
 
     template <typename CompletionCondition>
     void perform(CompletionCondition cc) {
-        _read_buff.erase(
-            _read_buff.cbegin(), _data_span.first()
-        );
-        _read_buff.resize(
-            _svc.connect_property(prop::maximum_packet_size).value_or(max_recv_size)
-        );
-        _data_span = {
-            _read_buff.cbegin(),
-            _read_buff.cbegin() + _data_span.size()
-        };
+        bool has_data = cc(error_code {}, 0) == 0 && _data_span.size();
+
+        if (_read_buff.use_count() == 1)
+            compact_read_buff();
+        else if (!has_data)
+            // received messages still refer to the current buffer
+            // (zero-copy receive), continue reading into a new one
+            replace_read_buff();
 
-        if (cc(error_code {}, 0) == 0 && _data_span.size()) {
+        if (has_data) {
             return asio::post(
                 _svc.get_executor(),
                 asio::prepend(
@@ -121,8 +126,8 @@ public:
         }
 
         // Must be evaluated before this is moved
-        auto store_begin = _read_buff.data() + _data_span.size();
-        auto store_size = std::distance(_data_span.last(), _read_buff.cend());
+        auto store_begin = _read_buff->data() + _data_span.size();
+        auto store_size = std::distance(_data_span.last(), _read_buff->cend());
 
         _svc._stream.async_read_some(
             asio::buffer(store_begin, store_size), compute_read_timeout(),
@@ -141,7 +146,7 @@ public:
         if (ec == asio::error::try_again) {
             _svc.update_session_state();
             _svc._async_sender.resend();
-            _data_span = { _read_buff.cend(), _read_buff.cend() };
+            _data_span = { _read_buff->cend(), _read_buff->cend() };
             return perform(std::move(cc));
         }
 
@@ -168,13 +173,15 @@ public:
             return complete(client::error::malformed_packet, 0, {}, {});
         }
 
-        auto recv_size = _svc.connect_property(prop::maximum_packet_size)
-            .value_or(max_recv_size);
-        if (static_cast<uint32_t>(*varlen) > recv_size - std::distance(_data_span.first(), first))
+        auto header_size = std::distance(_data_span.first(), first);
+        if (static_cast<uint32_t>(*varlen) > max_packet_size() - header_size)
             return complete(client::error::malformed_packet, 0, {}, {});
 
-        if (std::distance(first, _data_span.last()) < *varlen)
+        if (std::distance(first, _data_span.last()) < *varlen) {
+            _packet_size = static_cast<uint32_t>(header_size + *varlen);
             return perform(asio::transfer_at_least(1));
+        }
+        _packet_size = 0;
 
         _data_span.remove_prefix(
             std::distance(_data_span.first(), first) + *varlen
@@ -184,6 +191,58 @@ public:
     }
 
 private:
+    uint32_t max_packet_size() const {
+        return _svc.connect_property(prop::maximum_packet_size)
+            .value_or(max_recv_size);
+    }
+
+    // In low-footprint mode, the buffer only grows to fit the packet
+    // being assembled and the packets not yet dispatched.
+    uint32_t read_buff_size() const {
+        if (!_svc.low_footprint())
+            return max_packet_size();
+        return fitted_buff_size(low_footprint_read_size);
+    }
+
+    uint32_t fitted_buff_size(uint32_t min_size) const {
+        return (std::max)({
+            min_size, _packet_size,
+            static_cast<uint32_t>(_data_span.size())
+        });
+    }
+
+    void compact_read_buff() {
+        _read_buff->erase(
+            _read_buff->cbegin(), _data_span.first()
+        );
+        _read_buff->resize(read_buff_size());
+        if (_svc.low_footprint())
+            // releases the memory of a large packet received earlier
+            _read_buff->shrink_to_fit();
+        _data_span = {
+            _read_buff->cbegin(),
+            _read_buff->cbegin() + _data_span.size()
+        };
+    }
+
+    // The replaced buffer stays alive as long as the messages referring
+    // to it, so its replacement is sized to the packet being assembled
+    // rather than to the maximum packet size.
+    void replace_read_buff() {
+        auto buff = std::make_shared<std::string>(
+            _data_span.first(), _data_span.last()
+        );
+        buff->resize(fitted_buff_size(
+            _svc.low_footprint() ? low_footprint_read_size : replacement_read_size
+        ));
+        auto size = _data_span.size();
+        _read_buff = std::move(buff);
+        _data_span = {
+            _read_buff->cbegin(),
+            _read_buff->cbegin() + size
+        };
+    }
+
     duration compute_read_timeout() const {
         auto negotiated_ka = _svc.negotiated_keep_alive();
         return negotiated_ka ?
@@ -221,8 +280,10 @@ private:
             code != control_code_e::disconnect;
 
         if (is_reply) {
-            auto packet_id = decoders::decode_packet_id(first).value();
-            _svc._replies.dispatch(error_code {}, code, packet_id, first, last);
+            auto packet_id = decoders::decode_packet_id(first, last);
+            if (!packet_id)
+                return complete(client::error::malformed_packet, 0, {}, {});
+            _svc._replies.dispatch(error_code {}, code, *packet_id, first, last);
             return perform(asio::transfer_at_least(0));
         }
 
@@ -234,7 +295,7 @@ private:
         byte_citer first, byte_citer last
     ) {
         if (ec)
-            _data_span = { _read_buff.cend(), _read_buff.cend() };
+            _data_span = { _read_buff->cend(), _read_buff->cend() };
         std::move(_handler)(ec, control_code, first, last);
     }
 };
@@ -8,6 +8,9 @@
 #ifndef BOOST_MQTT5_ASYNC_SENDER_HPP
 #define BOOST_MQTT5_ASYNC_SENDER_HPP
 
+#include <boost/mqtt5/error.hpp>
+
+#include <boost/mqtt5/detail/control_packet.hpp>
 #include <boost/mqtt5/detail/internal_types.hpp>
 
 #include <boost/asio/any_completion_handler.hpp>
@@ -18,11 +21,15 @@
 #include <boost/asio/error.hpp>
 #include <boost/asio/post.hpp>
 #include <boost/asio/prepend.hpp>
-#include <boost/asio/recycling_allocator.hpp>
 #include <boost/system/error_code.hpp>
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -33,7 +40,12 @@ namespace asio = boost::asio;
 class write_req {
     static constexpr unsigned SERIAL_BITS = sizeof(serial_num_t) * 8;
 
+    // buffers this short (see short_packet) are copied into the request
+    static constexpr size_t max_inline_size = short_packet::max_size;
+
     asio::const_buffer _buffer;
+    std::array<char, max_inline_size> _inline {};
+    uint8_t _inline_size { 0 };
     serial_num_t _serial_num;
     unsigned _flags;
 
@@ -48,7 +60,12 @@ public:
     ) :
         _buffer(buffer), _serial_num(serial_num), _flags(flags),
         _handler(std::move(handler))
-    {}
+    {
+        if (buffer.size() != 0 && buffer.size() <= max_inline_size) {
+            std::memcpy(_inline.data(), buffer.data(), buffer.size());
+            _inline_size = uint8_t(buffer.size());
+        }
+    }
 
     write_req(write_req&&) = default;
     write_req(const write_req&) = delete;
@@ -61,6 +78,8 @@ public:
     }
 
     asio::const_buffer buffer() const {
+        if (_inline_size)
+            return asio::buffer(_inline.data(), _inline_size);
         return _buffer;
     }
 
@@ -113,13 +132,31 @@ class async_sender {
 
     using client_service = ClientService;
 
-    using queue_allocator_type = asio::recycling_allocator<write_req>;
+    template <typename T>
+    using rebind_alloc = typename std::allocator_traits<
+        typename client_service::internal_allocator_type
+    >::template rebind_alloc<T>;
+
+    using queue_allocator_type = rebind_alloc<write_req>;
     using write_queue_t = std::vector<write_req, queue_allocator_type>;
+    using buffers_t = std::vector<asio::const_buffer, rebind_alloc<asio::const_buffer>>;
 
     ClientService& _svc;
     write_queue_t _write_queue;
     bool _write_in_progress { false };
 
+    // packets without a completion handler, appended to the next write
+    std::string _detached;
+    std::string _detached_written;
+    size_t _max_detached_size { default_max_detached_size };
+
+    // offsets and sizes of the detached packets carrying a Topic Alias,
+    // which is not valid in a new Network Connection
+    using packet_ranges = std::vector<std::pair<size_t, size_t>>;
+    packet_ranges _aliased;
+    packet_ranges _aliased_written;
+
+    static constexpr size_t default_max_detached_size = 1'048'576;
     static constexpr uint16_t MAX_LIMIT = 65535;
     uint16_t _limit { MAX_LIMIT };
     uint16_t _quota { MAX_LIMIT };
@@ -127,17 +164,20 @@ class async_sender {
     serial_num_t _last_serial_num { 0 };
 
 public:
-    explicit async_sender(ClientService& svc) : _svc(svc) {}
+    explicit async_sender(ClientService& svc) :
+        _svc(svc),
+        _write_queue(queue_allocator_type(svc.get_internal_allocator()))
+    {}
 
-    async_sender(async_sender&&) = default;
+    async_sender(async_sender&&) noexcept = default;
     async_sender(const async_sender&) = delete;
 
-    async_sender& operator=(async_sender&&) = default;
+    async_sender& operator=(async_sender&&) noexcept = default;
     async_sender& operator=(const async_sender&) = delete;
 
     using allocator_type = queue_allocator_type;
     allocator_type get_allocator() const noexcept {
-        return allocator_type {};
+        return _write_queue.get_allocator();
     }
 
     using executor_type = typename client_service::executor_type;
@@ -173,7 +213,42 @@ public:
         );
     }
 
+    size_t max_detached_size() const {
+        return _max_detached_size;
+    }
+
+    void max_detached_size(size_t size) {
+        _max_detached_size = size;
+    }
+
+    // Discards the packet and returns an error if the encoded packet is larger
+    // than max_size, or if the detached packets not yet written would exceed
+    // their budget.
+    template <typename EncodeFun>
+    error_code write_detached(EncodeFun&& encode, size_t max_size, bool aliased) {
+        auto size = _detached.size();
+        auto packet_size = encode(_detached);
+
+        error_code ec;
+        if (packet_size > max_size)
+            ec = client::error::packet_too_large;
+        else if (_detached_written.size() + _detached.size() > _max_detached_size)
+            ec = asio::error::would_block;
+
+        if (ec) {
+            _detached.resize(size);
+            return ec;
+        }
+
+        if (aliased)
+            _aliased.emplace_back(size, packet_size);
+        do_write();
+        return error_code {};
+    }
+
     void cancel() {
+        _detached.clear();
+        _aliased.clear();
         auto ops = std::move(_write_queue);
         for (auto& op : ops)
             op.complete_post(_svc.get_executor(), asio::error::operation_aborted);
@@ -192,7 +267,12 @@ public:
         _limit = new_limit.value_or(MAX_LIMIT);
         _quota = _limit;
 
+        drop_aliased();
+
         auto write_queue = std::move(_write_queue);
+        // Subscriptions lost together with the Session are re-established
+        // before anything else is resent.
+        _svc.resubscribe();
         _svc._replies.resend_unanswered();
 
         for (auto& op : write_queue)
@@ -208,6 +288,15 @@ public:
         _write_in_progress = false;
 
         if (ec == asio::error::try_again) {
+            // written again, ahead of the ones detached in the meantime
+            for (const auto& [offset, size] : _aliased)
+                _aliased_written.emplace_back(_detached_written.size() + offset, size);
+            _detached_written.append(_detached);
+            _detached.swap(_detached_written);
+            _aliased.swap(_aliased_written);
+            _detached_written.clear();
+            _aliased_written.clear();
+
             _svc.update_session_state();
             _write_queue.insert(
                 _write_queue.begin(),
@@ -217,6 +306,9 @@ public:
             return resend();
         }
 
+        _detached_written.clear();
+        _aliased_written.clear();
+
         if (ec == asio::error::no_recovery)
             _svc.cancel();
 
@@ -242,20 +334,28 @@ public:
     }
 
 private:
+    void drop_aliased() {
+        // in reverse order, so that the offsets of the others stay valid
+        for (auto it = _aliased.rbegin(); it != _aliased.rend(); ++it)
+            _detached.erase(it->first, it->second);
+        _aliased.clear();
+    }
+
     void do_write() {
-        if (_write_in_progress || _write_queue.empty())
+        if (_write_in_progress || (_write_queue.empty() && _detached.empty()))
             return;
 
         _write_in_progress = true;
 
-        write_queue_t write_queue;
+        write_queue_t write_queue(_write_queue.get_allocator());
 
         auto terminal_req = std::find_if(
             _write_queue.begin(), _write_queue.end(),
             [](const auto& op) { return op.terminal(); }
         );
 
-        if (terminal_req != _write_queue.end()) {
+        bool terminal = terminal_req != _write_queue.end();
+        if (terminal) {
             write_queue.push_back(std::move(*terminal_req));
             _write_queue.erase(terminal_req);
         }
@@ -271,7 +371,7 @@ private:
                     write_queue.push_back(std::move(req));
                 }
 
-            if (write_queue.empty()) {
+            if (write_queue.empty() && _detached.empty()) {
                 _write_in_progress = false;
                 return;
             }
@@ -283,11 +383,19 @@ private:
             _write_queue.erase(it, _write_queue.end());
         }
 
-        std::vector<asio::const_buffer> buffers;
-        buffers.reserve(write_queue.size());
+        buffers_t buffers(
+            typename buffers_t::allocator_type(_write_queue.get_allocator())
+        );
+        buffers.reserve(write_queue.size() + 1);
         for (const auto& op : write_queue)
             buffers.push_back(op.buffer());
 
+        if (!terminal && !_detached.empty()) {
+            _detached.swap(_detached_written);
+            _aliased.swap(_aliased_written);
+            buffers.push_back(asio::buffer(_detached_written));
+        }
+
         _svc._replies.clear_fast_replies();
 
         _svc._stream.async_write(
@@ -10,6 +10,7 @@
 
 #include <boost/mqtt5/detail/async_mutex.hpp>
 #include <boost/mqtt5/detail/async_traits.hpp>
+#include <boost/mqtt5/detail/client_timer.hpp>
 #include <boost/mqtt5/detail/log_invoke.hpp>
 
 #include <boost/mqtt5/impl/endpoints.hpp>
@@ -36,11 +37,14 @@ using error_code = boost::system::error_code;
 template <
     typename StreamType,
     typename StreamContext = std::monostate,
-    typename LoggerType = noop_logger
+    typename LoggerType = noop_logger,
+    typename Allocator = std::allocator<void>
 >
 class autoconnect_stream {
 public:
-    using self_type = autoconnect_stream<StreamType, StreamContext, LoggerType>;
+    using self_type = autoconnect_stream<
+        StreamType, StreamContext, LoggerType, Allocator
+    >;
     using stream_type = StreamType;
     using stream_context_type = StreamContext;
     using logger_type = LoggerType;
@@ -49,8 +53,9 @@ private:
     using stream_ptr = std::shared_ptr<stream_type>;
 
     executor_type _stream_executor;
-    async_mutex _conn_mtx;
-    asio::steady_timer _read_timer, _connect_timer;
+    basic_async_mutex<Allocator> _conn_mtx;
+    client_timer _read_timer;
+    asio::steady_timer _connect_timer;
     endpoints<logger_type> _endpoints;
 
     stream_ptr _stream_ptr;
@@ -73,10 +78,10 @@ private:
 public:
     autoconnect_stream(
         const executor_type& ex, stream_context_type& context,
-        log_invoke<logger_type>& log
+        log_invoke<logger_type>& log, const Allocator& alloc = {}
     ) :
         _stream_executor(ex),
-        _conn_mtx(_stream_executor),
+        _conn_mtx(_stream_executor, alloc),
         _read_timer(_stream_executor), _connect_timer(_stream_executor),
         _endpoints(_stream_executor, _connect_timer, log),
         _stream_context(context),
@@ -109,6 +114,10 @@ public:
         _endpoints.clone_servers(other._endpoints);
     }
 
+    void use_timer_wheel(bool enable) {
+        _read_timer.use_wheel(enable);
+    }
+
     bool is_open() const noexcept {
         return lowest_layer(*_stream_ptr).is_open();
     }
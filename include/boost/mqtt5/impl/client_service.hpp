@@ -8,14 +8,18 @@
 #ifndef BOOST_MQTT5_CLIENT_SERVICE_HPP
 #define BOOST_MQTT5_CLIENT_SERVICE_HPP
 
+#include <boost/mqtt5/detail/async_traits.hpp>
 #include <boost/mqtt5/detail/channel_traits.hpp>
+#include <boost/mqtt5/detail/client_timer.hpp>
 #include <boost/mqtt5/detail/internal_types.hpp>
 #include <boost/mqtt5/detail/log_invoke.hpp>
+#include <boost/mqtt5/detail/request_coalescer.hpp>
 
 #include <boost/mqtt5/impl/assemble_op.hpp>
 #include <boost/mqtt5/impl/async_sender.hpp>
 #include <boost/mqtt5/impl/autoconnect_stream.hpp>
 #include <boost/mqtt5/impl/replies.hpp>
+#include <boost/mqtt5/impl/resubscribe_op.hpp>
 
 #include <boost/asio/async_result.hpp>
 #include <boost/asio/experimental/basic_channel.hpp>
@@ -26,6 +30,7 @@
 #include <memory>
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <variant> // std::monostate
 
 namespace boost::mqtt5::detail {
@@ -213,23 +218,38 @@ public:
 template <
     typename StreamType,
     typename TlsContext = std::monostate,
-    typename LoggerType = noop_logger
+    typename LoggerType = noop_logger,
+    typename Allocator = std::allocator<void>
 >
-class client_service {
-    using self_type = client_service<StreamType, TlsContext, LoggerType>;
+class client_service :
+    public std::enable_shared_from_this<
+        client_service<StreamType, TlsContext, LoggerType, Allocator>
+    >
+{
+    using self_type = client_service<StreamType, TlsContext, LoggerType, Allocator>;
     using stream_context_type = stream_context<StreamType, TlsContext>;
     using stream_type = autoconnect_stream<
-        StreamType, stream_context_type, LoggerType
+        StreamType, stream_context_type, LoggerType, Allocator
     >;
 public:
     using executor_type = typename stream_type::executor_type;
+    using allocator_type = Allocator;
+    using internal_allocator_type = internal_allocator_t<Allocator>;
 private:
     using tls_context_type = TlsContext;
     using logger_type = LoggerType;
+    using receive_signature =
+        void (error_code, std::string, std::string, publish_props);
+    using receive_view_signature = void (error_code, publish_view);
     using receive_channel = asio::experimental::basic_channel<
         executor_type,
-        channel_traits<>,
-        void (error_code, std::string, std::string, publish_props)
+        channel_traits<Allocator>,
+        receive_signature
+    >;
+    using receive_view_channel = asio::experimental::basic_channel<
+        executor_type,
+        channel_traits<Allocator>,
+        receive_view_signature
     >;
 
     template <typename ClientService, typename Handler>
@@ -251,6 +271,7 @@ private:
     friend class re_auth_op;
 
     executor_type _executor;
+    allocator_type _allocator;
 
     log_invoke<logger_type> _log;
 
@@ -258,54 +279,77 @@ private:
     stream_type _stream;
 
     packet_id_allocator _pid_allocator;
-    replies _replies;
+    replies<Allocator> _replies;
     async_sender<client_service> _async_sender;
 
-    std::string _read_buff;
+    request_coalescer<subscribe_traits> _subscribe_coalescer;
+    request_coalescer<unsubscribe_traits> _unsubscribe_coalescer;
+
+    std::shared_ptr<std::string> _read_buff;
     data_span _active_span;
 
+    bool _zero_copy_receive = false;
+    bool _low_footprint = false;
+    bool _resubscribe_pending = false;
     receive_channel _rec_channel;
+    receive_view_channel _rec_view_channel;
 
-    asio::steady_timer _ping_timer;
-    asio::steady_timer _sentry_timer;
+    client_timer _ping_timer;
 
     client_service(const client_service& other) :
         _executor(other._executor),
+        _allocator(other._allocator),
         _log(other._log),
         _stream_context(other._stream_context),
-        _stream(_executor, _stream_context, _log),
-        _replies(_executor),
+        _stream(_executor, _stream_context, _log, _allocator),
+        _replies(_executor, _allocator),
         _async_sender(*this),
-        _active_span(_read_buff.cend(), _read_buff.cend()),
+        _read_buff(std::make_shared<std::string>()),
+        _active_span(_read_buff->cend(), _read_buff->cend()),
+        _zero_copy_receive(other._zero_copy_receive),
         _rec_channel(_executor, (std::numeric_limits<size_t>::max)()),
-        _ping_timer(_executor),
-        _sentry_timer(_executor)
+        _rec_view_channel(_executor, (std::numeric_limits<size_t>::max)()),
+        _ping_timer(_executor)
     {
         _stream.clone_endpoints(other._stream);
+        coalesce_subscriptions(other._subscribe_coalescer.enabled());
+        low_footprint(other._low_footprint);
+        try_publish_buffer_size(other._async_sender.max_detached_size());
     }
 
 public:
 
     explicit client_service(
         const executor_type& ex,
-        tls_context_type tls_context = {}, logger_type logger = {}
+        tls_context_type tls_context = {}, logger_type logger = {},
+        const allocator_type& alloc = {}
     ) :
         _executor(ex),
+        _allocator(alloc),
         _log(std::move(logger)),
         _stream_context(std::move(tls_context)),
-        _stream(ex, _stream_context, _log),
-        _replies(ex),
+        _stream(ex, _stream_context, _log, _allocator),
+        _replies(ex, _allocator),
         _async_sender(*this),
-        _active_span(_read_buff.cend(), _read_buff.cend()),
+        _read_buff(std::make_shared<std::string>()),
+        _active_span(_read_buff->cend(), _read_buff->cend()),
         _rec_channel(ex, (std::numeric_limits<size_t>::max)()),
-        _ping_timer(ex),
-        _sentry_timer(ex)
+        _rec_view_channel(ex, (std::numeric_limits<size_t>::max)()),
+        _ping_timer(ex)
     {}
 
     executor_type get_executor() const noexcept {
         return _executor;
     }
 
+    allocator_type get_allocator() const noexcept {
+        return _allocator;
+    }
+
+    internal_allocator_type get_internal_allocator() const noexcept {
+        return internal_allocator(_allocator);
+    }
+
     auto dup() const {
         return std::shared_ptr<client_service>(new client_service(*this));
     }
@@ -350,6 +394,62 @@ public:
             );
     }
 
+    void zero_copy_receive(bool enable) {
+        if (!is_open())
+            _zero_copy_receive = enable;
+    }
+
+    bool zero_copy_receive() const {
+        return _zero_copy_receive;
+    }
+
+    void low_footprint(bool enable) {
+        if (is_open())
+            return;
+
+        _low_footprint = enable;
+        _ping_timer.use_wheel(enable);
+        _stream.use_timer_wheel(enable);
+    }
+
+    bool low_footprint() const {
+        return _low_footprint;
+    }
+
+    void try_publish_buffer_size(size_t bytes) {
+        if (!is_open())
+            _async_sender.max_detached_size(bytes);
+    }
+
+    void auto_topic_alias(bool enable) {
+        if (!is_open())
+            _stream_context.mqtt_context().outbound_aliases.enable(enable);
+    }
+
+    void coalesce_subscriptions(bool enable) {
+        if (!is_open()) {
+            _subscribe_coalescer.enable(enable);
+            _unsubscribe_coalescer.enable(enable);
+        }
+    }
+
+    bool coalesce_subscriptions() const {
+        return _subscribe_coalescer.enabled();
+    }
+
+    template <typename Traits>
+    auto& coalescer() {
+        if constexpr (std::is_same_v<Traits, subscribe_traits>)
+            return _subscribe_coalescer;
+        else
+            return _unsubscribe_coalescer;
+    }
+
+    void auto_resubscribe(bool enable) {
+        if (!is_open())
+            _stream_context.mqtt_context().subscriptions.enable(enable);
+    }
+
     uint16_t negotiated_keep_alive() const {
         return connack_property(prop::server_keep_alive)
             .value_or(_stream_context.mqtt_context().keep_alive);
@@ -409,9 +509,12 @@ public:
         if (!_stream.is_open()) return;
 
         _ping_timer.cancel();
-        _sentry_timer.cancel();
+        _replies.cancel_expired_wait();
 
         _rec_channel.close();
+        _rec_view_channel.close();
+        _subscribe_coalescer.cancel(_executor);
+        _unsubscribe_coalescer.cancel(_executor);
         _replies.cancel_unanswered();
         _async_sender.cancel();
         _stream.cancel();
@@ -426,6 +529,10 @@ public:
         return _pid_allocator.allocate();
     }
 
+    bool pid_exhausted() const noexcept {
+        return _pid_allocator.exhausted();
+    }
+
     void free_pid(uint16_t pid, bool was_throttled = false) {
         _pid_allocator.free(pid);
         if (was_throttled)
@@ -451,7 +558,11 @@ public:
             _replies.clear_pending_pubrels();
             session_state.session_present(true);
 
-            if (session_state.subscriptions_present()) {
+            // registered Subscriptions are re-subscribed
+            // once the write queue is being resent
+            if (!subscriptions().empty())
+                _resubscribe_pending = true;
+            else if (session_state.subscriptions_present()) {
                 channel_store_error(client::error::session_expired);
                 session_state.subscriptions_present(false);
             }
@@ -460,6 +571,19 @@ public:
         _ping_timer.cancel();
     }
 
+    void resubscribe() {
+        if (!std::exchange(_resubscribe_pending, false))
+            return;
+
+        auto max_packet_size = connack_property(prop::maximum_packet_size)
+            .value_or(default_max_send_size);
+        auto& registry = subscriptions();
+        for (auto& batch : registry.batches(max_packet_size))
+            resubscribe_op {
+                this->shared_from_this(), std::move(batch), registry.round()
+            }.perform();
+    }
+
     bool channel_store(decoders::publish_message message) {
         auto& [topic, packet_id, flags, props, payload] = message;
         return _rec_channel.try_send(
@@ -468,12 +592,42 @@ public:
         );
     }
 
+    bool channel_store(shared_publish_message message) {
+        auto& [topic, packet_id, flags, raw_props, payload, buffer, topic_buffer] =
+            message;
+        return _rec_view_channel.try_send(
+            error_code {},
+            publish_view {
+                std::move(buffer), topic, payload, raw_props,
+                std::move(topic_buffer)
+            }
+        );
+    }
+
     bool channel_store_error(error_code ec) {
+        if (_zero_copy_receive)
+            return _rec_view_channel.try_send(ec, publish_view {});
         return _rec_channel.try_send(
             ec, std::string {}, std::string {}, publish_props {}
         );
     }
 
+    std::shared_ptr<const std::string> read_buffer() const {
+        return _read_buff;
+    }
+
+    inbound_topic_aliases& inbound_aliases() {
+        return _stream_context.mqtt_context().inbound_aliases;
+    }
+
+    outbound_topic_aliases& outbound_aliases() {
+        return _stream_context.mqtt_context().outbound_aliases;
+    }
+
+    subscription_registry& subscriptions() {
+        return _stream_context.mqtt_context().subscriptions;
+    }
+
     template <typename BufferType, typename CompletionToken>
     decltype(auto) async_send(
         const BufferType& buffer,
@@ -485,13 +639,22 @@ public:
         );
     }
 
+    template <typename EncodeFun>
+    error_code write_detached(
+        EncodeFun&& encode, size_t max_size, bool aliased = false
+    ) {
+        return _async_sender.write_detached(
+            std::forward<EncodeFun>(encode), max_size, aliased
+        );
+    }
+
     template <typename CompletionToken>
     decltype(auto) async_assemble(CompletionToken&& token) {
         using Signature = void (error_code, uint8_t, byte_citer, byte_citer);
 
         auto initiation = [] (
             auto handler, self_type& self,
-            std::string& read_buff, data_span& active_span
+            std::shared_ptr<std::string>& read_buff, data_span& active_span
         ) {
             assemble_op {
                 self, std::move(handler), read_buff, active_span
@@ -515,9 +678,37 @@ public:
 
     template <typename CompletionToken>
     decltype(auto) async_channel_receive(CompletionToken&& token) {
-        return _rec_channel.async_receive(std::forward<CompletionToken>(token));
+        return async_receive_from<receive_signature>(
+            _rec_channel, std::forward<CompletionToken>(token)
+        );
     }
 
+    template <typename CompletionToken>
+    decltype(auto) async_channel_receive_view(CompletionToken&& token) {
+        return async_receive_from<receive_view_signature>(
+            _rec_view_channel, std::forward<CompletionToken>(token)
+        );
+    }
+
+private:
+    template <typename Signature, typename Channel, typename CompletionToken>
+    decltype(auto) async_receive_from(Channel& channel, CompletionToken&& token) {
+        if constexpr (is_default_allocator<Allocator>)
+            return channel.async_receive(std::forward<CompletionToken>(token));
+        else {
+            auto initiation = [](
+                auto handler, Channel& channel, const allocator_type& alloc
+            ) {
+                channel.async_receive(
+                    with_default_allocator(std::move(handler), alloc)
+                );
+            };
+
+            return asio::async_initiate<CompletionToken, Signature>(
+                initiation, token, std::ref(channel), _allocator
+            );
+        }
+    }
 };
 
 } // namespace boost::mqtt5::detail
@@ -0,0 +1,230 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MQTT5_COALESCE_OP_HPP
+#define BOOST_MQTT5_COALESCE_OP_HPP
+
+#include <boost/mqtt5/error.hpp>
+#include <boost/mqtt5/reason_codes.hpp>
+#include <boost/mqtt5/types.hpp>
+
+#include <boost/mqtt5/detail/control_packet.hpp>
+#include <boost/mqtt5/detail/internal_types.hpp>
+#include <boost/mqtt5/detail/request_coalescer.hpp>
+
+#include <boost/mqtt5/impl/disconnect_op.hpp>
+
+#include <boost/asio/detached.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/prepend.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace boost::mqtt5::detail {
+
+namespace asio = boost::asio;
+
+// Sends coalesced requests in a single SUBSCRIBE (or UNSUBSCRIBE) packet
+// and hands each request its share of the Reason Codes in the reply.
+template <typename ClientService, typename Traits>
+class coalesce_op {
+    using client_service = ClientService;
+    using request = typename request_coalescer<Traits>::request;
+
+    struct on_request {};
+    struct on_reply {};
+
+    std::shared_ptr<client_service> _svc_ptr;
+    std::vector<request> _requests;
+
+public:
+    coalesce_op(
+        std::shared_ptr<client_service> svc_ptr,
+        std::vector<request> requests
+    ) :
+        _svc_ptr(std::move(svc_ptr)), _requests(std::move(requests))
+    {}
+
+    coalesce_op(coalesce_op&&) noexcept = default;
+    coalesce_op(const coalesce_op&) = delete;
+
+    coalesce_op& operator=(coalesce_op&&) noexcept = default;
+    coalesce_op& operator=(const coalesce_op&) = delete;
+
+    using allocator_type = typename client_service::internal_allocator_type;
+    allocator_type get_allocator() const noexcept {
+        return _svc_ptr->get_internal_allocator();
+    }
+
+    using executor_type = typename client_service::executor_type;
+    executor_type get_executor() const noexcept {
+        return _svc_ptr->get_executor();
+    }
+
+    void perform() {
+        uint16_t packet_id = _svc_ptr->allocate_pid();
+        if (packet_id == 0)
+            return complete(client::error::pid_overrun, packet_id);
+
+        std::vector<typename Traits::topic_type> topics;
+        for (const auto& req : _requests)
+            topics.insert(topics.end(), req.topics.begin(), req.topics.end());
+
+        auto packet = control_packet::of(
+            with_pid, Traits::encode, packet_id,
+            topics, _requests.front().props
+        );
+
+        auto max_packet_size = _svc_ptr->connack_property(prop::maximum_packet_size)
+                .value_or(default_max_send_size);
+        if (packet.size() > max_packet_size)
+            return complete(client::error::packet_too_large, packet_id);
+
+        send_request(std::move(packet));
+    }
+
+    void send_request(control_packet packet) {
+        auto wire_data = packet.wire_data();
+        _svc_ptr->async_send(
+            wire_data,
+            no_serial, send_flag::none,
+            asio::prepend(std::move(*this), on_request {}, std::move(packet))
+        );
+    }
+
+    void operator()(
+        on_request, control_packet packet,
+        error_code ec
+    ) {
+        if (ec == asio::error::try_again)
+            return send_request(std::move(packet));
+
+        auto packet_id = packet.packet_id();
+
+        if (ec)
+            return complete(ec, packet_id);
+
+        _svc_ptr->async_wait_reply(
+            Traits::ack_code, packet_id,
+            asio::prepend(std::move(*this), on_reply {}, std::move(packet))
+        );
+    }
+
+    void operator()(
+        on_reply, control_packet packet,
+        error_code ec, byte_citer first, byte_citer last
+    ) {
+        if (ec == asio::error::try_again) // "resend unanswered"
+            return send_request(std::move(packet));
+
+        uint16_t packet_id = packet.packet_id();
+
+        if (ec)
+            return complete(ec, packet_id);
+
+        auto reply = Traits::decode_ack(
+            static_cast<uint32_t>(std::distance(first, last)), first
+        );
+        if (!reply.has_value()) {
+            on_malformed_packet(
+                std::string("Malformed ") + Traits::ack_name + ": cannot decode"
+            );
+            return send_request(std::move(packet));
+        }
+
+        auto& [props, rcs] = *reply;
+        if (!valid_reason_codes(rcs)) {
+            on_malformed_packet(
+                std::string("Malformed ") + Traits::ack_name +
+                ": does not contain a valid Reason Code for every Topic Filter"
+            );
+            return send_request(std::move(packet));
+        }
+
+        _svc_ptr->free_pid(packet_id);
+
+        auto rc_it = rcs.cbegin();
+        for (auto& req : _requests) {
+            auto rc_end = rc_it + req.topics.size();
+            std::move(req.handler)(
+                error_code {}, std::vector<uint8_t>(rc_it, rc_end), props
+            );
+            rc_it = rc_end;
+        }
+    }
+
+private:
+    bool valid_reason_codes(const std::vector<uint8_t>& rcs) const {
+        size_t num_topics = 0;
+        for (const auto& req : _requests)
+            num_topics += req.topics.size();
+        if (rcs.size() != num_topics)
+            return false;
+
+        return std::all_of(
+            rcs.begin(), rcs.end(),
+            [](uint8_t code) {
+                return to_reason_code<Traits::ack_category>(code).has_value();
+            }
+        );
+    }
+
+    void on_malformed_packet(const std::string& reason) {
+        auto props = disconnect_props {};
+        props[prop::reason_string] = reason;
+        async_disconnect(
+            disconnect_rc_e::malformed_packet, props, _svc_ptr,
+            asio::detached
+        );
+    }
+
+    void complete(error_code ec, uint16_t packet_id) {
+        if (packet_id != 0)
+            _svc_ptr->free_pid(packet_id);
+        for (auto& req : _requests)
+            std::move(req.handler)(
+                ec, std::vector<uint8_t> {}, typename Traits::ack_props_type {}
+            );
+    }
+};
+
+template <typename Traits, typename ClientService>
+void flush_coalesced(const std::shared_ptr<ClientService>& svc_ptr) {
+    auto max_packet_size = svc_ptr->connack_property(prop::maximum_packet_size)
+        .value_or(default_max_send_size);
+    auto& coalescer = svc_ptr->template coalescer<Traits>();
+    for (auto& requests : coalescer.take(max_packet_size))
+        coalesce_op<ClientService, Traits> {
+            svc_ptr, std::move(requests)
+        }.perform();
+}
+
+// Requests issued in the same executor turn are sent together.
+template <typename Traits, typename ClientService, typename Handler>
+void coalesce_request(
+    const std::shared_ptr<ClientService>& svc_ptr,
+    const std::vector<typename Traits::topic_type>& topics,
+    const typename Traits::props_type& props,
+    Handler&& handler
+) {
+    auto& coalescer = svc_ptr->template coalescer<Traits>();
+    bool first = coalescer.add({ topics, props, std::forward<Handler>(handler) });
+    if (first)
+        asio::post(
+            svc_ptr->get_executor(),
+            [svc_ptr] { flush_coalesced<Traits>(svc_ptr); }
+        );
+}
+
+} // end namespace boost::mqtt5::detail
+
+#endif // !BOOST_MQTT5_COALESCE_OP_HPP
@@ -19,7 +19,10 @@
 #include <boost/spirit/home/x3/binary/binary.hpp>
 
 #include <cstdint>
+#include <iterator>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 
 namespace boost::mqtt5::decoders {
@@ -293,6 +296,60 @@ struct len_prefix_parser : x3::parser<len_prefix_parser> {
 constexpr len_prefix_parser utf8_ {};
 constexpr len_prefix_parser binary_ {};
 
+/*
+    View parsers do not copy the parsed bytes, they produce a std::string_view
+    into the parsed range. The range must outlive the produced view.
+*/
+
+template <typename It>
+std::string_view make_view(It first, size_t len) {
+    if (len == 0)
+        return std::string_view {};
+    return std::string_view { std::addressof(*first), len };
+}
+
+struct verbatim_view_parser : x3::parser<verbatim_view_parser> {
+    using attribute_type = std::string_view;
+    static bool const has_attribute = true;
+
+    template <typename It, typename Ctx, typename RCtx, typename Attr>
+    bool parse(It& first, const It last, const Ctx&, RCtx&, Attr& attr) const {
+        attr = make_view(first, static_cast<size_t>(std::distance(first, last)));
+        first = last;
+        return true;
+    }
+};
+
+constexpr auto verbatim_view_ = verbatim_view_parser {};
+
+struct len_prefix_view_parser : x3::parser<len_prefix_view_parser> {
+    using attribute_type = std::string_view;
+    static bool const has_attribute = true;
+
+    template <typename It, typename Ctx, typename RCtx, typename Attr>
+    bool parse(
+        It& first, const It last,
+        const Ctx& ctx, RCtx& rctx, Attr& attr
+    ) const {
+        It iter = first;
+        x3::skip_over(iter, last, ctx);
+
+        typename x3::traits::attribute_of<decltype(x3::big_word), Ctx>::type len;
+        if (x3::big_word.parse(iter, last, ctx, rctx, len)) {
+            if (std::distance(iter, last) < len)
+                return false;
+        }
+        else
+            return false;
+
+        attr = make_view(iter, len);
+        first = iter + len;
+        return true;
+    }
+};
+
+constexpr len_prefix_view_parser utf8_view_ {};
+
 /*
      Boost Spirit incorrectly deduces atribute type for a parser of the form
          (eps(a) | parser1) >> (eps(b) | parser)
@@ -419,9 +476,17 @@ public:
         if (iter == last)
             return true;
 
+        // most packets carry no properties: a single zero Property Length
+        if (*iter == 0) {
+            first = ++iter;
+            return true;
+        }
+
         int32_t props_length;
         if (!basic::varint_.parse(iter, last, ctx, rctx, props_length))
             return false;
+        if (std::distance(iter, last) < props_length)
+            return false;
 
         const It scoped_last = iter + props_length;
         // attr = Props{};
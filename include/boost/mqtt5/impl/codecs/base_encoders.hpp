@@ -452,27 +452,35 @@ class props_val : public basic::encoder {
 
     decltype(to_prop_vals(std::declval<Props>())) _prop_vals;
     bool _may_omit;
+    // computed once, as the size is needed several times per packet
+    size_t _props_size;
 
 public:
     props_val(Props val, bool may_omit) :
-        _prop_vals(to_prop_vals(val)), _may_omit(may_omit)
+        _prop_vals(to_prop_vals(val)), _may_omit(may_omit),
+        _props_size(props_size())
     {
         static_assert(std::is_reference_v<Props>);
     }
     props_val(bool may_omit) :
-        _prop_vals(to_prop_vals(nulltype)), _may_omit(may_omit)
+        _prop_vals(to_prop_vals(nulltype)), _may_omit(may_omit),
+        _props_size(0)
     {}
 
     size_t byte_size() const {
-        size_t psize = props_size();
-        if (_may_omit && psize == 0) return 0;
-        return psize + basic::varlen_(psize).byte_size();
+        if (_props_size == 0)
+            return _may_omit ? 0 : 1;
+        return _props_size + basic::varlen_(_props_size).byte_size();
     }
 
     std::string& encode(std::string& s) const {
-        size_t psize = props_size();
-        if (_may_omit && psize == 0) return s;
-        basic::varlen_(psize).encode(s);
+        if (_props_size == 0) {
+            // most packets carry no properties: a single zero Property Length
+            if (!_may_omit)
+                s.push_back(0);
+            return s;
+        }
+        basic::varlen_(_props_size).encode(s);
         apply_each([&s](const auto& pv) { return pv.encode(s); });
         return s;
     }
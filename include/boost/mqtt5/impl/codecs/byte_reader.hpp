@@ -0,0 +1,227 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MQTT5_BYTE_READER_HPP
+#define BOOST_MQTT5_BYTE_READER_HPP
+
+#include <boost/mqtt5/property_types.hpp>
+
+#include <boost/mqtt5/detail/traits.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace boost::mqtt5::decoders {
+
+/*
+    Bounds-checked reads of the MQTT data types from [first, last).
+
+    Used by the hand-written decoders of the packets on the receive path
+    (PUBLISH and acknowledgements), which behave exactly as the equivalent
+    Spirit X3 grammars, and by the reads of encoded PUBLISH properties.
+    Every read either succeeds and advances the position or fails
+    and leaves the position unchanged.
+*/
+template <typename Iterator>
+class basic_byte_reader {
+    Iterator _it {};
+    Iterator _last {};
+
+public:
+    basic_byte_reader() = default;
+
+    basic_byte_reader(Iterator first, Iterator last) :
+        _it(first), _last(last)
+    {}
+
+    Iterator position() const noexcept {
+        return _it;
+    }
+
+    size_t remaining() const noexcept {
+        return static_cast<size_t>(std::distance(_it, _last));
+    }
+
+    bool at_end() const noexcept {
+        return _it == _last;
+    }
+
+    bool read(uint8_t& val) {
+        if (at_end())
+            return false;
+        val = uint8_t(*_it++);
+        return true;
+    }
+
+    bool read(uint16_t& val) {
+        if (remaining() < 2)
+            return false;
+        val = uint16_t((uint8_t(_it[0]) << 8) | uint8_t(_it[1]));
+        _it += 2;
+        return true;
+    }
+
+    bool read(uint32_t& val) {
+        if (remaining() < 4)
+            return false;
+        val = (uint32_t(uint8_t(_it[0])) << 24) | (uint32_t(uint8_t(_it[1])) << 16) |
+            (uint32_t(uint8_t(_it[2])) << 8) | uint32_t(uint8_t(_it[3]));
+        _it += 4;
+        return true;
+    }
+
+    // Variable Byte Integer
+    bool read(int32_t& val) {
+        int32_t result = 0;
+        auto it = _it;
+        for (unsigned shift = 0; shift < 4 * 7; shift += 7) {
+            if (it == _last)
+                return false;
+            auto byte = uint8_t(*it++);
+            result |= int32_t(byte & 0b0111'1111) << shift;
+            if (!(byte & 0b1000'0000)) {
+                val = result;
+                _it = it;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // UTF-8 Encoded String or Binary Data
+    bool read(std::string_view& val) {
+        uint16_t len;
+        auto it = _it;
+        if (!read(len))
+            return false;
+        if (remaining() < len) {
+            _it = it;
+            return false;
+        }
+        val = view(len);
+        return true;
+    }
+
+    bool read(std::string& val) {
+        std::string_view v;
+        if (!read(v))
+            return false;
+        val.assign(v.data(), v.size());
+        return true;
+    }
+
+    // Rest of the bytes.
+    std::string_view read_rest() {
+        return view(remaining());
+    }
+
+    // Properties, preceded by their Property Length. A missing
+    // Property Length is read as an empty set of properties.
+    template <typename Props>
+    bool read_props(Props& props) {
+        if (at_end())
+            return true;
+
+        // most packets carry no properties: a single zero Property Length
+        if (*_it == 0) {
+            ++_it;
+            return true;
+        }
+
+        auto it = _it;
+        int32_t props_length;
+        if (!read(props_length) || remaining() < size_t(props_length)) {
+            _it = it;
+            return false;
+        }
+
+        basic_byte_reader scoped(_it, _it + props_length);
+        while (!scoped.at_end()) {
+            uint8_t prop_id;
+            scoped.read(prop_id);
+
+            bool rv = false;
+            bool unknown = props.apply_on(
+                prop_id,
+                [&rv, &scoped](auto& prop) { rv = scoped.read_prop(prop); }
+            );
+            if (unknown || !rv) {
+                _it = it;
+                return false;
+            }
+        }
+
+        _it = scoped._it;
+        return true;
+    }
+
+    // Properties in their encoded form, without the Property Length.
+    bool read_raw_props(std::string_view& raw) {
+        raw = {};
+        if (at_end())
+            return true;
+
+        auto it = _it;
+        int32_t props_length;
+        if (!read(props_length) || remaining() < size_t(props_length)) {
+            _it = it;
+            return false;
+        }
+
+        raw = view(size_t(props_length));
+        return true;
+    }
+
+private:
+    std::string_view view(size_t len) {
+        std::string_view v;
+        if (len != 0)
+            v = std::string_view { std::addressof(*_it), len };
+        _it += len;
+        return v;
+    }
+
+    template <typename T>
+    bool read_prop(T& prop) {
+        if constexpr (detail::is_optional<T>) {
+            typename T::value_type val;
+            if (!read_prop(val))
+                return false;
+            prop.emplace(std::move(val));
+            return true;
+        }
+        else if constexpr (detail::is_pair<T>) {
+            auto it = _it;
+            if (read_prop(prop.first) && read_prop(prop.second))
+                return true;
+            _it = it;
+            return false;
+        }
+        else if constexpr (detail::is_vector<T> || detail::is_small_vector<T>) {
+            typename T::value_type val;
+            if (!read_prop(val))
+                return false;
+            prop.push_back(std::move(val));
+            return true;
+        }
+        else
+            return read(prop);
+    }
+};
+
+// Reads the packets the Client receives.
+using byte_reader = basic_byte_reader<std::string::const_iterator>;
+
+} // end namespace boost::mqtt5::decoders
+
+#endif // !BOOST_MQTT5_BYTE_READER_HPP
@@ -11,12 +11,16 @@
 #include <boost/mqtt5/types.hpp>
 
 #include <boost/mqtt5/detail/internal_types.hpp>
+#include <boost/mqtt5/detail/raw_props.hpp>
 
 #include <boost/mqtt5/impl/codecs/base_decoders.hpp>
+#include <boost/mqtt5/impl/codecs/byte_reader.hpp>
 
 #include <cstdint>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -39,10 +43,14 @@ inline std::optional<fixed_header> decode_fixed_header(
 using packet_id = uint16_t;
 
 inline std::optional<packet_id> decode_packet_id(
-    byte_citer& it
+    byte_citer& it, byte_citer last
 ) {
-    auto packet_id_ = x3::big_word;
-    return type_parse(it, it + sizeof(uint16_t), packet_id_);
+    byte_reader reader(it, last);
+    packet_id id;
+    if (!reader.read(id))
+        return std::nullopt;
+    it = reader.position();
+    return id;
 }
 
 using connect_message = std::tuple<
@@ -130,6 +138,12 @@ inline std::optional<connack_message> decode_connack(
     return type_parse(it, it + remain_length, connack_);
 }
 
+/*
+    PUBLISH packets and acknowledgements are decoded by hand, as they make up
+    most of the traffic. The decoders accept exactly what the equivalent
+    Spirit X3 grammars accept.
+*/
+
 using publish_message = std::tuple<
     std::string, // topic
     std::optional<uint16_t>, // packet_id
@@ -138,17 +152,124 @@ using publish_message = std::tuple<
     std::string // payload
 >;
 
-inline std::optional<publish_message> decode_publish(
+using publish_message_view = std::tuple<
+    std::string_view, // topic
+    std::optional<uint16_t>, // packet_id
+    uint8_t, // dup_e, qos_e, retain_e
+    publish_props, // publish props
+    std::string_view // payload
+>;
+
+// Topic and payload refer to the bytes in [it, it + remain_length).
+inline std::optional<publish_message_view> decode_publish_view(
     uint8_t control_byte, uint32_t remain_length, byte_citer& it
 ) {
     uint8_t flags = control_byte & 0b1111;
     auto qos = qos_e((flags >> 1) & 0b11);
 
-    auto publish_ = basic::scope_limit_(remain_length)[
-        basic::utf8_ >> basic::if_(qos != qos_e::at_most_once)[x3::big_word] >>
-            x3::attr(flags) >> prop::props_<publish_props> >> basic::verbatim_
-    ];
-    return type_parse(it, it + remain_length, publish_);
+    byte_reader reader(it, it + remain_length);
+    publish_message_view msg;
+    auto& [topic, packet_id, msg_flags, props, payload] = msg;
+
+    if (!reader.read(topic))
+        return std::nullopt;
+
+    if (qos != qos_e::at_most_once) {
+        uint16_t id;
+        if (!reader.read(id))
+            return std::nullopt;
+        packet_id = id;
+    }
+
+    msg_flags = flags;
+    if (!reader.read_props(props))
+        return std::nullopt;
+
+    payload = reader.read_rest();
+    it = reader.position();
+    return msg;
+}
+
+using publish_message_raw_props = std::tuple<
+    std::string_view, // topic
+    std::optional<uint16_t>, // packet_id
+    uint8_t, // dup_e, qos_e, retain_e
+    std::string_view, // encoded publish props
+    std::optional<uint16_t>, // topic alias
+    std::string_view // payload
+>;
+
+// As decode_publish_view, but the properties are only checked and left
+// encoded. The Topic Alias is extracted, as it is needed to deliver the message.
+inline std::optional<publish_message_raw_props> decode_publish_raw_props(
+    uint8_t control_byte, uint32_t remain_length, byte_citer& it
+) {
+    uint8_t flags = control_byte & 0b1111;
+    auto qos = qos_e((flags >> 1) & 0b11);
+
+    byte_reader reader(it, it + remain_length);
+    publish_message_raw_props msg;
+    auto& [topic, packet_id, msg_flags, raw_props, topic_alias, payload] = msg;
+
+    if (!reader.read(topic))
+        return std::nullopt;
+
+    if (qos != qos_e::at_most_once) {
+        uint16_t id;
+        if (!reader.read(id))
+            return std::nullopt;
+        packet_id = id;
+    }
+
+    msg_flags = flags;
+    if (!reader.read_raw_props(raw_props))
+        return std::nullopt;
+
+    detail::raw_publish_props props(raw_props);
+    detail::raw_property p;
+    while (!props.at_end()) {
+        if (!props.next(p))
+            return std::nullopt;
+        if (p.id == boost::mqtt5::prop::topic_alias_t)
+            topic_alias = uint16_t(p.number);
+    }
+
+    payload = reader.read_rest();
+    it = reader.position();
+    return msg;
+}
+
+inline std::optional<publish_message> decode_publish(
+    uint8_t control_byte, uint32_t remain_length, byte_citer& it
+) {
+    auto view = decode_publish_view(control_byte, remain_length, it);
+    if (!view)
+        return std::nullopt;
+
+    auto& [topic, packet_id, flags, props, payload] = *view;
+    return publish_message {
+        std::string(topic), packet_id, flags,
+        std::move(props), std::string(payload)
+    };
+}
+
+// Reason Code and properties of PUBACK, PUBREC, PUBREL and PUBCOMP packets,
+// both of which may be omitted.
+template <typename Props>
+std::optional<std::tuple<uint8_t, Props>> decode_ack(
+    uint32_t remain_length, byte_citer& it
+) {
+    std::tuple<uint8_t, Props> msg {};
+    if (remain_length == 0)
+        return msg;
+
+    auto& [reason_code, props] = msg;
+    byte_reader reader(it, it + remain_length);
+    if (!reader.read(reason_code) || !reader.read_props(props))
+        return std::nullopt;
+
+    it = reader.position();
+    return msg;
 }
 
 using puback_message = std::tuple<
@@ -159,12 +280,7 @@ using puback_message = std::tuple<
 inline std::optional<puback_message> decode_puback(
     uint32_t remain_length, byte_citer& it
 ) {
-    if (remain_length == 0)
-        return puback_message {};
-    auto puback_ = basic::scope_limit_(remain_length)[
-        x3::byte_ >> prop::props_<puback_props>
-    ];
-    return type_parse(it, it + remain_length, puback_);
+    return decode_ack<puback_props>(remain_length, it);
 }
 
 using pubrec_message = std::tuple<
@@ -175,12 +291,7 @@ using pubrec_message = std::tuple<
 inline std::optional<pubrec_message> decode_pubrec(
     uint32_t remain_length, byte_citer& it
 ) {
-    if (remain_length == 0)
-        return pubrec_message {};
-    auto pubrec_ = basic::scope_limit_(remain_length)[
-        x3::byte_ >> prop::props_<pubrec_props>
-    ];
-    return type_parse(it, it + remain_length, pubrec_);
+    return decode_ack<pubrec_props>(remain_length, it);
 }
 
 using pubrel_message = std::tuple<
@@ -191,12 +302,7 @@ using pubrel_message = std::tuple<
 inline std::optional<pubrel_message> decode_pubrel(
     uint32_t remain_length, byte_citer& it
 ) {
-    if (remain_length == 0)
-        return pubrel_message {};
-    auto pubrel_ = basic::scope_limit_(remain_length)[
-        x3::byte_ >> prop::props_<pubrel_props>
-    ];
-    return type_parse(it, it + remain_length, pubrel_);
+    return decode_ack<pubrel_props>(remain_length, it);
 }
 
 using pubcomp_message = std::tuple<
@@ -207,12 +313,7 @@ using pubcomp_message = std::tuple<
 inline std::optional<pubcomp_message> decode_pubcomp(
     uint32_t remain_length, byte_citer& it
 ) {
-    if (remain_length == 0)
-        return pubcomp_message {};
-    auto pubcomp_ = basic::scope_limit_(remain_length)[
-        x3::byte_ >> prop::props_<pubcomp_props>
-    ];
-    return type_parse(it, it + remain_length, pubcomp_);
+    return decode_ack<pubcomp_props>(remain_length, it);
 }
 
 using subscribe_message = std::tuple<
@@ -10,8 +10,12 @@
 
 #include <boost/mqtt5/types.hpp>
 
+#include <boost/mqtt5/detail/packet_buffers.hpp>
+
 #include <boost/mqtt5/impl/codecs/base_encoders.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -20,14 +24,24 @@
 
 namespace boost::mqtt5::encoders {
 
+// payload_size is the size of the payload to be appended afterwards
 template <typename encoder>
-std::string encode(const encoder& e) {
-    std::string s;
-    s.reserve(e.byte_size());
+std::string encode(const encoder& e, size_t payload_size = 0) {
+    auto s = detail::packet_buffers::acquire(e.byte_size() + payload_size);
     s << e;
     return s;
 }
 
+// Appends the encoded packet to s and returns the size of the packet.
+template <typename encoder>
+size_t encode_to(std::string& s, const encoder& e) {
+    auto size = e.byte_size();
+    if (s.capacity() - s.size() < size)
+        s.reserve((std::max)(s.size() + size, 2 * s.capacity()));
+    s << e;
+    return size;
+}
+
 inline std::string encode_connect(
     std::string_view client_id,
     std::optional<std::string_view> user_name,
@@ -100,7 +114,9 @@ inline std::string encode_connack(
     return encode(connack_message_);
 }
 
-inline std::string encode_publish(
+// Appends the PUBLISH packet to s and returns the size of the packet.
+inline size_t encode_publish_to(
+    std::string& s,
     uint16_t packet_id,
     std::string_view topic_name,
     std::string_view payload,
@@ -130,7 +146,72 @@ inline std::string encode_publish(
 
     auto publish_message_ = fixed_header_ & message_body_;
 
-    return encode(publish_message_);
+    return encode_to(s, publish_message_);
+}
+
+inline std::string encode_publish(
+    uint16_t packet_id,
+    std::string_view topic_name,
+    std::string_view payload,
+    qos_e qos, retain_e retain, dup_e dup,
+    const publish_props& props
+) {
+    auto s = detail::packet_buffers::acquire(0);
+    encode_publish_to(s, packet_id, topic_name, payload, qos, retain, dup, props);
+    return s;
+}
+
+// Returns the Topic Name followed by the properties of a PUBLISH packet.
+// The Packet Identifier goes in between, at 2 + topic_name.size().
+inline std::string encode_publish_template(
+    std::string_view topic_name, const publish_props& props
+) {
+    auto template_ = basic::utf8_(topic_name) & prop::props_(props);
+    return encode(template_);
+}
+
+// Appends the PUBLISH packet built from the template to s
+// and returns the size of the packet.
+inline size_t encode_templated_publish_to(
+    std::string& s,
+    uint16_t packet_id,
+    const publish_template& tmpl,
+    std::string_view payload,
+    qos_e qos, retain_e retain, dup_e dup
+) {
+    std::optional<uint16_t> used_packet_id;
+    if (qos != qos_e::at_most_once) used_packet_id.emplace(packet_id);
+
+    auto packet_type_ =
+        basic::flag<4>(0b0011) |
+        basic::flag<1>(dup) |
+        basic::flag<2>(qos) |
+        basic::flag<1>(retain);
+
+    auto message_body_ =
+        basic::verbatim_(tmpl.encoded_topic()) &
+        basic::int16_(used_packet_id) &
+        basic::verbatim_(tmpl.encoded_props()) &
+        basic::verbatim_(payload);
+
+    auto fixed_header_ =
+        packet_type_ &
+        basic::varlen_(message_body_.byte_size());
+
+    auto publish_message_ = fixed_header_ & message_body_;
+
+    return encode_to(s, publish_message_);
+}
+
+inline std::string encode_templated_publish(
+    uint16_t packet_id,
+    const publish_template& tmpl,
+    std::string_view payload,
+    qos_e qos, retain_e retain, dup_e dup
+) {
+    auto s = detail::packet_buffers::acquire(0);
+    encode_templated_publish_to(s, packet_id, tmpl, payload, qos, retain, dup);
+    return s;
 }
 
 inline std::string encode_puback(
@@ -252,8 +333,7 @@ inline std::string encode_subscribe(
         basic::varlen_(var_header_.byte_size()  + payload_size) &
         var_header_;
 
-    auto s = encode(message_);
-    s.reserve(s.size() + payload_size);
+    auto s = encode(message_, payload_size);
 
     for (const auto& [topic_filter, sub_opts]: topics) {
         auto opts_ =
@@ -287,8 +367,7 @@ inline std::string encode_suback(
         basic::varlen_(var_header_.byte_size()  + reason_codes.size()) &
         var_header_;
 
-    auto s = encode(message_);
-    s.reserve(s.size() + reason_codes.size());
+    auto s = encode(message_, reason_codes.size());
 
     for (auto reason_code: reason_codes)
         s << basic::byte_(reason_code);
@@ -319,8 +398,7 @@ inline std::string encode_unsubscribe(
         basic::varlen_(var_header_.byte_size()  + payload_size) &
         var_header_;
 
-    auto s = encode(message_);
-    s.reserve(s.size() + payload_size);
+    auto s = encode(message_, payload_size);
 
     for (const auto& topic: topics)
         s << basic::utf8_(topic);
@@ -347,8 +425,7 @@ inline std::string encode_unsuback(
         basic::varlen_(var_header_.byte_size()  + reason_codes.size()) &
         var_header_;
 
-    auto s = encode(message_);
-    s.reserve(s.size() + reason_codes.size());
+    auto s = encode(message_, reason_codes.size());
 
     for (auto reason_code: reason_codes)
         s << basic::byte_(reason_code);
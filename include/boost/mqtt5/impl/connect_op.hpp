@@ -38,6 +38,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <utility>
 
 namespace boost::mqtt5::detail {
 
@@ -215,9 +216,8 @@ public:
     }
 
     void send_connect() {
-        auto packet = control_packet<allocator_type>::of(
-            no_pid, get_allocator(),
-            encoders::encode_connect,
+        auto packet = control_packet::of(
+            no_pid, encoders::encode_connect,
             _ctx.creds.client_id,
             _ctx.creds.username, _ctx.creds.password,
             _ctx.keep_alive, false, _ctx.co_props, _ctx.will_msg
@@ -305,7 +305,7 @@ public:
         if (code == control_code_e::connack)
             return on_connack(first, last);
 
-        if (!_ctx.co_props[prop::authentication_method].has_value())
+        if (!std::as_const(_ctx.co_props)[prop::authentication_method].has_value())
             return do_shutdown(client::error::malformed_packet);
 
         on_auth(first, last);
@@ -321,6 +321,14 @@ public:
         _ctx.ca_props = ca_props;
         _ctx.state.session_present(session_present);
 
+        // Topic Alias mappings do not survive the Network Connection.
+        _ctx.inbound_aliases.reset(
+            std::as_const(_ctx.co_props)[prop::topic_alias_maximum].value_or(0)
+        );
+        _ctx.outbound_aliases.reset(
+            ca_props[prop::topic_alias_maximum].value_or(0)
+        );
+
         //  Unexpected result handling:
         //  - If we don't have a Session State, and we get session_present = true,
         //      we must close the network connection (and restart with a clean start)
@@ -335,7 +343,7 @@ public:
         if (*rc)
             return do_shutdown(asio::error::try_again);
 
-        if (_ctx.co_props[prop::authentication_method].has_value())
+        if (std::as_const(_ctx.co_props)[prop::authentication_method].has_value())
             return _ctx.authenticator.async_auth(
                 auth_step_e::server_final,
                 ca_props[prop::authentication_data].value_or(""),
@@ -356,7 +364,7 @@ public:
         if (
             !rc.has_value() ||
             auth_props[prop::authentication_method]
-                != _ctx.co_props[prop::authentication_method]
+                != std::as_const(_ctx.co_props)[prop::authentication_method]
         )
             return do_shutdown(client::error::malformed_packet);
 
@@ -376,12 +384,11 @@ public:
 
         auth_props props;
         props[prop::authentication_method] =
-            _ctx.co_props[prop::authentication_method];
+            std::as_const(_ctx.co_props)[prop::authentication_method];
         props[prop::authentication_data] = std::move(data);
 
-        auto packet = control_packet<allocator_type>::of(
-            no_pid, get_allocator(),
-            encoders::encode_auth,
+        auto packet = control_packet::of(
+            no_pid, encoders::encode_auth,
             reason_codes::continue_authentication.value(), props
         );
 
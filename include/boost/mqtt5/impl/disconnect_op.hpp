@@ -93,9 +93,8 @@ public:
         if (ec)
             return complete_immediate(ec);
 
-        auto disconnect = control_packet<allocator_type>::of(
-            no_pid, get_allocator(),
-            encoders::encode_disconnect,
+        auto disconnect = control_packet::of(
+            no_pid, encoders::encode_disconnect,
             static_cast<uint8_t>(_context.reason_code), _context.props
         );
 
@@ -103,16 +102,15 @@ public:
                 .value_or(default_max_send_size);
         if (disconnect.size() > max_packet_size)
             // drop properties
-            return send_disconnect(control_packet<allocator_type>::of(
-                no_pid, get_allocator(),
-                encoders::encode_disconnect,
+            return send_disconnect(control_packet::of(
+                no_pid, encoders::encode_disconnect,
                 static_cast<uint8_t>(_context.reason_code), disconnect_props {}
             ));
 
         send_disconnect(std::move(disconnect));
     }
 
-    void send_disconnect(control_packet<allocator_type> disconnect) {
+    void send_disconnect(control_packet disconnect) {
         auto wire_data = disconnect.wire_data();
         _svc_ptr->async_send(
             wire_data,
@@ -126,7 +124,7 @@ public:
 
     void operator()(
         on_disconnect,
-        control_packet<allocator_type> disconnect, error_code ec
+        control_packet disconnect, error_code ec
     ) {
         // The connection must be closed even
         // if we failed to send the DISCONNECT packet
@@ -278,11 +276,14 @@ public:
         disconnect_rc_e rc, const disconnect_props& props
     ) {
         auto ctx = disconnect_ctx { rc, props, terminal };
+        auto h = with_default_allocator(
+            std::forward<Handler>(handler), _svc_ptr->get_allocator()
+        );
         if constexpr (terminal)
-            terminal_disconnect_op { _svc_ptr, std::move(handler) }
+            terminal_disconnect_op { _svc_ptr, std::move(h) }
                 .perform(std::move(ctx));
         else
-            disconnect_op { _svc_ptr, std::move(ctx), std::move(handler) }
+            disconnect_op { _svc_ptr, std::move(ctx), std::move(h) }
                 .perform();
     }
 };
@@ -11,14 +11,13 @@
 #include <boost/mqtt5/detail/control_packet.hpp>
 #include <boost/mqtt5/detail/internal_types.hpp>
 
-#include <boost/mqtt5/impl/codecs/message_encoders.hpp>
-
-#include <boost/asio/consign.hpp>
+#include <boost/asio/associated_allocator.hpp>
 #include <boost/asio/error.hpp>
 #include <boost/asio/prepend.hpp>
 
 #include <chrono>
 #include <limits>
+#include <memory>
 
 namespace boost::mqtt5::detail {
 
@@ -69,18 +68,11 @@ public:
         else if (ec == asio::error::operation_aborted)
             return perform();
 
-        auto pingreq = control_packet<allocator_type>::of(
-            no_pid, get_allocator(), encoders::encode_pingreq
-        );
-
-        auto wire_data = pingreq.wire_data();
+        auto pingreq = short_packet::pingreq();
         _svc_ptr->async_send(
-            wire_data,
+            pingreq.wire_data(),
             no_serial, send_flag::none,
-            asio::consign(
-                asio::prepend(std::move(*this), on_pingreq {}),
-                std::move(pingreq)
-            )
+            asio::prepend(std::move(*this), on_pingreq {})
         );
     }
 
@@ -17,13 +17,10 @@
 #include <boost/mqtt5/detail/internal_types.hpp>
 
 #include <boost/mqtt5/impl/codecs/message_decoders.hpp>
-#include <boost/mqtt5/impl/codecs/message_encoders.hpp>
 #include <boost/mqtt5/impl/disconnect_op.hpp>
 
-#include <boost/asio/consign.hpp>
 #include <boost/asio/detached.hpp>
 #include <boost/asio/prepend.hpp>
-#include <boost/asio/recycling_allocator.hpp>
 
 #include <cstdint>
 #include <memory>
@@ -33,9 +30,13 @@ namespace boost::mqtt5::detail {
 
 namespace asio = boost::asio;
 
-template <typename ClientService>
+template <
+    typename ClientService,
+    typename Message = decoders::publish_message
+>
 class publish_rec_op {
     using client_service = ClientService;
+    using message_type = Message;
 
     struct on_puback {};
     struct on_pubrec {};
@@ -43,7 +44,7 @@ class publish_rec_op {
     struct on_pubcomp {};
 
     std::shared_ptr<client_service> _svc_ptr;
-    decoders::publish_message _message;
+    message_type _message;
 
 public:
     explicit publish_rec_op(std::shared_ptr<client_service> svc_ptr) :
@@ -56,9 +57,9 @@ public:
     publish_rec_op& operator=(publish_rec_op&&) noexcept = default;
     publish_rec_op& operator=(const publish_rec_op&) = delete;
 
-    using allocator_type = asio::recycling_allocator<void>;
+    using allocator_type = typename client_service::internal_allocator_type;
     allocator_type get_allocator() const noexcept {
-        return allocator_type {};
+        return _svc_ptr->get_internal_allocator();
     }
 
     using executor_type = typename client_service::executor_type;
@@ -66,7 +67,7 @@ public:
         return _svc_ptr->get_executor();
     }
 
-    void perform(decoders::publish_message message) {
+    void perform(message_type message) {
         auto flags = std::get<2>(message);
         auto qos_bits = (flags >> 1) & 0b11;
         if (qos_bits == 0b11)
@@ -82,34 +83,19 @@ public:
 
         auto packet_id = std::get<1>(_message);
 
-        if (qos == qos_e::at_least_once) {
-            auto puback = control_packet<allocator_type>::of(
-                with_pid, get_allocator(),
-                encoders::encode_puback, *packet_id,
-                uint8_t(0), puback_props {}
-            );
-            return send_puback(std::move(puback));
-        }
+        if (qos == qos_e::at_least_once)
+            return send_puback(*packet_id);
 
         // qos == qos_e::exactly_once
-        auto pubrec = control_packet<allocator_type>::of(
-            with_pid, get_allocator(),
-            encoders::encode_pubrec, *packet_id,
-            uint8_t(0), pubrec_props {}
-        );
-
-        return send_pubrec(std::move(pubrec));
+        return send_pubrec(*packet_id);
     }
 
-    void send_puback(control_packet<allocator_type> puback) {
-        auto wire_data = puback.wire_data();
+    void send_puback(uint16_t packet_id) {
+        auto puback = short_packet::ack(control_code_e::puback, packet_id);
         _svc_ptr->async_send(
-            wire_data,
+            puback.wire_data(),
             no_serial, send_flag::none,
-            asio::consign(
-                asio::prepend(std::move(*this), on_puback {}),
-                std::move(puback)
-            )
+            asio::prepend(std::move(*this), on_puback {})
         );
     }
 
@@ -120,23 +106,20 @@ public:
         complete();
     }
 
-    void send_pubrec(control_packet<allocator_type> pubrec) {
-        auto wire_data = pubrec.wire_data();
+    void send_pubrec(uint16_t packet_id) {
+        auto pubrec = short_packet::ack(control_code_e::pubrec, packet_id);
         _svc_ptr->async_send(
-            wire_data,
+            pubrec.wire_data(),
             no_serial, send_flag::none,
-            asio::prepend(std::move(*this), on_pubrec {}, std::move(pubrec))
+            asio::prepend(std::move(*this), on_pubrec {}, packet_id)
         );
     }
 
-    void operator()(
-        on_pubrec, control_packet<allocator_type> packet,
-        error_code ec
-    ) {
+    void operator()(on_pubrec, uint16_t packet_id, error_code ec) {
         if (ec)
             return;
 
-        wait_pubrel(packet.packet_id());
+        wait_pubrel(packet_id);
     }
 
     void wait_pubrel(uint16_t packet_id) {
@@ -169,29 +152,21 @@ public:
             return wait_pubrel(packet_id);
         }
 
-        auto pubcomp = control_packet<allocator_type>::of(
-            with_pid, get_allocator(),
-            encoders::encode_pubcomp, packet_id,
-            uint8_t(0), pubcomp_props{}
-        );
-        send_pubcomp(std::move(pubcomp));
+        send_pubcomp(packet_id);
     }
 
-    void send_pubcomp(control_packet<allocator_type> pubcomp) {
-        auto wire_data = pubcomp.wire_data();
+    void send_pubcomp(uint16_t packet_id) {
+        auto pubcomp = short_packet::ack(control_code_e::pubcomp, packet_id);
         _svc_ptr->async_send(
-            wire_data,
+            pubcomp.wire_data(),
             no_serial, send_flag::none,
-            asio::prepend(std::move(*this), on_pubcomp {}, std::move(pubcomp))
+            asio::prepend(std::move(*this), on_pubcomp {}, packet_id)
         );
     }
 
-    void operator()(
-        on_pubcomp, control_packet<allocator_type> packet,
-        error_code ec
-    ) {
+    void operator()(on_pubcomp, uint16_t packet_id, error_code ec) {
         if (ec == asio::error::try_again)
-            return wait_pubrel(packet.packet_id());
+            return wait_pubrel(packet_id);
 
         if (ec)
             return;
@@ -15,6 +15,7 @@
 #include <boost/mqtt5/detail/cancellable_handler.hpp>
 #include <boost/mqtt5/detail/control_packet.hpp>
 #include <boost/mqtt5/detail/internal_types.hpp>
+#include <boost/mqtt5/detail/topic_aliases.hpp>
 #include <boost/mqtt5/detail/topic_validation.hpp>
 #include <boost/mqtt5/detail/utf8_mqtt.hpp>
 
@@ -32,6 +33,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 namespace boost::mqtt5::detail {
@@ -60,6 +62,144 @@ using on_publish_props_type = std::conditional_t<
         >
 >;
 
+// Validates the properties that do not depend on the Broker.
+inline error_code validate_publish_props(const publish_props& props) {
+    const auto& response_topic = props[prop::response_topic];
+    if (
+        response_topic &&
+        validate_topic_name(*response_topic) != validation_result::valid
+    )
+        return client::error::malformed_packet;
+
+    const auto& user_properties = props[prop::user_property];
+    for (const auto& user_property: user_properties)
+        if (!is_valid_string_pair(user_property))
+            return client::error::malformed_packet;
+
+    if (!props[prop::subscription_identifier].empty())
+        return client::error::malformed_packet;
+
+    const auto& content_type = props[prop::content_type];
+    if (
+        content_type &&
+        validate_mqtt_utf8(*content_type) != validation_result::valid
+    )
+        return client::error::malformed_packet;
+
+    return error_code {};
+}
+
+template <typename ClientService>
+error_code validate_publish_props(
+    const ClientService& svc, const publish_props& props
+) {
+    constexpr uint16_t default_topic_alias_max = 0;
+
+    const auto& topic_alias = props[prop::topic_alias];
+    if (topic_alias) {
+        auto topic_alias_max = svc.connack_property(prop::topic_alias_maximum)
+            .value_or(default_topic_alias_max);
+
+        if (topic_alias_max == 0 || *topic_alias > topic_alias_max)
+            return client::error::topic_alias_maximum_reached;
+        if (*topic_alias == 0 )
+            return client::error::malformed_packet;
+    }
+
+    return validate_publish_props(props);
+}
+
+template <qos_e qos_type, typename ClientService>
+error_code validate_publish_flags(const ClientService& svc, retain_e retain) {
+    constexpr uint8_t default_retain_available = 1;
+    constexpr uint8_t default_maximum_qos = 2;
+
+    auto max_qos = svc.connack_property(prop::maximum_qos)
+        .value_or(default_maximum_qos);
+    auto retain_available = svc.connack_property(prop::retain_available)
+        .value_or(default_retain_available);
+
+    if (uint8_t(qos_type) > max_qos)
+        return client::error::qos_not_supported;
+
+    if (retain_available == 0 && retain == retain_e::yes)
+        return client::error::retain_not_available;
+
+    return error_code {};
+}
+
+template <qos_e qos_type, typename ClientService>
+error_code validate_publish(
+    const ClientService& svc,
+    std::string_view topic, std::string_view payload,
+    retain_e retain, const publish_props& props,
+    bool topic_validated = false
+) {
+    constexpr uint8_t default_payload_format_ind = 0;
+
+    // a publish_topic is a valid Topic Name, with or without a Topic Alias
+    auto topic_name_valid = topic_validated || (
+        props[prop::topic_alias].has_value() ?
+            validate_topic_alias_name(topic) == validation_result::valid :
+            validate_topic_name(topic) == validation_result::valid
+    );
+
+    if (!topic_name_valid)
+        return client::error::invalid_topic;
+
+    if (auto ec = validate_publish_flags<qos_type>(svc, retain))
+        return ec;
+
+    auto payload_format_ind = props[prop::payload_format_indicator]
+        .value_or(default_payload_format_ind);
+    if (
+        payload_format_ind == 1 &&
+        validate_mqtt_utf8(payload) != validation_result::valid
+    )
+        return client::error::malformed_packet;
+
+    return validate_publish_props(svc, props);
+}
+
+template <qos_e qos_type, typename ClientService>
+error_code validate_publish(
+    const ClientService& svc, const publish_template& tmpl,
+    std::string_view payload, retain_e retain
+) {
+    if (tmpl.empty())
+        return client::error::invalid_topic;
+
+    if (auto ec = validate_publish_flags<qos_type>(svc, retain))
+        return ec;
+
+    if (
+        tmpl.utf8_payload() &&
+        validate_mqtt_utf8(payload) != validation_result::valid
+    )
+        return client::error::malformed_packet;
+
+    return error_code {};
+}
+
+// Returns an empty template if the Topic Name or the properties are not valid.
+// Topic Aliases are tied to the Network Connection and cannot be templated.
+inline publish_template make_publish_template(
+    std::string_view topic, const publish_props& props
+) {
+    if (
+        validate_topic_name(topic) != validation_result::valid ||
+        props[prop::topic_alias].has_value() ||
+        validate_publish_props(props)
+    )
+        return publish_template {};
+
+    return publish_template {
+        encoders::encode_publish_template(topic, props),
+        sizeof(uint16_t) + topic.size(),
+        props[prop::payload_format_indicator].value_or(0) == 1
+    };
+}
+
 template <typename ClientService, typename Handler, qos_e qos_type>
 class publish_send_op {
     using client_service = ClientService;
@@ -80,6 +220,10 @@ class publish_send_op {
 
     serial_num_t _serial_num;
 
+    using alias_assignment = outbound_topic_aliases::assignment;
+    alias_assignment _alias;
+    bool _alias_unwritten { false };
+
 public:
     publish_send_op(
         std::shared_ptr<client_service> svc_ptr,
@@ -112,8 +256,50 @@ public:
     }
 
     void perform(
-        std::string topic, std::string payload,
-        retain_e retain, const publish_props& props
+        std::string_view topic, std::string_view payload,
+        retain_e retain, const publish_props& props,
+        bool topic_validated = false
+    ) {
+        uint16_t packet_id = 0;
+        if constexpr (qos_type != qos_e::at_most_once) {
+            packet_id = _svc_ptr->allocate_pid();
+            if (packet_id == 0)
+                return complete_immediate(client::error::pid_overrun, packet_id);
+        }
+
+        auto ec = validate_publish<qos_type>(
+            *_svc_ptr, topic, payload, retain, props, topic_validated
+        );
+        if (ec)
+            return complete_immediate(ec, packet_id);
+
+        _serial_num = _svc_ptr->next_serial_num();
+
+        if (!props[prop::topic_alias].has_value()) {
+            _alias = _svc_ptr->outbound_aliases().acquire(topic);
+            _alias_unwritten = _alias.alias != 0;
+        }
+
+        auto publish = _alias.alias ?
+            encode_aliased_publish(packet_id, topic, payload, retain, props) :
+            control_packet::of(
+                with_pid, encoders::encode_publish, packet_id,
+                topic, payload,
+                qos_type, retain, dup_e::no, props
+            );
+
+        auto max_packet_size = _svc_ptr->connack_property(prop::maximum_packet_size)
+                .value_or(default_max_send_size);
+        if (publish.size() > max_packet_size) {
+            release_alias(false);
+            return complete_immediate(client::error::packet_too_large, packet_id);
+        }
+
+        send_publish(std::move(publish));
+    }
+
+    void perform(
+        const publish_template& tmpl, std::string_view payload, retain_e retain
     ) {
         uint16_t packet_id = 0;
         if constexpr (qos_type != qos_e::at_most_once) {
@@ -122,17 +308,15 @@ public:
                 return complete_immediate(client::error::pid_overrun, packet_id);
         }
 
-        auto ec = validate_publish(topic, payload, retain, props);
+        auto ec = validate_publish<qos_type>(*_svc_ptr, tmpl, payload, retain);
         if (ec)
             return complete_immediate(ec, packet_id);
 
         _serial_num = _svc_ptr->next_serial_num();
 
-        auto publish = control_packet<allocator_type>::of(
-            with_pid, get_allocator(),
-            encoders::encode_publish, packet_id,
-            std::move(topic), std::move(payload),
-            qos_type, retain, dup_e::no, props
+        auto publish = control_packet::of(
+            with_pid, encoders::encode_templated_publish, packet_id,
+            tmpl, payload, qos_type, retain, dup_e::no
         );
 
         auto max_packet_size = _svc_ptr->connack_property(prop::maximum_packet_size)
@@ -143,7 +327,7 @@ public:
         send_publish(std::move(publish));
     }
 
-    void send_publish(control_packet<allocator_type> publish) {
+    void send_publish(control_packet publish) {
         auto wire_data = publish.wire_data();
         _svc_ptr->async_send(
             wire_data,
@@ -153,18 +337,28 @@ public:
         );
     }
 
-    void resend_publish(control_packet<allocator_type> publish) {
+    void resend_publish(control_packet publish) {
         if (_handler.cancelled() != asio::cancellation_type_t::none)
             return complete(
                 asio::error::operation_aborted, publish.packet_id()
             );
+
+        // Topic Aliases do not survive the Network Connection.
+        if (
+            _alias.alias &&
+            _alias.generation != _svc_ptr->outbound_aliases().generation()
+        )
+            publish = without_topic_alias(publish);
+
         send_publish(std::move(publish));
     }
 
     void operator()(
-        on_publish, control_packet<allocator_type> publish,
+        on_publish, control_packet publish,
         error_code ec
     ) {
+        release_alias(!ec);
+
         if (ec == asio::error::try_again)
             return resend_publish(std::move(publish));
 
@@ -201,7 +395,7 @@ public:
         std::enable_if_t<q == qos_e::at_least_once, bool> = true
     >
     void operator()(
-        on_puback, control_packet<allocator_type> publish,
+        on_puback, control_packet publish,
         error_code ec, byte_citer first, byte_citer last
     ) {
         if (ec == asio::error::try_again) // "resend unanswered"
@@ -235,7 +429,7 @@ public:
         std::enable_if_t<q == qos_e::exactly_once, bool> = true
     >
     void operator()(
-        on_pubrec, control_packet<allocator_type> publish,
+        on_pubrec, control_packet publish,
         error_code ec, byte_citer first, byte_citer last
     ) {
         if (ec == asio::error::try_again) // "resend unanswered"
@@ -265,16 +459,10 @@ public:
         if (*rc)
             return complete(ec, packet_id, *rc);
 
-        auto pubrel = control_packet<allocator_type>::of(
-            with_pid, get_allocator(),
-            encoders::encode_pubrel, packet_id,
-            0, pubrel_props {}
-        );
-
-        send_pubrel(std::move(pubrel), false);
+        send_pubrel(short_packet::ack(control_code_e::pubrel, packet_id), false);
     }
 
-    void send_pubrel(control_packet<allocator_type> pubrel, bool throttled) {
+    void send_pubrel(short_packet pubrel, bool throttled) {
         auto wire_data = pubrel.wire_data();
         _svc_ptr->async_send(
             wire_data,
@@ -289,7 +477,7 @@ public:
         std::enable_if_t<q == qos_e::exactly_once, bool> = true
     >
     void operator()(
-        on_pubrel, control_packet<allocator_type> pubrel, error_code ec
+        on_pubrel, short_packet pubrel, error_code ec
     ) {
         if (ec == asio::error::try_again)
             return send_pubrel(std::move(pubrel), true);
@@ -310,7 +498,7 @@ public:
         std::enable_if_t<q == qos_e::exactly_once, bool> = true
     >
     void operator()(
-        on_pubcomp, control_packet<allocator_type> pubrel,
+        on_pubcomp, short_packet pubrel,
         error_code ec,
         byte_citer first, byte_citer last
     ) {
@@ -343,81 +531,47 @@ public:
 
 private:
 
-    error_code validate_publish(
-        const std::string& topic, const std::string& payload,
+    control_packet encode_aliased_publish(
+        uint16_t packet_id, std::string_view topic, std::string_view payload,
         retain_e retain, const publish_props& props
-    ) const {
-        constexpr uint8_t default_retain_available = 1;
-        constexpr uint8_t default_maximum_qos = 2;
-        constexpr uint8_t default_payload_format_ind = 0;
-
-        auto topic_name_valid = props[prop::topic_alias].has_value() ?
-            validate_topic_alias_name(topic) == validation_result::valid :
-            validate_topic_name(topic) == validation_result::valid
-        ;
-
-        if (!topic_name_valid)
-            return client::error::invalid_topic;
-
-        auto max_qos = _svc_ptr->connack_property(prop::maximum_qos)
-            .value_or(default_maximum_qos);
-        auto retain_available = _svc_ptr->connack_property(prop::retain_available)
-            .value_or(default_retain_available);
-
-        if (uint8_t(qos_type) > max_qos)
-            return client::error::qos_not_supported;
-
-        if (retain_available == 0 && retain == retain_e::yes)
-            return client::error::retain_not_available;
-
-        auto payload_format_ind = props[prop::payload_format_indicator]
-            .value_or(default_payload_format_ind);
-        if (
-            payload_format_ind == 1 &&
-            validate_mqtt_utf8(payload) != validation_result::valid
-        )
-            return client::error::malformed_packet;
+    ) {
+        auto aliased_props = props;
+        aliased_props[prop::topic_alias] = _alias.alias;
 
-        return validate_props(props);
+        return control_packet::of(
+            with_pid, encoders::encode_publish, packet_id,
+            _alias.alias_only ? std::string_view {} : topic,
+            payload, qos_type, retain, dup_e::no, aliased_props
+        );
     }
 
-    error_code validate_props(const publish_props& props) const {
-        constexpr uint16_t default_topic_alias_max = 0;
-
-        const auto& topic_alias = props[prop::topic_alias];
-        if (topic_alias) {
-            auto topic_alias_max = _svc_ptr->connack_property(prop::topic_alias_maximum)
-                .value_or(default_topic_alias_max);
-
-            if (topic_alias_max == 0 || *topic_alias > topic_alias_max)
-                return client::error::topic_alias_maximum_reached;
-            if (*topic_alias == 0 )
-                return client::error::malformed_packet;
-        }
-
-        const auto& response_topic = props[prop::response_topic];
-        if (
-            response_topic &&
-            validate_topic_name(*response_topic) != validation_result::valid
-        )
-            return client::error::malformed_packet;
-
-        const auto& user_properties = props[prop::user_property];
-        for (const auto& user_property: user_properties)
-            if (!is_valid_string_pair(user_property))
-                return client::error::malformed_packet;
-
-        if (!props[prop::subscription_identifier].empty())
-            return client::error::malformed_packet;
-
-        const auto& content_type = props[prop::content_type];
-        if (
-            content_type &&
-            validate_mqtt_utf8(*content_type) != validation_result::valid
-        )
-            return client::error::malformed_packet;
+    // Rebuilds the PUBLISH packet with the full Topic and without the Topic Alias.
+    control_packet without_topic_alias(
+        const control_packet& publish
+    ) {
+        const std::string packet { publish.wire_data() };
+        auto it = packet.cbegin();
+        auto header = decoders::decode_fixed_header(it, packet.cend());
+        auto& [control_byte, remain_length] = *header;
+        auto msg = decoders::decode_publish(control_byte, remain_length, it);
+        auto& [topic, packet_id, flags, props, payload] = *msg;
+        props[prop::topic_alias].reset();
+
+        auto full_topic = std::move(_alias.topic);
+        _alias = alias_assignment {};
+
+        return control_packet::of(
+            with_pid, encoders::encode_publish, publish.packet_id(),
+            *full_topic, payload,
+            qos_type, retain_e(flags & 0b1), dup_e((flags >> 3) & 0b1), props
+        );
+    }
 
-        return error_code {};
+    void release_alias(bool written) {
+        if (!_alias_unwritten)
+            return;
+        _svc_ptr->outbound_aliases().release(_alias, written);
+        _alias_unwritten = false;
     }
 
     void on_malformed_packet(const std::string& reason) {
@@ -495,14 +649,95 @@ public:
         std::string topic, std::string payload,
         retain_e retain, const publish_props& props
     ) {
-        detail::publish_send_op<ClientService, Handler, qos_type> {
-            _svc_ptr, std::move(handler) 
+        auto h = with_default_allocator(
+            std::forward<Handler>(handler), _svc_ptr->get_allocator()
+        );
+        detail::publish_send_op<ClientService, decltype(h), qos_type> {
+            _svc_ptr, std::move(h)
         }.perform(
-            std::move(topic), std::move(payload), retain, props
+            topic, payload, retain, props
         );
     }
+
+    template <typename Handler>
+    void operator()(
+        Handler&& handler,
+        publish_topic topic, std::string payload,
+        retain_e retain, const publish_props& props
+    ) {
+        auto h = with_default_allocator(
+            std::forward<Handler>(handler), _svc_ptr->get_allocator()
+        );
+        detail::publish_send_op<ClientService, decltype(h), qos_type> {
+            _svc_ptr, std::move(h)
+        }.perform(
+            topic.name(), payload, retain, props, !topic.empty()
+        );
+    }
+
+    template <typename Handler>
+    void operator()(
+        Handler&& handler,
+        publish_template tmpl, std::string payload, retain_e retain
+    ) {
+        auto h = with_default_allocator(
+            std::forward<Handler>(handler), _svc_ptr->get_allocator()
+        );
+        detail::publish_send_op<ClientService, decltype(h), qos_type> {
+            _svc_ptr, std::move(h)
+        }.perform(tmpl, payload, retain);
+    }
 };
 
+// Encodes a QoS 0 PUBLISH packet straight into the output of the next
+// write. There is no completion handler, so there is nothing to allocate.
+template <typename ClientService>
+error_code publish_detached(
+    ClientService& svc,
+    std::string_view topic, std::string_view payload,
+    retain_e retain, const publish_props& props,
+    bool topic_validated = false
+) {
+    auto ec = validate_publish<qos_e::at_most_once>(
+        svc, topic, payload, retain, props, topic_validated
+    );
+    if (ec)
+        return ec;
+
+    auto max_packet_size = svc.connack_property(prop::maximum_packet_size)
+        .value_or(default_max_send_size);
+    return svc.write_detached(
+        [&](std::string& out) {
+            return encoders::encode_publish_to(
+                out, 0, topic, payload,
+                qos_e::at_most_once, retain, dup_e::no, props
+            );
+        },
+        max_packet_size, props[prop::topic_alias].has_value()
+    );
+}
+
+template <typename ClientService>
+error_code publish_detached(
+    ClientService& svc, const publish_template& tmpl,
+    std::string_view payload, retain_e retain
+) {
+    auto ec = validate_publish<qos_e::at_most_once>(svc, tmpl, payload, retain);
+    if (ec)
+        return ec;
+
+    auto max_packet_size = svc.connack_property(prop::maximum_packet_size)
+        .value_or(default_max_send_size);
+    return svc.write_detached(
+        [&](std::string& out) {
+            return encoders::encode_templated_publish_to(
+                out, 0, tmpl, payload, qos_e::at_most_once, retain, dup_e::no
+            );
+        },
+        max_packet_size
+    );
+}
+
 } // end namespace boost::mqtt5::detail
 
 #endif // !BOOST_MQTT5_PUBLISH_SEND_OP_HPP
@@ -21,7 +21,6 @@
 
 #include <boost/asio/detached.hpp>
 #include <boost/asio/prepend.hpp>
-#include <boost/asio/recycling_allocator.hpp>
 
 #include <memory>
 #include <string>
@@ -50,9 +49,9 @@ public:
     re_auth_op& operator=(re_auth_op&&) noexcept = default;
     re_auth_op& operator=(const re_auth_op&) = delete;
 
-    using allocator_type = asio::recycling_allocator<void>;
+    using allocator_type = typename client_service::internal_allocator_type;
     allocator_type get_allocator() const noexcept {
-        return allocator_type {};
+        return _svc_ptr->get_internal_allocator();
     }
 
     using executor_type = typename client_service::executor_type;
@@ -121,9 +120,8 @@ public:
         auto rc = auth_step == auth_step_e::client_initial ?
             reason_codes::reauthenticate : reason_codes::continue_authentication;
 
-        auto packet = control_packet<allocator_type>::of(
-            no_pid, get_allocator(),
-            encoders::encode_auth,
+        auto packet = control_packet::of(
+            no_pid, encoders::encode_auth,
             rc.value(), props
         );
 
@@ -25,6 +25,9 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
 
 namespace boost::mqtt5::detail {
 
@@ -103,6 +106,9 @@ private:
 
         switch (code) {
             case control_code_e::publish: {
+                if (_svc_ptr->zero_copy_receive())
+                    return dispatch_publish_view(control_byte, first, last);
+
                 auto msg = decoders::decode_publish(
                     control_byte, static_cast<uint32_t>(std::distance(first, last)), first
                 );
@@ -111,6 +117,15 @@ private:
                         "Malformed PUBLISH received: cannot decode"
                     );
 
+                auto& [topic, packet_id, flags, props, payload] = *msg;
+                std::string_view resolved = topic;
+                std::shared_ptr<const std::string> topic_buffer;
+                const auto& topic_alias = std::as_const(props)[prop::topic_alias];
+                if (!resolve_topic_alias(resolved, topic_alias, topic_buffer))
+                    return;
+                if (topic_buffer)
+                    topic = *topic_buffer;
+
                 publish_rec_op { _svc_ptr }.perform(std::move(*msg));
             }
             break;
@@ -153,13 +168,82 @@ private:
         perform();
     }
 
+    void dispatch_publish_view(
+        uint8_t control_byte,
+        byte_citer first, byte_citer last
+    ) {
+        // the properties are decoded only when the application asks for them
+        auto msg = decoders::decode_publish_raw_props(
+            control_byte, static_cast<uint32_t>(std::distance(first, last)), first
+        );
+        if (!msg.has_value())
+            return on_malformed_packet(
+                "Malformed PUBLISH received: cannot decode"
+            );
+
+        auto& [topic, packet_id, flags, raw_props, topic_alias, payload] = *msg;
+        std::shared_ptr<const std::string> topic_buffer;
+        if (!resolve_topic_alias(topic, topic_alias, topic_buffer))
+            return;
+
+        publish_rec_op<client_service, shared_publish_message> { _svc_ptr }
+            .perform({
+                topic, packet_id, flags, raw_props, payload,
+                _svc_ptr->read_buffer(), std::move(topic_buffer)
+            });
+
+        perform();
+    }
+
+    // Maps the Topic Alias of a received PUBLISH packet, or replaces an empty
+    // Topic with the one mapped to the alias. Aliases are resolved only
+    // if the Client allowed them with the Topic Alias Maximum in CONNECT.
+    // Returns false if the packet was rejected with a DISCONNECT.
+    bool resolve_topic_alias(
+        std::string_view& topic, const std::optional<uint16_t>& alias,
+        std::shared_ptr<const std::string>& topic_buffer
+    ) {
+        auto& aliases = _svc_ptr->inbound_aliases();
+        if (!alias || aliases.max() == 0)
+            return true;
+
+        if (!aliases.valid(*alias)) {
+            on_protocol_violation(
+                disconnect_rc_e::topic_alias_invalid,
+                "PUBLISH received with an invalid Topic Alias"
+            );
+            return false;
+        }
+
+        if (!topic.empty()) {
+            aliases.insert(*alias, topic);
+            return true;
+        }
+
+        topic_buffer = aliases.find(*alias);
+        if (!topic_buffer) {
+            on_protocol_violation(
+                disconnect_rc_e::protocol_error,
+                "PUBLISH received with an unmapped Topic Alias"
+            );
+            return false;
+        }
+
+        topic = *topic_buffer;
+        return true;
+    }
+
     void on_malformed_packet(const std::string& reason) {
+        on_protocol_violation(disconnect_rc_e::malformed_packet, reason);
+    }
+
+    void on_protocol_violation(disconnect_rc_e rc, const std::string& reason) {
         auto props = disconnect_props {};
         props[prop::reason_string] = reason;
         auto svc_ptr = _svc_ptr; // copy before this is moved
 
         async_disconnect(
-            disconnect_rc_e::malformed_packet, props, svc_ptr,
+            rc, props, svc_ptr,
             asio::prepend(std::move(*this), on_disconnect {})
         );
     }
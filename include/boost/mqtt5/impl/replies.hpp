@@ -12,6 +12,7 @@
 
 #include <boost/mqtt5/detail/control_packet.hpp>
 #include <boost/mqtt5/detail/internal_types.hpp>
+#include <boost/mqtt5/detail/timer_wheel.hpp>
 
 #include <boost/asio/any_completion_handler.hpp>
 #include <boost/asio/any_io_executor.hpp>
@@ -19,107 +20,129 @@
 #include <boost/asio/consign.hpp>
 #include <boost/asio/dispatch.hpp>
 #include <boost/asio/error.hpp>
+#include <boost/asio/execution.hpp>
+#include <boost/asio/execution_context.hpp>
 #include <boost/asio/post.hpp>
 #include <boost/asio/prepend.hpp>
+#include <boost/asio/query.hpp>
 
 #include <algorithm>
 #include <chrono>
 #include <cstdint>
+#include <functional>
+#include <iterator>
+#include <list>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace boost::mqtt5::detail {
 
 namespace asio = boost::asio;
 
+template <typename Allocator = std::allocator<void>>
 class replies {
 public:
     using executor_type = asio::any_io_executor;
+    using allocator_type = Allocator;
 private:
+    template <typename T>
+    using rebind_alloc =
+        typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
     using Signature = void (error_code, byte_citer, byte_citer);
+    using handler_type = asio::any_completion_handler<Signature>;
 
     static constexpr auto max_reply_time = std::chrono::seconds(20);
 
-    class reply_handler {
-        asio::any_completion_handler<Signature> _handler;
-        control_code_e _code;
-        uint16_t _packet_id;
-        std::chrono::time_point<std::chrono::system_clock> _ts;
+    // A reply being waited for, and its deadline in the timer wheel.
+    // The deadline is linked into the wheel by address, so nodes are
+    // kept in lists and recycled instead of being moved or freed.
+    struct reply_handler {
+        handler_type handler;
+        control_code_e code = control_code_e::no_packet;
+        uint16_t packet_id = 0;
+        uint64_t serial = 0;
+        timer_wheel::entry deadline;
+    };
+
+    // Invoked by the timer wheel when the deadline of a reply expires.
+    // The reply may have been received (and its node reused) after
+    // the deadline expired, but before this handler ran.
+    class on_deadline {
+        std::weak_ptr<replies*> _self;
+        reply_handler* _reply;
+        uint64_t _serial;
     public:
-        template <typename H>
-        reply_handler(control_code_e code, uint16_t pid, H&& handler) :
-            _handler(std::forward<H>(handler)), _code(code), _packet_id(pid),
-            _ts(std::chrono::system_clock::now())
+        on_deadline(std::weak_ptr<replies*> self, reply_handler& reply) :
+            _self(std::move(self)), _reply(&reply), _serial(reply.serial)
         {}
 
-        reply_handler(reply_handler&&) = default;
-        reply_handler(const reply_handler&) = delete;
-
-        reply_handler& operator=(reply_handler&&) = default;
-        reply_handler& operator=(const reply_handler&) = delete;
-
-        void complete(
-            error_code ec,
-            byte_citer first = byte_citer {}, byte_citer last = byte_citer {}
-        ) {
-            std::move(_handler)(ec, first, last);
-        }
-
-        void complete_post(const executor_type& ex, error_code ec) {
-            asio::post(
-                ex,
-                asio::prepend(
-                    std::move(_handler), ec, byte_citer {}, byte_citer {}
-                )
-            );
-        }
-
-        uint16_t packet_id() const noexcept {
-            return _packet_id;
-        }
-
-        control_code_e code() const noexcept {
-            return _code;
-        }
-
-        auto time() const noexcept {
-            return _ts;
+        void operator()(error_code ec) {
+            auto self = _self.lock();
+            if (ec || !self || _reply->serial != _serial || !_reply->handler)
+                return;
+            (*self)->on_reply_expired(*_reply);
         }
     };
 
     executor_type _ex;
+    timer_wheel& _wheel;
+    std::shared_ptr<replies*> _self;
 
-    using handlers = std::vector<reply_handler>;
+    using handlers = std::list<reply_handler, rebind_alloc<reply_handler>>;
     handlers _handlers;
+    handlers _free_handlers;
+    uint64_t _serial = 0;
 
+    asio::any_completion_handler<void (error_code)> _expired_handler;
+
+    // The copy of the reply is a std::string, because the handlers
+    // take its bytes as byte_citer. See the allocators documentation.
     struct fast_reply {
         control_code_e code;
         uint16_t packet_id;
         std::unique_ptr<std::string> packet;
     };
-    using fast_replies = std::vector<fast_reply>;
+    using fast_replies = std::vector<fast_reply, rebind_alloc<fast_reply>>;
     fast_replies _fast_replies;
 
 public:
     template <typename Executor>
-    explicit replies(Executor ex) : _ex(std::move(ex)) {}
-
-    replies(replies&&) = default;
+    explicit replies(Executor ex, const Allocator& alloc = {}) :
+        _ex(std::move(ex)),
+        _wheel(asio::use_service<timer_wheel>(
+            asio::query(_ex, asio::execution::context)
+        )),
+        _self(std::allocate_shared<replies*>(rebind_alloc<replies*>(alloc), this)),
+        _handlers(rebind_alloc<reply_handler>(alloc)),
+        _free_handlers(rebind_alloc<reply_handler>(alloc)),
+        _fast_replies(rebind_alloc<fast_reply>(alloc))
+    {}
+
+    // the deadlines refer to this object
+    replies(replies&&) = delete;
     replies(const replies&) = delete;
 
-    replies& operator=(replies&&) = default;
+    replies& operator=(replies&&) = delete;
     replies& operator=(const replies&) = delete;
 
+    ~replies() {
+        for (auto& h : _handlers)
+            _wheel.remove(h.deadline);
+    }
+
     template <typename CompletionToken>
     decltype(auto) async_wait_reply(
         control_code_e code, uint16_t packet_id, CompletionToken&& token
     ) {
         auto dup_handler_ptr = find_handler(code, packet_id);
-        if (dup_handler_ptr != _handlers.end()) {
-            dup_handler_ptr->complete_post(_ex, asio::error::operation_aborted);
-            _handlers.erase(dup_handler_ptr);
-        }
+        if (dup_handler_ptr != _handlers.end())
+            complete_post(
+                release(_handlers, dup_handler_ptr),
+                asio::error::operation_aborted
+            );
 
         auto freply = find_fast_reply(code, packet_id);
 
@@ -128,9 +151,7 @@ public:
                 auto handler, replies& self,
                 control_code_e code, uint16_t packet_id
             ) {
-                self._handlers.emplace_back(
-                    code, packet_id, std::move(handler)
-                );
+                self.arm(code, packet_id, std::move(handler));
             };
             return asio::async_initiate<CompletionToken, Signature>(
                 initiation, token, std::ref(*this), code, packet_id
@@ -163,6 +184,28 @@ public:
         );
     }
 
+    // Completes when a reply has not been received within max_reply_time.
+    // At most one wait may be pending.
+    template <typename CompletionToken>
+    decltype(auto) async_wait_expired(CompletionToken&& token) {
+        auto initiation = [](auto handler, replies& self) {
+            self._expired_handler = std::move(handler);
+        };
+        return asio::async_initiate<CompletionToken, void (error_code)>(
+            initiation, token, std::ref(*this)
+        );
+    }
+
+    void cancel_expired_wait() {
+        if (_expired_handler)
+            asio::post(
+                _ex,
+                asio::prepend(
+                    std::move(_expired_handler), asio::error::operation_aborted
+                )
+            );
+    }
+
     void dispatch(
         error_code ec, control_code_e code, uint16_t packet_id,
         byte_citer first, byte_citer last
@@ -177,31 +220,24 @@ public:
             return;
         }
 
-        auto handler = std::move(*handler_ptr);
-        _handlers.erase(handler_ptr);
-        handler.complete(ec, first, last);
+        auto handler = release(_handlers, handler_ptr);
+        std::move(handler)(ec, first, last);
     }
 
     void resend_unanswered() {
-        auto ua = std::move(_handlers);
-        for (auto& h : ua)
-            h.complete(asio::error::try_again);
+        handlers ua(_handlers.get_allocator());
+        ua.splice(ua.end(), _handlers);
+        while (!ua.empty())
+            release(ua, ua.begin())(
+                asio::error::try_again, byte_citer {}, byte_citer {}
+            );
     }
 
     void cancel_unanswered() {
-        auto ua = std::move(_handlers);
-        for (auto& h : ua)
-            h.complete_post(_ex, asio::error::operation_aborted);
-    }
-
-    bool any_expired() {
-        auto now = std::chrono::system_clock::now();
-        return std::any_of(
-            _handlers.begin(), _handlers.end(),
-            [now](const auto& h) {
-                return now - h.time() > max_reply_time;
-            }
-        );
+        handlers ua(_handlers.get_allocator());
+        ua.splice(ua.end(), _handlers);
+        while (!ua.empty())
+            complete_post(release(ua, ua.begin()), asio::error::operation_aborted);
     }
 
     void clear_fast_replies() {
@@ -209,27 +245,83 @@ public:
     }
 
     void clear_pending_pubrels() {
+        handlers pubrels(_handlers.get_allocator());
         for (auto it = _handlers.begin(); it != _handlers.end();) {
-            if (it->code() == control_code_e::pubrel) {
-                it->complete(asio::error::operation_aborted);
-                it = _handlers.erase(it);
-            }
-            else
-                ++it;
+            auto next = std::next(it);
+            if (it->code == control_code_e::pubrel)
+                pubrels.splice(pubrels.end(), _handlers, it);
+            it = next;
         }
+        while (!pubrels.empty())
+            release(pubrels, pubrels.begin())(
+                asio::error::operation_aborted, byte_citer {}, byte_citer {}
+            );
     }
 
 private:
-    handlers::iterator find_handler(control_code_e code, uint16_t packet_id) {
+    template <typename Handler>
+    void arm(control_code_e code, uint16_t packet_id, Handler&& handler) {
+        if (_free_handlers.empty())
+            _handlers.emplace_back();
+        else
+            _handlers.splice(
+                _handlers.end(), _free_handlers, _free_handlers.begin()
+            );
+
+        auto& reply = _handlers.back();
+        reply.handler = std::forward<Handler>(handler);
+        reply.code = code;
+        reply.packet_id = packet_id;
+        reply.serial = ++_serial;
+        schedule_deadline(reply);
+    }
+
+    void schedule_deadline(reply_handler& reply) {
+        _wheel.schedule(
+            reply.deadline, timer_wheel::clock_type::now() + max_reply_time,
+            on_deadline { _self, reply }, _ex
+        );
+    }
+
+    // Removes the deadline of the reply, recycles its node
+    // and returns its handler.
+    handler_type release(handlers& list, typename handlers::iterator it) {
+        _wheel.remove(it->deadline);
+        auto handler = std::move(it->handler);
+        _free_handlers.splice(_free_handlers.begin(), list, it);
+        return handler;
+    }
+
+    void complete_post(handler_type handler, error_code ec) {
+        asio::post(
+            _ex,
+            asio::prepend(
+                std::move(handler), ec, byte_citer {}, byte_citer {}
+            )
+        );
+    }
+
+    void on_reply_expired(reply_handler& reply) {
+        // Nobody is waiting while the Client disconnects after
+        // an earlier expiry, or after the wait has been cancelled.
+        // The reply is given another max_reply_time instead of
+        // being dropped, so that it still times out.
+        if (!_expired_handler)
+            return schedule_deadline(reply);
+        auto handler = std::move(_expired_handler);
+        std::move(handler)(error_code {});
+    }
+
+    typename handlers::iterator find_handler(control_code_e code, uint16_t packet_id) {
         return std::find_if(
             _handlers.begin(), _handlers.end(),
             [code, packet_id](const auto& h) {
-                return h.code() == code && h.packet_id() == packet_id;
+                return h.code == code && h.packet_id == packet_id;
             }
         );
     }
 
-    fast_replies::iterator find_fast_reply(
+    typename fast_replies::iterator find_fast_reply(
         control_code_e code, uint16_t packet_id
     ) {
         return std::find_if(
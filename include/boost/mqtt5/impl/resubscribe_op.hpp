@@ -0,0 +1,196 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MQTT5_RESUBSCRIBE_OP_HPP
+#define BOOST_MQTT5_RESUBSCRIBE_OP_HPP
+
+#include <boost/mqtt5/error.hpp>
+#include <boost/mqtt5/reason_codes.hpp>
+#include <boost/mqtt5/types.hpp>
+
+#include <boost/mqtt5/detail/control_packet.hpp>
+#include <boost/mqtt5/detail/internal_types.hpp>
+#include <boost/mqtt5/detail/subscription_registry.hpp>
+
+#include <boost/mqtt5/impl/codecs/message_decoders.hpp>
+#include <boost/mqtt5/impl/codecs/message_encoders.hpp>
+#include <boost/mqtt5/impl/disconnect_op.hpp>
+
+#include <boost/asio/detached.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/prepend.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace boost::mqtt5::detail {
+
+namespace asio = boost::asio;
+
+// Re-establishes a batch of registered Subscriptions after
+// the Server reported that it has no Session for the Client.
+template <typename ClientService>
+class resubscribe_op {
+    using client_service = ClientService;
+
+    struct on_subscribe {};
+    struct on_suback {};
+
+    std::shared_ptr<client_service> _svc_ptr;
+    subscription_registry::batch _batch;
+    uint32_t _round;
+
+public:
+    resubscribe_op(
+        std::shared_ptr<client_service> svc_ptr,
+        subscription_registry::batch batch, uint32_t round
+    ) :
+        _svc_ptr(std::move(svc_ptr)), _batch(std::move(batch)), _round(round)
+    {}
+
+    resubscribe_op(resubscribe_op&&) noexcept = default;
+    resubscribe_op(const resubscribe_op&) = delete;
+
+    resubscribe_op& operator=(resubscribe_op&&) noexcept = default;
+    resubscribe_op& operator=(const resubscribe_op&) = delete;
+
+    using allocator_type = typename client_service::internal_allocator_type;
+    allocator_type get_allocator() const noexcept {
+        return _svc_ptr->get_internal_allocator();
+    }
+
+    using executor_type = typename client_service::executor_type;
+    executor_type get_executor() const noexcept {
+        return _svc_ptr->get_executor();
+    }
+
+    void perform() {
+        uint16_t packet_id = _svc_ptr->allocate_pid();
+        if (packet_id == 0)
+            return on_batch_lost(packet_id);
+
+        auto subscribe = control_packet::of(
+            with_pid, encoders::encode_subscribe, packet_id,
+            _batch.topics, _batch.props
+        );
+
+        auto max_packet_size = _svc_ptr->connack_property(prop::maximum_packet_size)
+                .value_or(default_max_send_size);
+        if (subscribe.size() > max_packet_size)
+            return on_batch_lost(packet_id);
+
+        send_subscribe(std::move(subscribe));
+    }
+
+    void send_subscribe(control_packet subscribe) {
+        auto wire_data = subscribe.wire_data();
+        _svc_ptr->async_send(
+            wire_data,
+            no_serial, send_flag::prioritized,
+            asio::prepend(
+                std::move(*this), on_subscribe {}, std::move(subscribe)
+            )
+        );
+    }
+
+    void resend_subscribe(control_packet subscribe) {
+        // the Subscriptions are being re-subscribed again
+        if (_round != _svc_ptr->subscriptions().round())
+            return _svc_ptr->free_pid(subscribe.packet_id());
+        send_subscribe(std::move(subscribe));
+    }
+
+    void operator()(
+        on_subscribe, control_packet packet,
+        error_code ec
+    ) {
+        if (ec == asio::error::try_again)
+            return resend_subscribe(std::move(packet));
+
+        if (ec)
+            return _svc_ptr->free_pid(packet.packet_id());
+
+        auto packet_id = packet.packet_id();
+        _svc_ptr->async_wait_reply(
+            control_code_e::suback, packet_id,
+            asio::prepend(std::move(*this), on_suback {}, std::move(packet))
+        );
+    }
+
+    void operator()(
+        on_suback, control_packet packet,
+        error_code ec, byte_citer first, byte_citer last
+    ) {
+        if (ec == asio::error::try_again) // "resend unanswered"
+            return resend_subscribe(std::move(packet));
+
+        uint16_t packet_id = packet.packet_id();
+
+        if (ec)
+            return _svc_ptr->free_pid(packet_id);
+
+        auto suback = decoders::decode_suback(
+            static_cast<uint32_t>(std::distance(first, last)), first
+        );
+        if (!suback.has_value()) {
+            on_malformed_packet("Malformed SUBACK: cannot decode");
+            return resend_subscribe(std::move(packet));
+        }
+
+        auto& [props, rcs] = *suback;
+        if (rcs.size() != _batch.topics.size()) {
+            on_malformed_packet(
+                "Malformed SUBACK: does not contain a "
+                "valid Reason Code for every Topic Filter"
+            );
+            return resend_subscribe(std::move(packet));
+        }
+
+        bool all_granted = true;
+        for (size_t i = 0; i < rcs.size(); ++i) {
+            auto rc = to_reason_code<reason_codes::category::suback>(rcs[i]);
+            if (rc && !*rc)
+                continue;
+            all_granted = false;
+            _svc_ptr->subscriptions().remove(_batch.topics[i].topic_filter);
+        }
+
+        if (!all_granted)
+            return on_resubscribe_fail(packet_id);
+
+        _svc_ptr->free_pid(packet_id);
+    }
+
+private:
+    void on_malformed_packet(const std::string& reason) {
+        auto props = disconnect_props {};
+        props[prop::reason_string] = reason;
+        async_disconnect(
+            disconnect_rc_e::malformed_packet, props, _svc_ptr,
+            asio::detached
+        );
+    }
+
+    void on_batch_lost(uint16_t packet_id) {
+        for (const auto& topic : _batch.topics)
+            _svc_ptr->subscriptions().remove(topic.topic_filter);
+        on_resubscribe_fail(packet_id);
+    }
+
+    // Subscriptions that could not be re-established are lost,
+    // which is reported the same way as when they are not registered.
+    void on_resubscribe_fail(uint16_t packet_id) {
+        if (packet_id != 0)
+            _svc_ptr->free_pid(packet_id);
+        _svc_ptr->channel_store_error(client::error::session_expired);
+    }
+};
+
+} // end namespace boost::mqtt5::detail
+
+#endif // !BOOST_MQTT5_RESUBSCRIBE_OP_HPP
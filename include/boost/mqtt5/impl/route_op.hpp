@@ -0,0 +1,301 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MQTT5_ROUTE_OP_HPP
+#define BOOST_MQTT5_ROUTE_OP_HPP
+
+#include <boost/mqtt5/error.hpp>
+#include <boost/mqtt5/reason_codes.hpp>
+#include <boost/mqtt5/types.hpp>
+
+#include <boost/mqtt5/detail/cancellable_handler.hpp>
+
+#include <boost/asio/associated_allocator.hpp>
+#include <boost/asio/associated_cancellation_slot.hpp>
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/prepend.hpp>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace boost::mqtt5::detail {
+
+namespace asio = boost::asio;
+
+template <typename ClientType, typename Router, typename Handler>
+class route_op {
+    using client_type = ClientType;
+    using router_type = Router;
+
+    struct on_message {};
+    struct on_message_view {};
+
+    client_type& _client;
+    router_type& _router;
+
+    using handler_type = cancellable_handler<
+        Handler,
+        typename client_type::executor_type
+    >;
+    handler_type _handler;
+
+public:
+    route_op(client_type& client, router_type& router, Handler&& handler) :
+        _client(client), _router(router),
+        _handler(std::move(handler), client.get_executor())
+    {}
+
+    route_op(route_op&&) noexcept = default;
+    route_op(const route_op&) = delete;
+
+    route_op& operator=(route_op&&) noexcept = default;
+    route_op& operator=(const route_op&) = delete;
+
+    using allocator_type = asio::associated_allocator_t<handler_type>;
+    allocator_type get_allocator() const noexcept {
+        return asio::get_associated_allocator(_handler);
+    }
+
+    using cancellation_slot_type =
+        asio::associated_cancellation_slot_t<handler_type>;
+    cancellation_slot_type get_cancellation_slot() const noexcept {
+        return _handler.get_cancellation_slot();
+    }
+
+    using executor_type = typename client_type::executor_type;
+    executor_type get_executor() const noexcept {
+        return _client.get_executor();
+    }
+
+    void perform() {
+        // in zero-copy mode, messages are only delivered as publish_views
+        if (_client.zero_copy_receive())
+            return _client.async_receive_view(
+                asio::prepend(std::move(*this), on_message_view {})
+            );
+
+        _client.async_receive(
+            asio::prepend(std::move(*this), on_message {})
+        );
+    }
+
+    void operator()(
+        on_message, error_code ec,
+        std::string topic, std::string payload, publish_props props
+    ) {
+        if (ec)
+            return _handler.complete(ec);
+
+        _router.route(topic, payload, props);
+        perform();
+    }
+
+    void operator()(on_message_view, error_code ec, publish_view message) {
+        if (ec)
+            return _handler.complete(ec);
+
+        _router.route(message);
+        perform();
+    }
+};
+
+template <typename ClientType, typename Router>
+class initiate_async_route {
+    ClientType& _client;
+    Router& _router;
+public:
+    initiate_async_route(ClientType& client, Router& router) :
+        _client(client), _router(router)
+    {}
+
+    using executor_type = typename ClientType::executor_type;
+    executor_type get_executor() const noexcept {
+        return _client.get_executor();
+    }
+
+    template <typename Handler>
+    void operator()(Handler&& handler) {
+        route_op<ClientType, Router, Handler> {
+            _client, _router, std::move(handler)
+        }.perform();
+    }
+};
+
+template <typename ClientType, typename Router, typename Handler>
+class subscribe_route_op {
+    using client_type = ClientType;
+    using router_type = Router;
+    using route_handler_type = typename router_type::handler_type;
+
+    struct on_suback {};
+    struct on_fallback_suback {};
+
+    client_type& _client;
+    router_type& _router;
+
+    std::vector<subscribe_topic> _topics;
+    subscribe_props _props;
+    route_handler_type _route_handler;
+    int32_t _sub_id { 0 };
+
+    Handler _handler;
+
+public:
+    subscribe_route_op(
+        client_type& client, router_type& router,
+        std::vector<subscribe_topic> topics, subscribe_props props,
+        route_handler_type route_handler, Handler&& handler
+    ) :
+        _client(client), _router(router),
+        _topics(std::move(topics)), _props(std::move(props)),
+        _route_handler(std::move(route_handler)),
+        _handler(std::move(handler))
+    {}
+
+    subscribe_route_op(subscribe_route_op&&) noexcept = default;
+    subscribe_route_op(const subscribe_route_op&) = delete;
+
+    subscribe_route_op& operator=(subscribe_route_op&&) noexcept = default;
+    subscribe_route_op& operator=(const subscribe_route_op&) = delete;
+
+    using allocator_type = asio::associated_allocator_t<Handler>;
+    allocator_type get_allocator() const noexcept {
+        return asio::get_associated_allocator(_handler);
+    }
+
+    using cancellation_slot_type =
+        asio::associated_cancellation_slot_t<Handler>;
+    cancellation_slot_type get_cancellation_slot() const noexcept {
+        return asio::get_associated_cancellation_slot(_handler);
+    }
+
+    using executor_type = asio::associated_executor_t<
+        Handler, typename client_type::executor_type
+    >;
+    executor_type get_executor() const noexcept {
+        return asio::get_associated_executor(_handler, _client.get_executor());
+    }
+
+    void perform() {
+        // identifies the routes of this subscription in the Router,
+        // whether or not it is sent to the Broker
+        _sub_id = _router.add_subscription(_route_handler);
+        if (!_sub_id)
+            return asio::post(
+                _client.get_executor(),
+                asio::prepend(
+                    std::move(*this), on_suback {},
+                    error_code(asio::error::no_buffer_space),
+                    std::vector<reason_code> {}, suback_props {}
+                )
+            );
+
+        auto sub_id_available = _client.connack_property(
+            prop::subscription_identifier_available
+        ).value_or(1);
+
+        if (!sub_id_available)
+            return subscribe_by_filters();
+
+        _props[prop::subscription_identifier] = _sub_id;
+        _client.async_subscribe(
+            _topics, _props,
+            asio::prepend(std::move(*this), on_suback {})
+        );
+    }
+
+    void operator()(
+        on_suback, error_code ec,
+        std::vector<reason_code> rcs, suback_props props
+    ) {
+        // The Broker turned out not to support Subscription Identifiers.
+        if (ec == client::error::subscription_identifier_not_available) {
+            _props[prop::subscription_identifier].clear();
+            return subscribe_by_filters();
+        }
+
+        complete(ec, std::move(rcs), std::move(props));
+    }
+
+    void operator()(
+        on_fallback_suback, error_code ec,
+        std::vector<reason_code> rcs, suback_props props
+    ) {
+        if (!ec && !all_failed(rcs))
+            // only the routes of the Topics that failed are removed
+            for (size_t i = 0; i < _topics.size(); ++i)
+                if (i >= rcs.size() || rcs[i])
+                    _router.remove_owned(_topics[i].topic_filter, _sub_id);
+
+        complete(ec, std::move(rcs), std::move(props));
+    }
+
+private:
+    // The handler is registered per Topic Filter, next to (and never
+    // replacing) the handlers already registered for the same filters.
+    void subscribe_by_filters() {
+        for (const auto& topic : _topics)
+            _router.add_owned(topic.topic_filter, _sub_id, _route_handler);
+
+        _client.async_subscribe(
+            _topics, _props,
+            asio::prepend(std::move(*this), on_fallback_suback {})
+        );
+    }
+
+    static bool all_failed(const std::vector<reason_code>& rcs) {
+        for (const auto& rc : rcs)
+            if (!rc)
+                return false;
+        return true;
+    }
+
+    void complete(
+        error_code ec, std::vector<reason_code> rcs, suback_props props
+    ) {
+        if (ec || all_failed(rcs))
+            // removes the routes registered per Topic Filter as well
+            _router.remove_subscription(std::exchange(_sub_id, 0));
+
+        std::move(_handler)(ec, std::move(rcs), std::move(props), _sub_id);
+    }
+};
+
+template <typename ClientType, typename Router>
+class initiate_async_subscribe_route {
+    ClientType& _client;
+    Router& _router;
+public:
+    initiate_async_subscribe_route(ClientType& client, Router& router) :
+        _client(client), _router(router)
+    {}
+
+    using executor_type = typename ClientType::executor_type;
+    executor_type get_executor() const noexcept {
+        return _client.get_executor();
+    }
+
+    template <typename Handler>
+    void operator()(
+        Handler&& handler,
+        const std::vector<subscribe_topic>& topics, const subscribe_props& props,
+        typename Router::handler_type route_handler
+    ) {
+        subscribe_route_op<ClientType, Router, Handler> {
+            _client, _router, topics, props,
+            std::move(route_handler), std::move(handler)
+        }.perform();
+    }
+};
+
+} // end namespace boost::mqtt5::detail
+
+#endif // !BOOST_MQTT5_ROUTE_OP_HPP
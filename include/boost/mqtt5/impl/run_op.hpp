@@ -75,6 +75,7 @@ public:
 
         _svc_ptr->_stream.open();
         _svc_ptr->_rec_channel.reset();
+        _svc_ptr->_rec_view_channel.reset();
 
         auto init_read_message_op = [](
             auto handler, std::shared_ptr<client_service> svc_ptr
@@ -15,7 +15,6 @@
 
 #include <boost/asio/prepend.hpp>
 
-#include <chrono>
 #include <memory>
 
 namespace boost::mqtt5::detail {
@@ -27,11 +26,9 @@ class sentry_op {
     using client_service = ClientService;
     using handler_type = Handler;
 
-    struct on_timer {};
+    struct on_expired {};
     struct on_disconnect {};
 
-    static constexpr auto check_interval = std::chrono::seconds(3);
-
     std::shared_ptr<client_service> _svc_ptr;
     handler_type _handler;
 
@@ -57,28 +54,23 @@ public:
     }
 
     void perform() {
-        _svc_ptr->_sentry_timer.expires_after(check_interval);
-        _svc_ptr->_sentry_timer.async_wait(
-            asio::prepend(std::move(*this), on_timer {})
+        _svc_ptr->_replies.async_wait_expired(
+            asio::prepend(std::move(*this), on_expired {})
         );
     }
 
-    void operator()(on_timer, error_code) {
-        if (!_svc_ptr->is_open())
+    void operator()(on_expired, error_code ec) {
+        if (ec || !_svc_ptr->is_open())
             return complete();
 
-        if (_svc_ptr->_replies.any_expired()) {
-            auto props = disconnect_props {};
-            // TODO add what packet was expected?
-            props[prop::reason_string] = "No reply received within 20 seconds";
-            auto svc_ptr = _svc_ptr;
-            return async_disconnect(
-                disconnect_rc_e::unspecified_error, props, svc_ptr,
-                asio::prepend(std::move(*this), on_disconnect {})
-            );
-        }
-
-        perform();
+        auto props = disconnect_props {};
+        // TODO add what packet was expected?
+        props[prop::reason_string] = "No reply received within 20 seconds";
+        auto svc_ptr = _svc_ptr;
+        async_disconnect(
+            disconnect_rc_e::unspecified_error, props, svc_ptr,
+            asio::prepend(std::move(*this), on_disconnect {})
+        );
     }
 
     void operator()(on_disconnect, error_code ec) {
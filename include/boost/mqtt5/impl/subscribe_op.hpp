@@ -19,6 +19,7 @@
 
 #include <boost/mqtt5/impl/codecs/message_decoders.hpp>
 #include <boost/mqtt5/impl/codecs/message_encoders.hpp>
+#include <boost/mqtt5/impl/coalesce_op.hpp>
 #include <boost/mqtt5/impl/disconnect_op.hpp>
 
 #include <boost/asio/associated_allocator.hpp>
@@ -44,6 +45,7 @@ class subscribe_op {
 
     struct on_subscribe {};
     struct on_suback {};
+    struct on_coalesced {};
 
     std::shared_ptr<client_service> _svc_ptr;
 
@@ -55,6 +57,10 @@ class subscribe_op {
 
     size_t _num_topics { 0 };
 
+    // kept only if granted Subscriptions are registered
+    std::vector<subscribe_topic> _topics;
+    subscribe_props _props;
+
 public:
     subscribe_op(
         std::shared_ptr<client_service> svc_ptr,
@@ -92,8 +98,11 @@ public:
     ) {
         _num_topics = topics.size();
 
-        uint16_t packet_id = _svc_ptr->allocate_pid();
-        if (packet_id == 0)
+        // a coalesced request is sent with the Packet Identifier
+        // of the packet it is coalesced into
+        bool coalesce = _svc_ptr->coalesce_subscriptions();
+        uint16_t packet_id = coalesce ? 0 : _svc_ptr->allocate_pid();
+        if (coalesce ? _svc_ptr->pid_exhausted() : packet_id == 0)
             return complete_immediate(client::error::pid_overrun, packet_id);
 
         if (_num_topics == 0)
@@ -103,9 +112,19 @@ public:
         if (ec)
             return complete_immediate(ec, packet_id);
 
-        auto subscribe = control_packet<allocator_type>::of(
-            with_pid, get_allocator(),
-            encoders::encode_subscribe, packet_id,
+        if (_svc_ptr->subscriptions().enabled()) {
+            _topics = topics;
+            _props = props;
+        }
+
+        if (coalesce)
+            return coalesce_request<subscribe_traits>(
+                _svc_ptr, topics, props,
+                asio::prepend(std::move(*this), on_coalesced {})
+            );
+
+        auto subscribe = control_packet::of(
+            with_pid, encoders::encode_subscribe, packet_id,
             topics, props
         );
 
@@ -117,7 +136,7 @@ public:
         send_subscribe(std::move(subscribe));
     }
 
-    void send_subscribe(control_packet<allocator_type> subscribe) {
+    void send_subscribe(control_packet subscribe) {
         auto wire_data = subscribe.wire_data();
         _svc_ptr->async_send(
             wire_data,
@@ -128,7 +147,7 @@ public:
         );
     }
 
-    void resend_subscribe(control_packet<allocator_type> subscribe) {
+    void resend_subscribe(control_packet subscribe) {
         if (_handler.cancelled() != asio::cancellation_type_t::none)
             return complete(
                 asio::error::operation_aborted, subscribe.packet_id()
@@ -137,7 +156,7 @@ public:
     }
 
     void operator()(
-        on_subscribe, control_packet<allocator_type> packet,
+        on_subscribe, control_packet packet,
         error_code ec
     ) {
         if (ec == asio::error::try_again)
@@ -155,7 +174,7 @@ public:
     }
 
     void operator()(
-        on_suback, control_packet<allocator_type> packet,
+        on_suback, control_packet packet,
         error_code ec, byte_citer first, byte_citer last
     ) {
         if (ec == asio::error::try_again) // "resend unanswered"
@@ -189,6 +208,13 @@ public:
         );
     }
 
+    void operator()(
+        on_coalesced, error_code ec,
+        std::vector<uint8_t> rcs, suback_props props
+    ) {
+        complete(ec, 0, to_reason_codes(std::move(rcs)), std::move(props));
+    }
+
 private:
 
     error_code validate_subscribe(
@@ -302,7 +328,12 @@ private:
                 _svc_ptr->subscriptions_present(true);
         }
 
-        _svc_ptr->free_pid(packet_id);
+        for (size_t i = 0; i < _topics.size() && i < reason_codes.size(); ++i)
+            if (!reason_codes[i])
+                _svc_ptr->subscriptions().add(_topics[i], _props);
+
+        if (packet_id != 0)
+            _svc_ptr->free_pid(packet_id);
         _handler.complete(ec, std::move(reason_codes), std::move(props));
     }
 };
@@ -325,8 +356,12 @@ public:
         Handler&& handler,
         const std::vector<subscribe_topic>& topics, const subscribe_props& props
     ) {
-        detail::subscribe_op { _svc_ptr, std::move(handler) }
-            .perform(topics, props);
+        detail::subscribe_op {
+            _svc_ptr,
+            with_default_allocator(
+                std::forward<Handler>(handler), _svc_ptr->get_allocator()
+            )
+        }.perform(topics, props);
     }
 };
 
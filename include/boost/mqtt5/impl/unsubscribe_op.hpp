@@ -19,6 +19,7 @@
 
 #include <boost/mqtt5/impl/codecs/message_decoders.hpp>
 #include <boost/mqtt5/impl/codecs/message_encoders.hpp>
+#include <boost/mqtt5/impl/coalesce_op.hpp>
 #include <boost/mqtt5/impl/disconnect_op.hpp>
 
 #include <boost/asio/associated_allocator.hpp>
@@ -44,6 +45,7 @@ class unsubscribe_op {
 
     struct on_unsubscribe {};
     struct on_unsuback {};
+    struct on_coalesced {};
 
     std::shared_ptr<client_service> _svc_ptr;
 
@@ -55,6 +57,9 @@ class unsubscribe_op {
 
     size_t _num_topics { 0 };
 
+    // kept only if granted Subscriptions are registered
+    std::vector<std::string> _topics;
+
 public:
     unsubscribe_op(
         std::shared_ptr<client_service> svc_ptr,
@@ -92,8 +97,11 @@ public:
     ) {
         _num_topics = topics.size();
 
-        uint16_t packet_id = _svc_ptr->allocate_pid();
-        if (packet_id == 0)
+        // a coalesced request is sent with the Packet Identifier
+        // of the packet it is coalesced into
+        bool coalesce = _svc_ptr->coalesce_subscriptions();
+        uint16_t packet_id = coalesce ? 0 : _svc_ptr->allocate_pid();
+        if (coalesce ? _svc_ptr->pid_exhausted() : packet_id == 0)
             return complete_immediate(client::error::pid_overrun, packet_id);
 
         if (_num_topics == 0)
@@ -103,9 +111,17 @@ public:
         if (ec)
             return complete_immediate(ec, packet_id);
 
-        auto unsubscribe = control_packet<allocator_type>::of(
-            with_pid, get_allocator(),
-            encoders::encode_unsubscribe, packet_id,
+        if (_svc_ptr->subscriptions().enabled())
+            _topics = topics;
+
+        if (coalesce)
+            return coalesce_request<unsubscribe_traits>(
+                _svc_ptr, topics, props,
+                asio::prepend(std::move(*this), on_coalesced {})
+            );
+
+        auto unsubscribe = control_packet::of(
+            with_pid, encoders::encode_unsubscribe, packet_id,
             topics, props
         );
 
@@ -117,7 +133,7 @@ public:
         send_unsubscribe(std::move(unsubscribe));
     }
 
-    void send_unsubscribe(control_packet<allocator_type> unsubscribe) {
+    void send_unsubscribe(control_packet unsubscribe) {
         auto wire_data = unsubscribe.wire_data();
         _svc_ptr->async_send(
             wire_data,
@@ -128,7 +144,7 @@ public:
         );
     }
 
-    void resend_unsubscribe(control_packet<allocator_type> subscribe) {
+    void resend_unsubscribe(control_packet subscribe) {
         if (_handler.cancelled() != asio::cancellation_type_t::none)
             return complete(
                 asio::error::operation_aborted, subscribe.packet_id()
@@ -137,7 +153,7 @@ public:
     }
 
     void operator()(
-        on_unsubscribe, control_packet<allocator_type> packet,
+        on_unsubscribe, control_packet packet,
         error_code ec
     ) {
         if (ec == asio::error::try_again)
@@ -155,7 +171,7 @@ public:
     }
 
     void operator()(
-        on_unsuback, control_packet<allocator_type> packet,
+        on_unsuback, control_packet packet,
         error_code ec, byte_citer first, byte_citer last
     ) {
         if (ec == asio::error::try_again) // "resend unanswered"
@@ -189,6 +205,13 @@ public:
         );
     }
 
+    void operator()(
+        on_coalesced, error_code ec,
+        std::vector<uint8_t> rcs, unsuback_props props
+    ) {
+        complete(ec, 0, to_reason_codes(std::move(rcs)), std::move(props));
+    }
+
 private:
 
     static error_code validate_unsubscribe(
@@ -243,7 +266,12 @@ private:
         if (reason_codes.empty() && _num_topics)
             reason_codes = std::vector<reason_code>(_num_topics, reason_codes::empty);
 
-        _svc_ptr->free_pid(packet_id);
+        for (size_t i = 0; i < _topics.size() && i < reason_codes.size(); ++i)
+            if (!reason_codes[i])
+                _svc_ptr->subscriptions().remove(_topics[i]);
+
+        if (packet_id != 0)
+            _svc_ptr->free_pid(packet_id);
         _handler.complete(ec, std::move(reason_codes), std::move(props));
     }
 };
@@ -266,8 +294,12 @@ public:
         Handler&& handler,
         const std::vector<std::string>& topics, const unsubscribe_props& props
     ) {
-        detail::unsubscribe_op { _svc_ptr, std::move(handler) }
-            .perform(topics, props);
+        detail::unsubscribe_op {
+            _svc_ptr,
+            with_default_allocator(
+                std::forward<Handler>(handler), _svc_ptr->get_allocator()
+            )
+        }.perform(topics, props);
     }
 };
 
@@ -14,6 +14,7 @@
 
 #include <boost/mqtt5/detail/log_invoke.hpp>
 #include <boost/mqtt5/detail/rebind_executor.hpp>
+#include <boost/mqtt5/detail/topic_validation.hpp>
 
 #include <boost/mqtt5/impl/client_service.hpp>
 #include <boost/mqtt5/impl/publish_send_op.hpp>
@@ -27,6 +28,7 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <variant> // std::monostate
 #include <vector>
@@ -43,6 +45,8 @@ namespace asio = boost::asio;
  * ordered and lossless.
  * \tparam \__TlsContext\__ Type of the context object used in TLS/SSL connections.
  * \tparam \__LoggerType\__ Type of object used to log events within the Client.
+ * \tparam \__Allocator\__ Type of the allocator used by the Client for its internal state,
+ * and for the asynchronous operations whose handlers have no associated allocator.
  *
  * \par Thread safety
  * Distinct objects: safe. \n
@@ -53,13 +57,17 @@ namespace asio = boost::asio;
 template <
     typename StreamType,
     typename TlsContext = std::monostate,
-    typename LoggerType = noop_logger
+    typename LoggerType = noop_logger,
+    typename Allocator = std::allocator<void>
 >
 class mqtt_client {
 public:
     /// The executor type associated with the client.
     using executor_type = typename StreamType::executor_type;
 
+    /// The allocator type associated with the client.
+    using allocator_type = Allocator;
+
     /// Rebinds the client type to another executor.
     template <typename Executor>
     struct rebind_executor {
@@ -67,7 +75,8 @@ public:
         using other = mqtt_client<
             typename detail::rebind_executor<StreamType, Executor>::other,
             TlsContext,
-            LoggerType
+            LoggerType,
+            Allocator
         >;
     };
 
@@ -77,7 +86,7 @@ private:
     using logger_type = LoggerType;
 
     using client_service_type = detail::client_service<
-        stream_type, tls_context_type, logger_type
+        stream_type, tls_context_type, logger_type, allocator_type
     >;
     using impl_type = std::shared_ptr<client_service_type>;
     impl_type _impl;
@@ -89,13 +98,15 @@ public:
      * \param ex An executor that will be associated with the Client.
      * \param tls_context A context object used in TLS/SSL connection.
      * \param logger An object satisfying the \__LoggerType\__ concept used to log events within the Client.
+     * \param alloc The allocator that will be associated with the Client.
      */
     explicit mqtt_client(
         const executor_type& ex,
-        tls_context_type tls_context = {}, logger_type logger = {}
+        tls_context_type tls_context = {}, logger_type logger = {},
+        const allocator_type& alloc = {}
     ) :
-        _impl(std::make_shared<client_service_type>(
-            ex, std::move(tls_context), std::move(logger)
+        _impl(std::allocate_shared<client_service_type>(
+            alloc, ex, std::move(tls_context), std::move(logger), alloc
         ))
     {}
 
@@ -106,6 +117,7 @@ public:
      * \param context Execution context whose executor will be associated with the Client.
      * \param tls_context A context object used in TLS/SSL connection.
      * \param logger An object satisfying the \__LoggerType\__ concept used to log events within the Client.
+     * \param alloc The allocator that will be associated with the Client.
      *
      * \par Precondition
      * \code
@@ -121,11 +133,12 @@ public:
     >
     explicit mqtt_client(
         ExecutionContext& context,
-        tls_context_type tls_context = {}, logger_type logger = {}
+        tls_context_type tls_context = {}, logger_type logger = {},
+        const allocator_type& alloc = {}
     ) :
         mqtt_client(
             context.get_executor(),
-            std::move(tls_context), std::move(logger)
+            std::move(tls_context), std::move(logger), alloc
         )
     {}
 
@@ -162,6 +175,13 @@ public:
         return _impl->get_executor();
     }
 
+    /**
+     * \brief Get the allocator associated with the object.
+     */
+    allocator_type get_allocator() const noexcept {
+        return _impl->get_allocator();
+    }
+
     /**
      * \brief Get the context object used in TLS/SSL connection.
      *
@@ -353,6 +373,178 @@ public:
         return *this;
     }
 
+    /**
+     * \brief Enable or disable zero-copy delivery of received Application Messages.
+     *
+     * \details When enabled, the Client does not copy the Topic and the Payload
+     * out of received \__PUBLISH\__ packets. Application Messages are delivered
+     * as \ref publish_view objects referring directly to the reference-counted
+     * buffer the packet was read into, and must be received
+     * with \ref async_receive_view instead of \ref async_receive.
+     * While received messages still refer to the read buffer, the Client reads
+     * into a new buffer sized to the packet being received (at least 4 KiB),
+     * so each retained message keeps at most one such buffer alive.
+     *
+     * \param enable Whether to deliver Application Messages as \ref publish_view objects.
+     * Zero-copy delivery is disabled by default.
+     *
+     * \attention This function takes action when the client is in a non-operational state,
+     * meaning the \ref async_run function has not been invoked.
+     * Furthermore, you can use this function after the \ref cancel function has been called,
+     * before the \ref async_run function is invoked again.
+     */
+    mqtt_client& zero_copy_receive(bool enable) {
+        _impl->zero_copy_receive(enable);
+        return *this;
+    }
+
+    /**
+     * \brief Returns `true` if zero-copy delivery of received Application Messages
+     * is enabled.
+     *
+     * \see \ref zero_copy_receive
+     */
+    bool zero_copy_receive() const {
+        return _impl->zero_copy_receive();
+    }
+
+    /**
+     * \brief Enable or disable the low-footprint mode, for processes running
+     * large numbers of mostly idle Clients.
+     *
+     * \details By default, the Client reads into a buffer as large as the maximum
+     * packet size it accepts (64 KiB unless the \__MAXIMUM_PACKET_SIZE\__ is set
+     * with \ref connect_property), which lets a single read take in many packets.
+     * In low-footprint mode, the buffer starts at 256 bytes, grows only to fit
+     * the packet being received and shrinks back once that packet is processed.
+     * A connected, idle Client then holds less than 16 KiB of heap memory,
+     * at the cost of more reads when receiving large or frequent messages.
+     *
+     * The keep alive and read timeout deadlines of the Client are then driven
+     * by a timer wheel shared by all Clients in the same execution context,
+     * instead of a timer per deadline. Its single timer ticks every 100 milliseconds,
+     * only while a deadline is pending, and the deadlines are rounded up to the next tick.
+     * The deadlines of packets awaiting a reply are kept in the timer wheel in either mode.
+     *
+     * \param enable Whether to enable the low-footprint mode.
+     * The low-footprint mode is disabled by default.
+     *
+     * \attention This function takes action when the client is in a non-operational state,
+     * meaning the \ref async_run function has not been invoked.
+     * Furthermore, you can use this function after the \ref cancel function has been called,
+     * before the \ref async_run function is invoked again.
+     */
+    mqtt_client& low_footprint(bool enable) {
+        _impl->low_footprint(enable);
+        return *this;
+    }
+
+    /**
+     * \brief Assign the maximum number of bytes \ref try_publish may queue
+     * for writing.
+     *
+     * \details Packets written with \ref try_publish are encoded into
+     * the Client's output buffer and kept there until they are written,
+     * which includes the time the Client spends reconnecting.
+     * Once the encoded packets waiting to be written exceed `bytes`,
+     * \ref try_publish returns `boost::asio::error::would_block`
+     * instead of queuing another packet.
+     *
+     * \param bytes The maximum size of packets queued by \ref try_publish.
+     * If this function is not invoked, the Client queues up to 1 MiB.
+     *
+     * \attention This function takes action when the client is in a non-operational state,
+     * meaning the \ref async_run function has not been invoked.
+     * Furthermore, you can use this function after the \ref cancel function has been called,
+     * before the \ref async_run function is invoked again.
+     */
+    mqtt_client& try_publish_buffer_size(size_t bytes) {
+        _impl->try_publish_buffer_size(bytes);
+        return *this;
+    }
+
+    /**
+     * \brief Enable or disable automatic assignment of Topic Aliases to published Topics.
+     *
+     * \details When enabled, the Client assigns a Topic Alias to each Topic it publishes to,
+     * up to the \__TOPIC_ALIAS_MAX\__ the Broker sent in the \__CONNACK\__ packet.
+     * Once the Broker has received a \__PUBLISH\__ packet mapping the alias,
+     * subsequent \__PUBLISH\__ packets to the same Topic are sent with the alias
+     * and an empty Topic. When all aliases are in use, the least recently used one
+     * is reassigned. The mappings are discarded whenever the Client reconnects.
+     *
+     * \param enable Whether to assign Topic Aliases automatically.
+     * Automatic assignment is disabled by default.
+     *
+     * \note Topic Aliases must not be set manually in \__PUBLISH_PROPS\__ while
+     * automatic assignment is enabled.
+     *
+     * \attention This function takes action when the client is in a non-operational state,
+     * meaning the \ref async_run function has not been invoked.
+     * Furthermore, you can use this function after the \ref cancel function has been called,
+     * before the \ref async_run function is invoked again.
+     */
+    mqtt_client& auto_topic_alias(bool enable) {
+        _impl->auto_topic_alias(enable);
+        return *this;
+    }
+
+    /**
+     * \brief Enable or disable automatic re-subscribing after the session is lost.
+     *
+     * \details When enabled, the Client keeps a registry of the Subscriptions
+     * the Broker has granted through \ref async_subscribe and removes the ones
+     * unsubscribed through \ref async_unsubscribe.
+     * If the Broker does not have a session for the Client after a reconnect,
+     * the registered Subscriptions are re-established in as few \__SUBSCRIBE\__ packets
+     * as the Broker's \__MAXIMUM_PACKET_SIZE\__ allows, sent before any other
+     * pending packet. Subscriptions subscribed with equal \__SUBSCRIBE_PROPS\__
+     * share the same \__SUBSCRIBE\__ packets.
+     *
+     * The \ref boost::mqtt5::client::error::session_expired error is then delivered
+     * to \ref async_receive only if some Subscriptions could not be re-established.
+     *
+     * \param enable Whether to re-subscribe automatically.
+     * Automatic re-subscribing is disabled by default.
+     *
+     * \attention This function takes action when the client is in a non-operational state,
+     * meaning the \ref async_run function has not been invoked.
+     * Furthermore, you can use this function after the \ref cancel function has been called,
+     * before the \ref async_run function is invoked again.
+     */
+    mqtt_client& auto_resubscribe(bool enable) {
+        _impl->auto_resubscribe(enable);
+        return *this;
+    }
+
+    /**
+     * \brief Enable or disable coalescing of \ref async_subscribe and \ref async_unsubscribe calls.
+     *
+     * \details When enabled, \ref async_subscribe calls initiated during the same
+     * executor turn are sent in a shared \__SUBSCRIBE\__ packet, provided that their
+     * \__SUBSCRIBE_PROPS\__ are equal and the packet does not exceed the Broker's
+     * \__MAXIMUM_PACKET_SIZE\__. Each call completes with the Reason Codes
+     * for its own Topic Filters from the shared \__SUBACK\__ packet.
+     * The same applies to \ref async_unsubscribe calls and \__UNSUBSCRIBE\__ packets.
+     *
+     * As a shared packet carries the requests of other calls, total and partial
+     * cancellation signals do not stop it from being resent, and coalesced calls
+     * complete only once the shared packet is answered. A terminal cancellation
+     * signal still cancels the Client and completes all of them.
+     *
+     * \param enable Whether to coalesce subscribe and unsubscribe requests.
+     * Coalescing is disabled by default.
+     *
+     * \attention This function takes action when the client is in a non-operational state,
+     * meaning the \ref async_run function has not been invoked.
+     * Furthermore, you can use this function after the \ref cancel function has been called,
+     * before the \ref async_run function is invoked again.
+     */
+    mqtt_client& coalesce_subscriptions(bool enable) {
+        _impl->coalesce_subscriptions(enable);
+        return *this;
+    }
+
     /**
      * \brief Assign \__CONNECT_PROPS\__ that will be sent in a \__CONNECT\__ packet.
      * \param props \__CONNECT_PROPS\__ sent in a \__CONNECT\__ packet.
@@ -429,6 +621,50 @@ public:
         return _impl->connack_properties();
     }
 
+    /**
+     * \brief Validate a Topic Name once, to publish to it repeatedly.
+     *
+     * \details Publishing to the returned \ref publish_topic with \ref async_publish
+     * or \ref try_publish skips the validation of the Topic Name, which is otherwise
+     * repeated on every call. This is useful when Application Messages are
+     * published to a small set of Topics over and over again.
+     *
+     * \param topic The Topic Name.
+     *
+     * \returns A \ref publish_topic holding the Topic Name, or an empty
+     * \ref publish_topic if the Topic Name is not valid.
+     */
+    static publish_topic make_topic(std::string topic) {
+        if (detail::validate_topic_name(topic) != detail::validation_result::valid)
+            return publish_topic {};
+        return publish_topic { std::move(topic) };
+    }
+
+    /**
+     * \brief Encode a Topic and \__PUBLISH_PROPS\__ once, to publish
+     * Application Messages with them repeatedly.
+     *
+     * \details Publishing with the returned \ref publish_template using
+     * \ref async_publish or \ref try_publish neither validates nor encodes
+     * the Topic and the properties again. Only the fixed header, the Packet
+     * Identifier and the Payload are encoded for each \__PUBLISH\__ packet,
+     * which makes a difference when the Payloads are small.
+     *
+     * The properties must not contain a Topic Alias, as Topic Aliases
+     * are only valid within a single Network Connection.
+     *
+     * \param topic The Topic Name.
+     * \param props An instance of \__PUBLISH_PROPS\__.
+     *
+     * \returns A \ref publish_template holding the encoded Topic and properties,
+     * or an empty \ref publish_template if either is not valid.
+     */
+    static publish_template make_publish_template(
+        std::string_view topic, const publish_props& props
+    ) {
+        return detail::make_publish_template(topic, props);
+    }
+
     /**
      * \brief Send a \__PUBLISH\__ packet to Broker to transport an
      * Application Message.
@@ -521,6 +757,149 @@ public:
         );
     }
 
+    /**
+     * \brief Send a \__PUBLISH\__ packet to Broker to transport an
+     * Application Message to a Topic validated by \ref make_topic.
+     *
+     * \details Behaves exactly like the \ref async_publish overload taking
+     * the Topic as a string, except that the Topic Name is not validated again.
+     * Publishing to an empty \ref publish_topic completes with
+     * \ref boost::mqtt5::client::error::invalid_topic.
+     *
+     * \tparam qos_type The \ref qos_e level of assurance for delivery.
+     * \param topic The Topic returned by \ref make_topic.
+     * \param payload The Application Message that is being published.
+     * \param retain The \ref retain_e flag.
+     * \param props An instance of \__PUBLISH_PROPS\__.
+     * \param token Completion token that will be used to produce a
+     * completion handler. The handler will be invoked when the operation completes.
+     */
+    template <qos_e qos_type,
+        typename CompletionToken =
+            typename asio::default_completion_token<executor_type>::type
+    >
+    decltype(auto) async_publish(
+        publish_topic topic, std::string payload,
+        retain_e retain, const publish_props& props,
+        CompletionToken&& token = {}
+    ) {
+        using Signature = detail::on_publish_signature<qos_type>;
+        return asio::async_initiate<CompletionToken, Signature>(
+            detail::initiate_async_publish<client_service_type, qos_type>(_impl),
+            token,
+            std::move(topic), std::move(payload), retain, props
+        );
+    }
+
+    /**
+     * \brief Send a \__PUBLISH\__ packet built from a \ref publish_template
+     * to Broker to transport an Application Message.
+     *
+     * \details Behaves exactly like the \ref async_publish overload taking
+     * the Topic and the properties, except that they are neither validated
+     * nor encoded again. Topic Aliases are never assigned automatically.
+     * Publishing with an empty \ref publish_template completes with
+     * \ref boost::mqtt5::client::error::invalid_topic.
+     *
+     * \tparam qos_type The \ref qos_e level of assurance for delivery.
+     * \param tmpl The template returned by \ref make_publish_template.
+     * \param payload The Application Message that is being published.
+     * \param retain The \ref retain_e flag.
+     * \param token Completion token that will be used to produce a
+     * completion handler. The handler will be invoked when the operation completes.
+     */
+    template <qos_e qos_type,
+        typename CompletionToken =
+            typename asio::default_completion_token<executor_type>::type
+    >
+    decltype(auto) async_publish(
+        publish_template tmpl, std::string payload, retain_e retain,
+        CompletionToken&& token = {}
+    ) {
+        using Signature = detail::on_publish_signature<qos_type>;
+        return asio::async_initiate<CompletionToken, Signature>(
+            detail::initiate_async_publish<client_service_type, qos_type>(_impl),
+            token,
+            std::move(tmpl), std::move(payload), retain
+        );
+    }
+
+    /**
+     * \brief Write a \__PUBLISH\__ packet with \ref qos_e `qos_e::at_most_once`
+     * to Broker without waiting for it to be written.
+     *
+     * \details The packet is validated and encoded directly into the Client's
+     * output buffer, and is written to the transport together with the next
+     * batch of outgoing packets. No completion handler is allocated or invoked,
+     * making this the cheapest way to publish Application Messages that
+     * do not need any assurance of delivery.
+     *
+     * This function must be called from within the Client's executor
+     * (for instance, from a completion handler of another operation).
+     *
+     * Unlike \ref async_publish, this function never assigns a Topic Alias
+     * automatically. Packets that have not been written when the connection
+     * is lost are written after the Client reconnects, except for packets
+     * carrying a Topic Alias, which are discarded because the new
+     * connection does not know the alias. Packets that have not been written
+     * when the Client is cancelled are discarded.
+     * At most \ref try_publish_buffer_size bytes of packets are queued.
+     *
+     * \param topic Identification of the information channel to which
+     * Payload data is published.
+     * \param payload The Application Message that is being published.
+     * \param retain The \ref retain_e flag.
+     * \param props An instance of \__PUBLISH_PROPS\__.
+     *
+     * \returns An empty \__ERROR_CODE\__ if the packet has been queued
+     * for writing, or one of the following error codes otherwise:\n
+     *        - \ref boost::mqtt5::client::error::malformed_packet
+     *        - \ref boost::mqtt5::client::error::packet_too_large
+     *        - \ref boost::mqtt5::client::error::qos_not_supported
+     *        - \ref boost::mqtt5::client::error::retain_not_available
+     *        - \ref boost::mqtt5::client::error::topic_alias_maximum_reached
+     *        - \ref boost::mqtt5::client::error::invalid_topic
+     *        - `boost::asio::error::would_block`
+     *
+     * Refer to the section on \__ERROR_HANDLING\__ to find the underlying causes for each error code.
+     */
+    error_code try_publish(
+        std::string_view topic, std::string_view payload,
+        retain_e retain, const publish_props& props
+    ) {
+        return detail::publish_detached(*_impl, topic, payload, retain, props);
+    }
+
+    /**
+     * \brief Write a \__PUBLISH\__ packet with \ref qos_e `qos_e::at_most_once`
+     * to a Topic validated by \ref make_topic, without waiting for it to be written.
+     *
+     * \details Behaves exactly like the \ref try_publish overload taking
+     * the Topic as a string, except that the Topic Name is not validated again.
+     */
+    error_code try_publish(
+        const publish_topic& topic, std::string_view payload,
+        retain_e retain, const publish_props& props
+    ) {
+        return detail::publish_detached(
+            *_impl, topic.name(), payload, retain, props, !topic.empty()
+        );
+    }
+
+    /**
+     * \brief Write a \__PUBLISH\__ packet with \ref qos_e `qos_e::at_most_once`
+     * built from a \ref publish_template, without waiting for it to be written.
+     *
+     * \details Behaves exactly like the \ref try_publish overload taking
+     * the Topic and the properties, except that they are neither validated
+     * nor encoded again.
+     */
+    error_code try_publish(
+        const publish_template& tmpl, std::string_view payload, retain_e retain
+    ) {
+        return detail::publish_detached(*_impl, tmpl, payload, retain);
+    }
+
     /**
      * \brief Send a \__SUBSCRIBE\__ packet to Broker to create a subscription
      * to one or more Topics of interest.
@@ -810,6 +1189,13 @@ public:
      * \note It is only recommended to call this function if you have established
      * a successful subscription to a Topic using the \ref async_subscribe function.
      *
+     * \note If zero-copy delivery was enabled with \ref zero_copy_receive,
+     * Application Messages are delivered through \ref async_receive_view instead.
+     *
+     * \note If a non-zero \__TOPIC_ALIAS_MAX\__ was set with \ref connect_property,
+     * Topic Aliases used by the Broker are resolved by the Client and the
+     * Application Message is delivered with the full Topic.
+     *
      * \param token Completion token that will be used to produce a
      * completion handler. The handler will be invoked when the operation completes.
      * On immediate completion, invocation of the handler will be performed in a manner
@@ -854,6 +1240,61 @@ public:
         return _impl->async_channel_receive(std::forward<CompletionToken>(token));
     }
 
+    /**
+     * \brief Asynchronously receive an Application Message without copying it.
+     *
+     * \details This function behaves like \ref async_receive, except that the
+     * Application Message is delivered as a \ref publish_view whose Topic and Payload
+     * refer to the buffer the \__PUBLISH\__ packet was read into.
+     * The buffer stays valid until the \ref publish_view is released.
+     *
+     * \note Application Messages are delivered through this function only if
+     * zero-copy delivery was enabled with \ref zero_copy_receive.
+     *
+     * \param token Completion token that will be used to produce a
+     * completion handler. The handler will be invoked when the operation completes.
+     * On immediate completion, invocation of the handler will be performed in a manner
+     * equivalent to using \__POST\__.
+     *
+     * \par Handler signature
+     * The handler signature for this operation:
+     *    \code
+     *        void (
+     *            __ERROR_CODE__, // Result of operation.
+     *            boost::mqtt5::publish_view // The received Application Message.
+     *        )
+     *    \endcode
+     *
+     * \par Completion condition
+     *    The asynchronous operation will complete when one of the following conditions is true:\n
+     *        - The Client has a pending Application Message in its internal storage
+     *        ready to be received.
+     *        - An error occurred. This is indicated by an associated \__ERROR_CODE\__ in the handler.\n
+     *
+     *    \par Error codes
+     *    The list of all possible error codes that this operation can finish with:\n
+     *        - `boost::system::errc::errc_t::success`\n
+     *        - `boost::asio::error::operation_aborted`\n
+     *        - \ref boost::mqtt5::client::error::session_expired
+     *
+     * Refer to the section on \__ERROR_HANDLING\__ to find the underlying causes for each error code.
+     *
+     *    \par Per-Operation Cancellation
+     *    This asynchronous operation supports cancellation for the following \__CANCELLATION_TYPE\__ values:\n
+     *        - `cancellation_type::terminal` \n
+     *        - `cancellation_type::partial` \n
+     *        - `cancellation_type::total` \n
+     */
+    template <
+        typename CompletionToken =
+            typename asio::default_completion_token<executor_type>::type
+    >
+    decltype(auto) async_receive_view(CompletionToken&& token = {}) {
+        return _impl->async_channel_receive_view(
+            std::forward<CompletionToken>(token)
+        );
+    }
+
     /**
      * \brief Disconnect the Client by sending a \__DISCONNECT\__ packet
      * with a specified Reason Code. This function has terminal effects.
@@ -12,6 +12,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -151,20 +152,56 @@ class properties {
         constexpr static std::string_view name = name_v<p>;
         value_type_t<p> value;
     };
-    std::tuple<property<Ps>...> _props;
+    using storage_type = std::tuple<property<Ps>...>;
+
+    // Allocated on the first non-const access. Most packets carry
+    // no properties, and a set of properties that was never written
+    // to is a single null pointer to construct, move and destroy.
+    // Reads through a const reference never allocate: the values of
+    // a set that was never written to are those of empty_storage.
+    std::unique_ptr<storage_type> _props;
+    static inline const storage_type empty_storage {};
+
+    storage_type& storage() {
+        if (!_props)
+            _props = std::make_unique<storage_type>();
+        return *_props;
+    }
+
+    constexpr const storage_type& storage() const noexcept {
+        return _props ? *_props : empty_storage;
+    }
 
 public:
+    constexpr properties() noexcept = default;
 
+    properties(const properties& other) :
+        _props(other._props ? std::make_unique<storage_type>(*other._props) : nullptr)
+    {}
+
+    properties(properties&&) noexcept = default;
+
+    properties& operator=(const properties& other) {
+        _props = other._props ?
+            std::make_unique<storage_type>(*other._props) : nullptr;
+        return *this;
+    }
+
+    properties& operator=(properties&&) noexcept = default;
+
+    ~properties() = default;
+
+    // May allocate the storage of the properties; read through
+    // a const reference to avoid it.
     template <property_type v>
-    constexpr auto& operator[](std::integral_constant<property_type, v>)
-    noexcept {
-        return std::get<property<v>>(_props).value;
+    auto& operator[](std::integral_constant<property_type, v>) {
+        return std::get<property<v>>(storage()).value;
     }
 
     template <property_type v>
     constexpr const auto& operator[](std::integral_constant<property_type, v>)
     const noexcept {
-        return std::get<property<v>>(_props).value;
+        return std::get<property<v>>(storage()).value;
     }
 
     template <typename Func>
@@ -181,8 +218,10 @@ public:
         typename Func,
         std::enable_if_t<is_apply_on<Func>::value, bool> = true
     >
-    constexpr bool apply_on(uint8_t property_id, Func&& func)
-    noexcept (is_nothrow_apply_on<Func>::value) {
+    bool apply_on(uint8_t property_id, Func&& func) {
+        if (((Ps != property_id) && ...))
+            return true;
+
         return std::apply(
             [&func, property_id](auto&... ptype) {
                 auto pc = [&func, property_id](auto& px) {
@@ -194,7 +233,7 @@ public:
                 };
                 return (pc(ptype) && ...);
             },
-            _props
+            storage()
         );
     }
 
@@ -223,7 +262,7 @@ public:
                 };
                 return (pc(props) &&...);
             },
-            _props
+            storage()
         );
     }
 
@@ -231,8 +270,7 @@ public:
         typename Func,
         std::enable_if_t<is_visitor<Func>::value, bool> = true
     >
-    constexpr bool visit(Func&& func)
-    noexcept (is_nothrow_visitor<Func>::value) {
+    bool visit(Func&& func) {
         return std::apply(
             [&func](auto&... props) {
                 auto pc = [&func](auto& px) {
@@ -242,7 +280,7 @@ public:
                 };
                 return (pc(props) && ...);
             },
-            _props
+            storage()
         );
     }
 };
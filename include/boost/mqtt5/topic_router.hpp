@@ -0,0 +1,512 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MQTT5_TOPIC_ROUTER_HPP
+#define BOOST_MQTT5_TOPIC_ROUTER_HPP
+
+#include <boost/mqtt5/error.hpp>
+#include <boost/mqtt5/property_types.hpp>
+#include <boost/mqtt5/reason_codes.hpp>
+#include <boost/mqtt5/types.hpp>
+
+#include <boost/mqtt5/detail/topic_trie.hpp>
+#include <boost/mqtt5/detail/topic_validation.hpp>
+
+#include <boost/mqtt5/impl/route_op.hpp>
+
+#include <boost/asio/async_result.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace boost::mqtt5 {
+
+namespace asio = boost::asio;
+
+/**
+ * \brief Dispatches received Application Messages to handlers
+ * registered per Topic Filter.
+ *
+ * \details Topic Filters may contain the single-level (`+`) and the
+ * multi-level (`#`) wildcard characters. A Shared Subscription filter
+ * (`$share/{ShareName}/{filter}`) matches the same Topic Names as its `{filter}` part.
+ * Topic Names beginning with `$` are not matched by filters beginning
+ * with a wildcard character.
+ *
+ * Filters are stored in a trie with one node per Topic level, so the cost of routing
+ * a message depends on the number of levels in its Topic and the number of
+ * wildcard branches along the way, not on the number of registered filters.
+ *
+ * Handlers can also be registered per Subscription Identifier, see \ref add_subscription
+ * and \ref async_subscribe. Application Messages carrying Subscription Identifiers
+ * are dispatched to those handlers by a lookup in a flat table, without
+ * matching the Topic at all.
+ *
+ * \par Thread safety
+ * Distinct objects: safe. \n
+ * Shared objects: unsafe. \n
+ * Handlers must not add or remove routes while a message is being routed.
+ *
+ * \see \ref async_route, \ref async_subscribe
+ */
+class topic_router {
+public:
+    /**
+     * \brief Type of the handler invoked with every matching Application Message.
+     *
+     * \details The handler signature:
+     *    \code
+     *        void (
+     *            std::string_view, // Topic, the origin of the Application Message.
+     *            std::string_view, // Payload, the content of the Application Message.
+     *            const publish_props& // Properties received in the PUBLISH packet.
+     *        )
+     *    \endcode
+     */
+    using handler_type = std::function<
+        void (std::string_view, std::string_view, const publish_props&)
+    >;
+
+private:
+    using entry_id = detail::topic_trie::value_type;
+    static constexpr entry_id npos = detail::topic_trie::npos;
+
+    struct entry {
+        std::string filter;
+        handler_type handler;
+        entry_id next = npos; // next entry with the same routing key
+        int32_t owner = 0; // Subscription Identifier owning the entry, if any
+    };
+
+    struct subscription {
+        handler_type handler;
+        std::vector<entry_id> entries; // Topic Filter entries it owns
+    };
+
+    detail::topic_trie _trie;
+    std::vector<entry> _entries;
+    std::vector<entry_id> _free_entries;
+
+    // Subscription Identifier id is stored at index id - 1.
+    std::vector<subscription> _subscriptions;
+    std::vector<int32_t> _free_subscriptions;
+
+    template <typename ClientType, typename Router, typename Handler>
+    friend class detail::subscribe_route_op;
+
+public:
+    /// Constructs an empty router.
+    topic_router() = default;
+
+    /**
+     * \brief Registers a handler for the Topic Filter.
+     *
+     * \details If a handler is already registered for the exact same Topic Filter,
+     * it is replaced.
+     *
+     * \param filter The Topic Filter.
+     * \param handler The handler invoked with every Application Message
+     * whose Topic matches the filter.
+     *
+     * \returns \ref boost::mqtt5::client::error::invalid_topic if the Topic Filter
+     * is not valid, a default-constructed \__ERROR_CODE\__ otherwise.
+     */
+    error_code add(std::string_view filter, handler_type handler) {
+        auto key = routing_key(filter);
+        if (!key)
+            return client::error::invalid_topic;
+
+        auto head = _trie.find(*key);
+        for (auto id = head; id != npos; id = _entries[id].next)
+            if (_entries[id].filter == filter && !_entries[id].owner) {
+                _entries[id].handler = std::move(handler);
+                return error_code {};
+            }
+
+        _trie.insert(*key, new_entry(filter, std::move(handler), head));
+        return error_code {};
+    }
+
+    /**
+     * \brief Removes the handler registered for the Topic Filter.
+     *
+     * \param filter The Topic Filter used in \ref add.
+     *
+     * \returns `true` if a handler was removed.
+     */
+    bool remove(std::string_view filter) {
+        return remove_entry(filter, 0);
+    }
+
+    /**
+     * \brief Registers a handler for a new Subscription Identifier.
+     *
+     * \details The returned Subscription Identifier should be set in the
+     * \__SUBSCRIBE_PROPS\__ of a \__SUBSCRIBE\__ packet. Every Application Message
+     * the Broker forwards for that subscription carries the identifier and is
+     * dispatched to the handler without matching its Topic.
+     * Identifiers of removed subscriptions are reused.
+     * Handlers registered with \ref async_subscribe are also identified this way.
+     *
+     * \param handler The handler invoked with every Application Message
+     * carrying the Subscription Identifier.
+     *
+     * \returns The Subscription Identifier, or 0 if all identifiers are in use.
+     *
+     * \see \ref async_subscribe
+     */
+    int32_t add_subscription(handler_type handler) {
+        if (!_free_subscriptions.empty()) {
+            auto id = _free_subscriptions.back();
+            _free_subscriptions.pop_back();
+            _subscriptions[id - 1].handler = std::move(handler);
+            return id;
+        }
+
+        if (_subscriptions.size() == size_t(detail::max_subscription_identifier))
+            return 0;
+
+        _subscriptions.push_back({ std::move(handler), {} });
+        return static_cast<int32_t>(_subscriptions.size());
+    }
+
+    /**
+     * \brief Removes the handler registered for the Subscription Identifier.
+     *
+     * \details The handlers registered per Topic Filter by \ref async_subscribe
+     * for the same subscription are removed as well.
+     *
+     * \param id The Subscription Identifier returned from \ref add_subscription
+     * or passed to the handler of \ref async_subscribe.
+     *
+     * \returns `true` if a handler was removed.
+     */
+    bool remove_subscription(int32_t id) {
+        if (!subscription_handler(id))
+            return false;
+
+        auto& sub = _subscriptions[id - 1];
+        for (auto entry_id : sub.entries)
+            unlink_entry(entry_id);
+        sub.entries.clear();
+        sub.handler = nullptr;
+        _free_subscriptions.push_back(id);
+        return true;
+    }
+
+    /**
+     * \brief Invokes the handlers of all Subscription Identifiers carried by
+     * the Application Message and of all Topic Filters matching the Topic.
+     *
+     * \param topic The Topic of the Application Message.
+     * \param payload The Payload of the Application Message.
+     * \param props The \__PUBLISH_PROPS\__ of the Application Message.
+     *
+     * \returns The number of handlers invoked.
+     */
+    size_t route(
+        std::string_view topic, std::string_view payload,
+        const publish_props& props
+    ) const {
+        size_t invoked = 0;
+        for (auto id : props[prop::subscription_identifier])
+            if (auto* handler = subscription_handler(id)) {
+                (*handler)(topic, payload, props);
+                ++invoked;
+            }
+
+        if (_trie.empty())
+            return invoked;
+
+        _trie.match(topic, [&](entry_id head) {
+            for (auto id = head; id != npos; id = _entries[id].next, ++invoked)
+                _entries[id].handler(topic, payload, props);
+        });
+        return invoked;
+    }
+
+    /**
+     * \brief Invokes the handlers of all Topic Filters matching the Topic
+     * of the Application Message.
+     *
+     * \returns The number of handlers invoked.
+     */
+    size_t route(const publish_view& message) const {
+        return route(message.topic(), message.payload(), message.props());
+    }
+
+    /// Returns the number of registered handlers.
+    size_t size() const noexcept {
+        return _entries.size() - _free_entries.size() +
+            _subscriptions.size() - _free_subscriptions.size();
+    }
+
+    /// Returns `true` if there are no registered handlers.
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    /// Removes all registered handlers.
+    void clear() {
+        _trie.clear();
+        _entries.clear();
+        _free_entries.clear();
+        _subscriptions.clear();
+        _free_subscriptions.clear();
+    }
+
+private:
+    const handler_type* subscription_handler(int32_t id) const {
+        if (
+            id < 1 || size_t(id) > _subscriptions.size() ||
+            !_subscriptions[id - 1].handler
+        )
+            return nullptr;
+        return &_subscriptions[id - 1].handler;
+    }
+
+    // Registers a handler for the Topic Filter on behalf of the subscription,
+    // next to any handler already registered for the same filter.
+    bool add_owned(std::string_view filter, int32_t owner, handler_type handler) {
+        auto key = routing_key(filter);
+        if (!key || !subscription_handler(owner))
+            return false;
+
+        auto id = new_entry(filter, std::move(handler), _trie.find(*key), owner);
+        _trie.insert(*key, id);
+        _subscriptions[owner - 1].entries.push_back(id);
+        return true;
+    }
+
+    // Removes the handler registered for the Topic Filter
+    // on behalf of the subscription.
+    bool remove_owned(std::string_view filter, int32_t owner) {
+        if (!subscription_handler(owner) || !remove_entry(filter, owner))
+            return false;
+
+        auto& entries = _subscriptions[owner - 1].entries;
+        entries.erase(
+            std::remove_if(
+                entries.begin(), entries.end(),
+                [this](entry_id id) { return _entries[id].filter.empty(); }
+            ),
+            entries.end()
+        );
+        return true;
+    }
+
+    bool remove_entry(std::string_view filter, int32_t owner) {
+        auto key = routing_key(filter);
+        if (!key)
+            return false;
+
+        for (auto id = _trie.find(*key); id != npos; id = _entries[id].next)
+            if (_entries[id].filter == filter && _entries[id].owner == owner) {
+                unlink_entry(id, *key);
+                return true;
+            }
+
+        return false;
+    }
+
+    void unlink_entry(entry_id id) {
+        auto filter = _entries[id].filter;
+        unlink_entry(id, *routing_key(filter));
+    }
+
+    void unlink_entry(entry_id id, std::string_view key) {
+        auto prev = npos;
+        for (auto it = _trie.find(key); it != id; it = _entries[it].next)
+            prev = it;
+
+        auto next = _entries[id].next;
+        if (prev != npos)
+            _entries[prev].next = next;
+        else if (next != npos)
+            _trie.insert(key, next);
+        else
+            _trie.erase(key);
+
+        free_entry(id);
+    }
+
+    // Shared Subscriptions are routed by their Topic Filter part.
+    static std::optional<std::string_view> routing_key(std::string_view filter) {
+        using namespace detail;
+
+        if (filter.compare(0, shared_sub_prefix.size(), shared_sub_prefix) != 0) {
+            if (validate_topic_filter(filter) != validation_result::valid)
+                return std::nullopt;
+            return filter;
+        }
+
+        if (validate_shared_topic_filter(filter) != validation_result::valid)
+            return std::nullopt;
+
+        filter.remove_prefix(shared_sub_prefix.size());
+        return filter.substr(filter.find('/') + 1);
+    }
+
+    entry_id new_entry(
+        std::string_view filter, handler_type handler, entry_id next,
+        int32_t owner = 0
+    ) {
+        entry e { std::string(filter), std::move(handler), next, owner };
+        if (_free_entries.empty()) {
+            _entries.push_back(std::move(e));
+            return static_cast<entry_id>(_entries.size() - 1);
+        }
+
+        auto id = _free_entries.back();
+        _free_entries.pop_back();
+        _entries[id] = std::move(e);
+        return id;
+    }
+
+    void free_entry(entry_id id) {
+        _entries[id] = entry {};
+        _free_entries.push_back(id);
+    }
+};
+
+/**
+ * \brief Receives Application Messages with \ref mqtt_client::async_receive
+ * and dispatches each of them through the \ref topic_router.
+ *
+ * \details If zero-copy delivery was enabled with \ref mqtt_client::zero_copy_receive,
+ * Application Messages are received with \ref mqtt_client::async_receive_view instead,
+ * and routed without being copied.
+ * The Client and the Router must outlive the operation.
+ *
+ * \param client The Client used to receive Application Messages.
+ * \param router The Router that dispatches received Application Messages.
+ * \param token Completion token that will be used to produce a
+ * completion handler. The handler will be invoked when the operation completes.
+ *
+ * \par Handler signature
+ * The handler signature for this operation:
+ *    \code
+ *        void (
+ *            __ERROR_CODE__ // Result of operation.
+ *        )
+ *    \endcode
+ *
+ * \par Completion condition
+ *    The asynchronous operation will complete when \ref mqtt_client::async_receive
+ *    (or \ref mqtt_client::async_receive_view) completes with an error. The error is passed to the handler.
+ *
+ *    \par Error codes
+ *    The list of all possible error codes that this operation can finish with:\n
+ *        - `boost::asio::error::operation_aborted`\n
+ *        - \ref boost::mqtt5::client::error::session_expired
+ *
+ *    \par Per-Operation Cancellation
+ *    This asynchronous operation supports cancellation for the following \__CANCELLATION_TYPE\__ values:\n
+ *        - `cancellation_type::terminal` \n
+ *        - `cancellation_type::partial` \n
+ *        - `cancellation_type::total` \n
+ */
+template <
+    typename ClientType,
+    typename CompletionToken =
+        typename asio::default_completion_token<
+            typename ClientType::executor_type
+        >::type
+>
+decltype(auto) async_route(
+    ClientType& client, topic_router& router,
+    CompletionToken&& token = {}
+) {
+    using Signature = void (error_code);
+    return asio::async_initiate<CompletionToken, Signature>(
+        detail::initiate_async_route(client, router), token
+    );
+}
+
+/**
+ * \brief Subscribes to Topics with \ref mqtt_client::async_subscribe and registers
+ * a handler in the \ref topic_router for Application Messages matching them.
+ *
+ * \details The handler is registered under a new Subscription Identifier assigned with
+ * \ref topic_router::add_subscription, which is passed to the completion handler.
+ * If the Broker supports Subscription Identifiers, the identifier is sent in the
+ * \__SUBSCRIBE_PROPS\__, replacing any Subscription Identifier set in `props`,
+ * and received Application Messages are routed to the handler by the identifier alone.
+ * Otherwise, the handler is also registered for each of the Topic Filters,
+ * next to any handler already registered for them with \ref topic_router::add.
+ *
+ * The handler is removed from the Router if the subscription fails.
+ * After unsubscribing, remove it with \ref topic_router::remove_subscription,
+ * which releases the identifier for reuse.
+ * The Client and the Router must outlive the operation.
+ *
+ * \param client The Client used to subscribe.
+ * \param router The Router in which the handler is registered.
+ * \param topics A list of \ref subscribe_topic of interest.
+ * \param props An instance of \__SUBSCRIBE_PROPS\__.
+ * \param handler The handler invoked with every Application Message
+ * forwarded by the Broker for this subscription.
+ * \param token Completion token that will be used to produce a
+ * completion handler. The handler will be invoked when the operation completes.
+ *
+ * \par Handler signature
+ * The handler signature for this operation:
+ *    \code
+ *        void (
+ *            __ERROR_CODE__,    // Result of operation.
+ *            std::vector<__REASON_CODE__>,  // Vector of Reason Codes indicating
+ *                                           // the subscription result for each Topic
+ *                                           // in the SUBSCRIBE packet.
+ *            __SUBACK_PROPS__,  // Properties received in the SUBACK packet.
+ *            int32_t            // Subscription Identifier of the handler in the Router,
+ *                               // or 0 if the subscription failed.
+ *        )
+ *    \endcode
+ *
+ *    \par Completion condition
+ *    The asynchronous operation will complete when \ref mqtt_client::async_subscribe completes.
+ *
+ *    \par Error codes
+ *    The same error codes as \ref mqtt_client::async_subscribe, except for
+ *    \ref boost::mqtt5::client::error::subscription_identifier_not_available, and:\n
+ *        - `boost::asio::error::no_buffer_space` if all Subscription Identifiers
+ *          of the Router are in use.
+ *
+ *    \par Per-Operation Cancellation
+ *    The same as \ref mqtt_client::async_subscribe.
+ */
+template <
+    typename ClientType,
+    typename CompletionToken =
+        typename asio::default_completion_token<
+            typename ClientType::executor_type
+        >::type
+>
+decltype(auto) async_subscribe(
+    ClientType& client, topic_router& router,
+    const std::vector<subscribe_topic>& topics, const subscribe_props& props,
+    topic_router::handler_type handler,
+    CompletionToken&& token = {}
+) {
+    using Signature = void (
+        error_code, std::vector<reason_code>, suback_props, int32_t
+    );
+    return asio::async_initiate<CompletionToken, Signature>(
+        detail::initiate_async_subscribe_route(client, router), token,
+        topics, props, std::move(handler)
+    );
+}
+
+} // end namespace boost::mqtt5
+
+#endif // !BOOST_MQTT5_TOPIC_ROUTER_HPP
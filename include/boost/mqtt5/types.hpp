@@ -10,10 +10,17 @@
 
 #include <boost/mqtt5/property_types.hpp>
 
+#include <boost/mqtt5/detail/raw_props.hpp>
+
 #include <boost/system/error_code.hpp>
 
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <utility>
 
 namespace boost::mqtt5 {
 
@@ -363,6 +370,283 @@ public:
     }
 };
 
+/**
+ * \brief A Topic Name validated once, to be published to repeatedly.
+ *
+ * \details Obtained with \ref mqtt_client::make_topic. Publishing to
+ * a `publish_topic` skips the validation of the Topic Name that is otherwise
+ * performed on every call to \ref mqtt_client::async_publish
+ * and \ref mqtt_client::try_publish.
+ *
+ * Copies of a `publish_topic` share the same Topic Name, so they
+ * are cheap to make. A default-constructed `publish_topic` is empty,
+ * and publishing to it fails with \ref client::error::invalid_topic.
+ */
+class publish_topic {
+    std::shared_ptr<const std::string> _name;
+
+public:
+    /// Constructs an empty Topic.
+    publish_topic() = default;
+
+    /// \cond internal
+    explicit publish_topic(std::string name) :
+        _name(std::make_shared<const std::string>(std::move(name)))
+    {}
+    /// \endcond
+
+    /// Get the Topic Name.
+    std::string_view name() const noexcept {
+        return _name ? std::string_view { *_name } : std::string_view {};
+    }
+
+    /// Returns `true` if the Topic is empty.
+    bool empty() const noexcept {
+        return !_name;
+    }
+};
+
+/**
+ * \brief A Topic and \__PUBLISH_PROPS\__ encoded once, to publish
+ * Application Messages with repeatedly.
+ *
+ * \details Obtained with \ref mqtt_client::make_publish_template.
+ * Publishing with a `publish_template` writes the encoded Topic and
+ * properties as they are, so only the fixed header, the Packet Identifier
+ * and the Payload are encoded for each \__PUBLISH\__ packet.
+ *
+ * Copies of a `publish_template` share the encoded data, so they
+ * are cheap to make. A default-constructed `publish_template` is empty,
+ * and publishing with it fails with \ref client::error::invalid_topic.
+ */
+class publish_template {
+    std::shared_ptr<const std::string> _encoded;
+    size_t _topic_size = 0;
+    bool _utf8_payload = false;
+
+public:
+    /// Constructs an empty template.
+    publish_template() = default;
+
+    /// \cond internal
+    publish_template(std::string encoded, size_t topic_size, bool utf8_payload) :
+        _encoded(std::make_shared<const std::string>(std::move(encoded))),
+        _topic_size(topic_size), _utf8_payload(utf8_payload)
+    {}
+
+    // The Topic Name, preceded by its length.
+    std::string_view encoded_topic() const noexcept {
+        return encoded().substr(0, _topic_size);
+    }
+
+    // The properties, preceded by the Property Length.
+    std::string_view encoded_props() const noexcept {
+        return encoded().substr(_topic_size);
+    }
+
+    // The Payload must be UTF-8 Encoded Character Data.
+    bool utf8_payload() const noexcept {
+        return _utf8_payload;
+    }
+    /// \endcond
+
+    /// Get the Topic Name.
+    std::string_view topic() const noexcept {
+        auto topic = encoded_topic();
+        return topic.empty() ? topic : topic.substr(2);
+    }
+
+    /// Returns `true` if the template is empty.
+    bool empty() const noexcept {
+        return !_encoded;
+    }
+
+private:
+    std::string_view encoded() const noexcept {
+        return _encoded ? std::string_view { *_encoded } : std::string_view {};
+    }
+};
+
+/**
+ * \brief A range of the User Properties of a received \__PUBLISH\__ packet,
+ * read directly from the encoded properties.
+ *
+ * \details Iterating yields `std::pair<std::string_view, std::string_view>`
+ * key-value pairs referring to the buffer of the \ref publish_view the range
+ * was obtained from. Iteration stops at the first property that is not
+ * well-formed.
+ */
+class user_property_range {
+    std::string_view _raw;
+
+public:
+    /// Forward iterator over the User Properties.
+    class iterator {
+        detail::raw_publish_props _reader;
+        std::pair<std::string_view, std::string_view> _current;
+        bool _end = true;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<std::string_view, std::string_view>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        iterator() = default;
+
+        /// \cond internal
+        explicit iterator(std::string_view raw) :
+            _reader(raw), _end(false)
+        {
+            ++*this;
+        }
+        /// \endcond
+
+        reference operator*() const noexcept { return _current; }
+        pointer operator->() const noexcept { return &_current; }
+
+        iterator& operator++() {
+            detail::raw_property p;
+            while (!_reader.at_end() && _reader.next(p))
+                if (p.id == prop::user_property_t) {
+                    _current = { p.first, p.second };
+                    return *this;
+                }
+            _end = true;
+            _current = {};
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto it = *this;
+            ++*this;
+            return it;
+        }
+
+        friend bool operator==(const iterator& a, const iterator& b) noexcept {
+            if (a._end || b._end)
+                return a._end == b._end;
+            return a._reader.position() == b._reader.position();
+        }
+
+        friend bool operator!=(const iterator& a, const iterator& b) noexcept {
+            return !(a == b);
+        }
+    };
+
+    /// Constructs an empty range.
+    user_property_range() = default;
+
+    /// \cond internal
+    explicit user_property_range(std::string_view raw) : _raw(raw) {}
+    /// \endcond
+
+    iterator begin() const {
+        return iterator { _raw };
+    }
+
+    iterator end() const noexcept {
+        return iterator {};
+    }
+};
+
+/**
+ * \brief A view of an Application Message received in a \__PUBLISH\__ packet.
+ *
+ * \details The Topic and the Payload are not copied out of the \__PUBLISH\__ packet.
+ * They refer directly to the reference-counted buffer the Client read
+ * the packet into. The buffer stays alive as long as at least one
+ * `publish_view` referring to it exists, so the views remain valid
+ * until the message is released.
+ *
+ * The \__PUBLISH_PROPS\__ are kept in their encoded form and decoded
+ * on the first call to \ref props. Messages whose properties are never
+ * looked at, or only through \ref user_properties, are delivered without
+ * allocating memory for their properties.
+ *
+ * \note Release the message (by calling \ref release or destroying the object)
+ * as soon as it is processed. While the buffer is referenced, the Client
+ * reads further data into a newly allocated buffer.
+ *
+ * \see \ref mqtt_client::async_receive_view
+ */
+class publish_view {
+    std::shared_ptr<const std::string> _buffer;
+    std::shared_ptr<const std::string> _topic_buffer;
+    std::string_view _topic;
+    std::string_view _payload;
+    std::string_view _raw_props;
+    mutable publish_props _props;
+    mutable bool _props_decoded = true;
+
+public:
+    /// Constructs an empty message.
+    publish_view() = default;
+
+    /// \cond internal
+    publish_view(
+        std::shared_ptr<const std::string> buffer,
+        std::string_view topic, std::string_view payload,
+        std::string_view raw_props,
+        std::shared_ptr<const std::string> topic_buffer = nullptr
+    ) :
+        _buffer(std::move(buffer)), _topic_buffer(std::move(topic_buffer)),
+        _topic(topic), _payload(payload), _raw_props(raw_props),
+        _props_decoded(raw_props.empty())
+    {}
+    /// \endcond
+
+    /// Get the Topic, the origin of the Application Message.
+    std::string_view topic() const noexcept {
+        return _topic;
+    }
+
+    /// Get the Payload, the content of the Application Message.
+    std::string_view payload() const noexcept {
+        return _payload;
+    }
+
+    /**
+     * \brief Get the \__PUBLISH_PROPS\__ received in the \__PUBLISH\__ packet.
+     *
+     * \details The properties are decoded on the first call. Calling this
+     * function concurrently on the same object requires synchronization.
+     */
+    const publish_props& props() const {
+        if (!_props_decoded) {
+            // the properties were validated when the packet was received
+            detail::decode_raw_publish_props(_raw_props, _props);
+            _props_decoded = true;
+        }
+        return _props;
+    }
+
+    /**
+     * \brief Get the User Properties received in the \__PUBLISH\__ packet,
+     * without decoding the other properties.
+     */
+    user_property_range user_properties() const noexcept {
+        return user_property_range { _raw_props };
+    }
+
+    /**
+     * \brief Releases the reference to the receive buffer.
+     *
+     * \details After this call, \ref topic and \ref payload return empty views.
+     * Properties that have not been decoded with \ref props before this call
+     * are discarded, so call \ref props first to keep them.
+     */
+    void release() noexcept {
+        _raw_props = {};
+        _props_decoded = true;
+        _topic = {};
+        _payload = {};
+        _buffer.reset();
+        _topic_buffer.reset();
+    }
+};
+
 
 } // end namespace boost::mqtt5
 
@@ -0,0 +1,85 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MQTT5_TEST_ALLOCATION_COUNTER_HPP
+#define BOOST_MQTT5_TEST_ALLOCATION_COUNTER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace boost::mqtt5::test {
+
+// Calls to the global operator new on this thread, counted
+// by the replacement in run_tests.cpp.
+inline thread_local size_t global_allocations = 0;
+
+// Bytes currently allocated with the global operator new by all threads,
+// tracked by the replacement in run_tests.cpp.
+inline std::atomic<size_t> global_allocated_bytes { 0 };
+
+// Counts the global allocations made on this thread since its construction.
+class allocation_scope {
+    size_t _start = global_allocations;
+
+public:
+    size_t count() const noexcept {
+        return global_allocations - _start;
+    }
+};
+
+struct allocation_stats {
+    size_t allocations = 0;
+    size_t deallocations = 0;
+};
+
+// Counts the allocations made with it in allocation_stats. Bound to
+// a completion handler with asio::bind_allocator, it counts the memory
+// the Client allocates on behalf of the asynchronous operation.
+template <typename T>
+class counting_allocator {
+    allocation_stats* _stats;
+
+    template <typename U>
+    friend class counting_allocator;
+
+public:
+    using value_type = T;
+
+    explicit counting_allocator(allocation_stats& stats) noexcept :
+        _stats(&stats)
+    {}
+
+    template <typename U>
+    counting_allocator(const counting_allocator<U>& other) noexcept :
+        _stats(other._stats)
+    {}
+
+    T* allocate(size_t n) {
+        ++_stats->allocations;
+        return std::allocator<T> {}.allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) {
+        ++_stats->deallocations;
+        std::allocator<T> {}.deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator==(const counting_allocator<U>& other) const noexcept {
+        return _stats == other._stats;
+    }
+
+    template <typename U>
+    bool operator!=(const counting_allocator<U>& other) const noexcept {
+        return !(*this == other);
+    }
+};
+
+} // end namespace boost::mqtt5::test
+
+#endif // !BOOST_MQTT5_TEST_ALLOCATION_COUNTER_HPP
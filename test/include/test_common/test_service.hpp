@@ -85,6 +85,10 @@ public:
     uint16_t allocate_pid() {
         return 0;
     }
+
+    bool pid_exhausted() const noexcept {
+        return true;
+    }
 };
 
 
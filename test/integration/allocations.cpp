@@ -0,0 +1,452 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mqtt5/mqtt_client.hpp>
+#include <boost/mqtt5/types.hpp>
+
+#include <boost/asio/bind_allocator.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <variant> // std::monostate
+#include <vector>
+
+#include "test_common/allocation_counter.hpp"
+#include "test_common/message_exchange.hpp"
+#include "test_common/test_service.hpp"
+#include "test_common/test_stream.hpp"
+
+using namespace boost::mqtt5;
+
+/*
+    Allocation budgets of the asynchronous operations on the hot paths.
+
+    The allocations the Client makes on behalf of an operation use
+    the allocator associated with its completion handler, so they are
+    counted by binding a test::counting_allocator to the handler.
+    Each operation is measured after an identical one has completed,
+    when the connection is established and the buffers are warmed up.
+*/
+
+BOOST_AUTO_TEST_SUITE(allocations/*, *boost::unit_test::disabled()*/)
+
+struct shared_test_data {
+    error_code success {};
+
+    const std::string connect = encoders::encode_connect(
+        "", std::nullopt, std::nullopt, 60, false, {}, std::nullopt
+    );
+    const std::string connack = encoders::encode_connack(
+        false, reason_codes::success.value(), {}
+    );
+
+    const std::string topic = "topic";
+    const std::string payload = "payload";
+
+    const std::string publish_qos0 = encoders::encode_publish(
+        0, topic, payload, qos_e::at_most_once, retain_e::no, dup_e::no, {}
+    );
+    const std::string publish_qos1 = encoders::encode_publish(
+        1, topic, payload, qos_e::at_least_once, retain_e::no, dup_e::no, {}
+    );
+    const std::string publish_qos2 = encoders::encode_publish(
+        1, topic, payload, qos_e::exactly_once, retain_e::no, dup_e::no, {}
+    );
+
+    const std::string puback = encoders::encode_puback(1, uint8_t(0x00), {});
+
+    const std::string pubrec = encoders::encode_pubrec(1, uint8_t(0x00), {});
+    const std::string pubrel = encoders::encode_pubrel(1, uint8_t(0x00), {});
+    const std::string pubcomp = encoders::encode_pubcomp(1, uint8_t(0x00), {});
+};
+
+using test::after;
+using namespace std::chrono_literals;
+
+using client_type = mqtt_client<test::test_stream>;
+
+template <typename Operation>
+size_t run_test(test::msg_exchange broker_side, Operation&& op) {
+    int handlers_called = 0;
+    test::allocation_stats stats;
+
+    {
+        asio::io_context ioc;
+        auto executor = ioc.get_executor();
+        auto& broker = asio::make_service<test::test_broker>(
+            ioc, executor, std::move(broker_side)
+        );
+
+        client_type c(executor);
+        c.brokers("127.0.0.1,127.0.0.1") // to avoid reconnect backoff
+            .async_run(asio::detached);
+
+        op(c, [&handlers_called](auto&&...) {
+            // the warm-up operation
+            ++handlers_called;
+        }, test::counting_allocator<void>(stats), [&c, &handlers_called](auto&&...) {
+            ++handlers_called;
+            c.cancel();
+        });
+
+        ioc.run_for(2s);
+        BOOST_TEST(handlers_called == 2);
+        BOOST_TEST(broker.received_all_expected());
+    }
+
+    BOOST_TEST(stats.allocations == stats.deallocations);
+    return stats.allocations;
+}
+
+template <qos_e qos_type>
+size_t publish_allocations(test::msg_exchange broker_side) {
+    return run_test(
+        std::move(broker_side),
+        [](client_type& c, auto warm_up, auto alloc, auto measured) {
+            auto data = shared_test_data();
+            c.async_publish<qos_type>(
+                data.topic, data.payload, retain_e::no, publish_props {},
+                [&c, data, warm_up, alloc, measured](auto&&... args) mutable {
+                    warm_up(args...);
+                    c.async_publish<qos_type>(
+                        data.topic, data.payload, retain_e::no, publish_props {},
+                        asio::bind_allocator(alloc, std::move(measured))
+                    );
+                }
+            );
+        }
+    );
+}
+
+size_t receive_allocations(test::msg_exchange broker_side) {
+    return run_test(
+        std::move(broker_side),
+        [](client_type& c, auto warm_up, auto alloc, auto measured) {
+            c.async_receive(
+                [&c, warm_up, alloc, measured](auto&&... args) mutable {
+                    warm_up(args...);
+                    c.async_receive(asio::bind_allocator(alloc, std::move(measured)));
+                }
+            );
+        }
+    );
+}
+
+// Allocations made with the global operator new from the start
+// of the measured receive until its completion, whatever the allocator
+// associated with its handler.
+size_t receive_global_allocations(test::msg_exchange broker_side) {
+    std::optional<test::allocation_scope> scope;
+    size_t allocations = 0;
+
+    run_test(
+        std::move(broker_side),
+        [&scope, &allocations](client_type& c, auto warm_up, auto alloc, auto measured) {
+            c.async_receive(
+                [&c, &scope, &allocations, warm_up, alloc, measured](auto&&... args) mutable {
+                    warm_up(args...);
+                    scope.emplace();
+                    c.async_receive(asio::bind_allocator(
+                        alloc,
+                        [&scope, &allocations, measured](auto&&... args) mutable {
+                            allocations = scope->count();
+                            measured(args...);
+                        }
+                    ));
+                }
+            );
+        }
+    );
+    return allocations;
+}
+
+// the storage of the PUBLISH packet and of the queued write request
+BOOST_FIXTURE_TEST_CASE(publish_qos0, shared_test_data) {
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(connect)
+            .complete_with(success, after(1ms))
+            .reply_with(connack, after(2ms))
+        .expect(publish_qos0)
+            .complete_with(success, after(1ms))
+        .expect(publish_qos0)
+            .complete_with(success, after(1ms));
+
+    BOOST_TEST(publish_allocations<qos_e::at_most_once>(std::move(broker_side)) <= 2u);
+}
+
+// QoS 0 budget and the wait for the PUBACK
+BOOST_FIXTURE_TEST_CASE(publish_qos1, shared_test_data) {
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(connect)
+            .complete_with(success, after(1ms))
+            .reply_with(connack, after(2ms))
+        .expect(publish_qos1)
+            .complete_with(success, after(1ms))
+            .reply_with(puback, after(2ms))
+        .expect(publish_qos1)
+            .complete_with(success, after(1ms))
+            .reply_with(puback, after(2ms));
+
+    BOOST_TEST(publish_allocations<qos_e::at_least_once>(std::move(broker_side)) <= 3u);
+}
+
+// QoS 1 budget, the write request of the PUBREL and the wait for the PUBCOMP;
+// the PUBREL packet itself is stored inline
+BOOST_FIXTURE_TEST_CASE(publish_qos2, shared_test_data) {
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(connect)
+            .complete_with(success, after(1ms))
+            .reply_with(connack, after(2ms))
+        .expect(publish_qos2)
+            .complete_with(success, after(1ms))
+            .reply_with(pubrec, after(2ms))
+        .expect(pubrel)
+            .complete_with(success, after(1ms))
+            .reply_with(pubcomp, after(2ms))
+        .expect(publish_qos2)
+            .complete_with(success, after(1ms))
+            .reply_with(pubrec, after(2ms))
+        .expect(pubrel)
+            .complete_with(success, after(1ms))
+            .reply_with(pubcomp, after(2ms));
+
+    BOOST_TEST(publish_allocations<qos_e::exactly_once>(std::move(broker_side)) <= 5u);
+}
+
+// the pending receive operation and its completion;
+// the acknowledgements are sent without allocating on behalf of the receiver
+BOOST_FIXTURE_TEST_CASE(receive_qos0, shared_test_data) {
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(connect)
+            .complete_with(success, after(0ms))
+            .reply_with(connack, after(0ms))
+        .send(publish_qos0, after(10ms))
+        .send(publish_qos0, after(50ms));
+
+    BOOST_TEST(receive_allocations(std::move(broker_side)) <= 2u);
+}
+
+// the Topic and the Payload copied into the message, as in the unit tests;
+// the read buffer, the read and the delivery to the receiver are recycled
+BOOST_FIXTURE_TEST_CASE(receive_qos0_global, shared_test_data) {
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(connect)
+            .complete_with(success, after(0ms))
+            .reply_with(connack, after(0ms))
+        .send(publish_qos0, after(10ms))
+        .send(publish_qos0, after(50ms));
+
+    BOOST_TEST(receive_global_allocations(std::move(broker_side)) <= 2u);
+}
+
+BOOST_FIXTURE_TEST_CASE(receive_qos1, shared_test_data) {
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(connect)
+            .complete_with(success, after(0ms))
+            .reply_with(connack, after(0ms))
+        .send(publish_qos1, after(10ms))
+        .expect(puback)
+            .complete_with(success, after(1ms))
+        .send(publish_qos1, after(50ms))
+        .expect(puback)
+            .complete_with(success, after(1ms));
+
+    BOOST_TEST(receive_allocations(std::move(broker_side)) <= 2u);
+}
+
+BOOST_FIXTURE_TEST_CASE(receive_qos2, shared_test_data) {
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(connect)
+            .complete_with(success, after(0ms))
+            .reply_with(connack, after(0ms))
+        .send(publish_qos2, after(10ms))
+        .expect(pubrec)
+            .complete_with(success, after(1ms))
+            .reply_with(pubrel, after(2ms))
+        .expect(pubcomp)
+            .complete_with(success, after(1ms))
+        .send(publish_qos2, after(50ms))
+        .expect(pubrec)
+            .complete_with(success, after(1ms))
+            .reply_with(pubrel, after(2ms))
+        .expect(pubcomp)
+            .complete_with(success, after(1ms));
+
+    BOOST_TEST(receive_allocations(std::move(broker_side)) <= 2u);
+}
+
+BOOST_FIXTURE_TEST_CASE(client_allocator, shared_test_data) {
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(connect)
+            .complete_with(success, after(1ms))
+            .reply_with(connack, after(2ms))
+        .expect(publish_qos1)
+            .complete_with(success, after(1ms))
+            .reply_with(puback, after(2ms));
+
+    int handlers_called = 0;
+    test::allocation_stats stats;
+
+    {
+        asio::io_context ioc;
+        auto executor = ioc.get_executor();
+        auto& broker = asio::make_service<test::test_broker>(
+            ioc, executor, std::move(broker_side)
+        );
+
+        using allocator_type = test::counting_allocator<void>;
+        mqtt_client<test::test_stream, std::monostate, noop_logger, allocator_type>
+            c(executor, {}, {}, allocator_type(stats));
+        BOOST_TEST((c.get_allocator() == allocator_type(stats)));
+        c.brokers("127.0.0.1,127.0.0.1") // to avoid reconnect backoff
+            .async_run(asio::detached);
+
+        // the handler has no associated allocator, the Client's allocator is used
+        c.async_publish<qos_e::at_least_once>(
+            topic, payload, retain_e::no, publish_props {},
+            [&c, &handlers_called](error_code ec, reason_code rc, puback_props) {
+                ++handlers_called;
+                BOOST_TEST(!ec);
+                BOOST_TEST(rc == reason_codes::success);
+                c.cancel();
+            }
+        );
+
+        ioc.run_for(2s);
+        BOOST_TEST(handlers_called == 1);
+        BOOST_TEST(broker.received_all_expected());
+        BOOST_TEST(stats.allocations > 0u);
+    }
+
+    BOOST_TEST(stats.allocations == stats.deallocations);
+}
+
+// Heap memory pinned by each received message held in zero-copy mode,
+// where every buffer still referred to is replaced by a new one.
+BOOST_FIXTURE_TEST_CASE(retained_publish_views, shared_test_data) {
+    constexpr size_t num_messages = 20;
+
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(connect)
+            .complete_with(success, after(0ms))
+            .reply_with(connack, after(0ms));
+    for (size_t i = 0; i <= num_messages; ++i)
+        broker_side.send(publish_qos0, after(std::chrono::milliseconds(10 + 5 * i)));
+
+    asio::io_context ioc;
+    auto executor = ioc.get_executor();
+    auto& broker = asio::make_service<test::test_broker>(
+        ioc, executor, std::move(broker_side)
+    );
+
+    std::vector<publish_view> views;
+    views.reserve(num_messages + 1);
+    size_t before = 0, after_bytes = 0;
+
+    client_type c(executor);
+    c.brokers("127.0.0.1,127.0.0.1") // to avoid reconnect backoff
+        .zero_copy_receive(true)
+        .async_run(asio::detached);
+
+    std::function<void (error_code, publish_view)> on_view =
+        [&](error_code ec, publish_view view) {
+            BOOST_TEST_REQUIRE(!ec);
+            views.push_back(std::move(view));
+            if (views.size() == 1)
+                // the buffer of the first message is sized to the maximum packet size
+                before = test::global_allocated_bytes.load();
+            if (views.size() == num_messages + 1) {
+                after_bytes = test::global_allocated_bytes.load();
+                return c.cancel();
+            }
+            c.async_receive_view(on_view);
+        };
+    c.async_receive_view(on_view);
+
+    ioc.run_for(2s);
+    BOOST_TEST(views.size() == num_messages + 1);
+    BOOST_TEST(broker.received_all_expected());
+
+    auto bytes_per_message = (double(after_bytes) - double(before)) / num_messages;
+    BOOST_TEST_MESSAGE("retained publish_view: " << bytes_per_message << " bytes");
+    BOOST_TEST(bytes_per_message < 8'192.0);
+}
+
+// Heap memory held by a connected Client with no traffic.
+size_t idle_client_bytes(bool low_footprint) {
+    shared_test_data data;
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(data.connect)
+            .complete_with(data.success, after(0ms))
+            .reply_with(data.connack, after(0ms));
+
+    asio::io_context ioc;
+    auto executor = ioc.get_executor();
+    auto& broker = asio::make_service<test::test_broker>(
+        ioc, executor, std::move(broker_side)
+    );
+
+    // the resolver service of the io_context starts its thread on the first resolve
+    asio::ip::tcp::resolver resolver(ioc);
+    resolver.async_resolve("127.0.0.1", "1883", [](auto&&...) {});
+    ioc.run();
+    ioc.restart();
+    // the timer wheel is shared by all Clients of the io_context
+    asio::use_service<detail::timer_wheel>(ioc);
+
+    size_t bytes = 0;
+    {
+        auto before = test::global_allocated_bytes.load();
+
+        client_type c(executor);
+        c.brokers("127.0.0.1,127.0.0.1") // to avoid reconnect backoff
+            .low_footprint(low_footprint)
+            .async_run(asio::detached);
+
+        // measured outside of run, which releases the memory it caches
+        ioc.run_for(100ms);
+        BOOST_TEST(broker.received_all_expected());
+        bytes = test::global_allocated_bytes.load() - before;
+
+        c.cancel();
+        ioc.run_for(1s);
+    }
+    return bytes;
+}
+
+// the target documented in mqtt_client::low_footprint
+BOOST_AUTO_TEST_CASE(idle_client_footprint) {
+    auto default_bytes = idle_client_bytes(false);
+    auto low_footprint_bytes = idle_client_bytes(true);
+
+    BOOST_TEST_MESSAGE(
+        "idle client: " << default_bytes << " bytes, " <<
+        low_footprint_bytes << " bytes in low-footprint mode"
+    );
+    // the read buffer sized to the maximum packet size
+    BOOST_TEST(default_bytes >= 65'536u);
+    BOOST_TEST(low_footprint_bytes < 16'384u);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -213,6 +213,189 @@ BOOST_FIXTURE_TEST_CASE(receive_publish_properties, shared_test_data) {
 }
 
 
+BOOST_FIXTURE_TEST_CASE(receive_publish_view, shared_test_data) {
+    constexpr int expected_handlers_called = 2;
+    int handlers_called = 0;
+
+    const std::string other_topic = "other/topic";
+    const std::string other_payload = "other payload";
+    auto other_publish = encoders::encode_publish(
+        1, other_topic, other_payload,
+        qos_e::at_least_once, retain_e::no, dup_e::no, {}
+    );
+
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(connect)
+            .complete_with(success, after(0ms))
+            .reply_with(connack, after(0ms))
+        .send(publish_qos0, after(10ms))
+        .send(other_publish, after(20ms))
+        .expect(puback)
+            .complete_with(success, after(1ms));
+
+    asio::io_context ioc;
+    auto executor = ioc.get_executor();
+    auto& broker = asio::make_service<test::test_broker>(
+        ioc, executor, std::move(broker_side)
+    );
+
+    using client_type = mqtt_client<test::test_stream>;
+    client_type c(executor);
+    c.brokers("127.0.0.1")
+        .zero_copy_receive(true)
+        .async_run(asio::detached);
+
+    c.async_receive_view(
+        [&](error_code ec, publish_view first) {
+            ++handlers_called;
+            BOOST_TEST(!ec);
+            BOOST_TEST(first.topic() == topic);
+            BOOST_TEST(first.payload() == payload);
+
+            // the first message is still referenced while the next one is read
+            c.async_receive_view(
+                [&, first = std::move(first)](error_code ec, publish_view second) mutable {
+                    ++handlers_called;
+                    BOOST_TEST(!ec);
+                    BOOST_TEST(second.topic() == other_topic);
+                    BOOST_TEST(second.payload() == other_payload);
+                    BOOST_TEST(first.topic() == topic);
+                    BOOST_TEST(first.payload() == payload);
+
+                    first.release();
+                    BOOST_TEST(first.topic().empty());
+                    c.cancel();
+                }
+            );
+        }
+    );
+
+    ioc.run_for(3s);
+    BOOST_TEST(handlers_called == expected_handlers_called);
+    BOOST_TEST(broker.received_all_expected());
+}
+
+BOOST_FIXTURE_TEST_CASE(receive_publish_topic_alias, shared_test_data) {
+    constexpr int expected_handlers_called = 2;
+    int handlers_called = 0;
+
+    connect_props cprops;
+    cprops[prop::topic_alias_maximum] = uint16_t(10);
+    auto alias_connect = encoders::encode_connect(
+        "", std::nullopt, std::nullopt, 60, false, cprops, std::nullopt
+    );
+
+    publish_props pprops;
+    pprops[prop::topic_alias] = uint16_t(3);
+    auto mapping_publish = encoders::encode_publish(
+        0, topic, payload, qos_e::at_most_once, retain_e::no, dup_e::no, pprops
+    );
+    auto aliased_publish = encoders::encode_publish(
+        0, "", payload, qos_e::at_most_once, retain_e::no, dup_e::no, pprops
+    );
+
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(alias_connect)
+            .complete_with(success, after(0ms))
+            .reply_with(connack, after(0ms))
+        .send(mapping_publish, after(10ms))
+        .send(aliased_publish, after(20ms));
+
+    asio::io_context ioc;
+    auto executor = ioc.get_executor();
+    auto& broker = asio::make_service<test::test_broker>(
+        ioc, executor, std::move(broker_side)
+    );
+
+    using client_type = mqtt_client<test::test_stream>;
+    client_type c(executor);
+    c.brokers("127.0.0.1")
+        .connect_properties(cprops)
+        .async_run(asio::detached);
+
+    auto handler = [&](
+        error_code ec, std::string rec_topic, std::string rec_payload,
+        publish_props rec_pprops
+    ) {
+        ++handlers_called;
+        BOOST_TEST(!ec);
+        BOOST_TEST(rec_topic == topic);
+        BOOST_TEST(rec_payload == payload);
+        BOOST_TEST(*rec_pprops[prop::topic_alias] == 3);
+    };
+
+    c.async_receive([&](auto... args) {
+        handler(std::move(args)...);
+        c.async_receive([&](auto... args) {
+            handler(std::move(args)...);
+            c.cancel();
+        });
+    });
+
+    ioc.run_for(3s);
+    BOOST_TEST(handlers_called == expected_handlers_called);
+    BOOST_TEST(broker.received_all_expected());
+}
+
+void run_topic_alias_violation_test(
+    const std::string& publish, const std::string& disconnect
+) {
+    auto data = shared_test_data();
+
+    connect_props cprops;
+    cprops[prop::topic_alias_maximum] = uint16_t(10);
+    auto alias_connect = encoders::encode_connect(
+        "", std::nullopt, std::nullopt, 60, false, cprops, std::nullopt
+    );
+
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(alias_connect)
+            .complete_with(data.success, after(0ms))
+            .reply_with(data.connack, after(0ms))
+        .send(publish, after(10ms))
+        .expect(disconnect)
+            .complete_with(data.success, after(1ms))
+        .expect(alias_connect)
+            .complete_with(data.success, after(0ms))
+            .reply_with(data.connack, after(0ms))
+        .send(data.publish_qos0, after(50ms));
+
+    run_test(std::move(broker_side), cprops);
+}
+
+BOOST_FIXTURE_TEST_CASE(receive_invalid_topic_alias, shared_test_data) {
+    publish_props pprops;
+    pprops[prop::topic_alias] = uint16_t(11);
+    auto publish = encoders::encode_publish(
+        0, topic, payload, qos_e::at_most_once, retain_e::no, dup_e::no, pprops
+    );
+
+    auto disconnect = encoders::encode_disconnect(
+        reason_codes::topic_alias_invalid.value(),
+        test::dprops_with_reason_string("PUBLISH received with an invalid Topic Alias")
+    );
+
+    run_topic_alias_violation_test(publish, disconnect);
+}
+
+BOOST_FIXTURE_TEST_CASE(receive_unmapped_topic_alias, shared_test_data) {
+    publish_props pprops;
+    pprops[prop::topic_alias] = uint16_t(1);
+    auto publish = encoders::encode_publish(
+        0, "", payload, qos_e::at_most_once, retain_e::no, dup_e::no, pprops
+    );
+
+    auto disconnect = encoders::encode_disconnect(
+        reason_codes::protocol_error.value(),
+        test::dprops_with_reason_string("PUBLISH received with an unmapped Topic Alias")
+    );
+
+    run_topic_alias_violation_test(publish, disconnect);
+}
+
 BOOST_FIXTURE_TEST_CASE(receive_malformed_publish, shared_test_data) {
     // packets
     auto malformed_publish = encoders::encode_publish(
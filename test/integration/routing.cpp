@@ -0,0 +1,271 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mqtt5/mqtt_client.hpp>
+#include <boost/mqtt5/topic_router.hpp>
+#include <boost/mqtt5/types.hpp>
+
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "test_common/message_exchange.hpp"
+#include "test_common/test_service.hpp"
+#include "test_common/test_stream.hpp"
+
+using namespace boost::mqtt5;
+
+BOOST_AUTO_TEST_SUITE(routing/*, *boost::unit_test::disabled()*/)
+
+struct shared_test_data {
+    error_code success {};
+
+    const std::string connect = encoders::encode_connect(
+        "", std::nullopt, std::nullopt, 60, false, {}, std::nullopt
+    );
+    const std::string connack = encoders::encode_connack(
+        false, reason_codes::success.value(), {}
+    );
+
+    const std::string publish_sensor = encoders::encode_publish(
+        0, "sensors/temperature", "21", qos_e::at_most_once,
+        retain_e::no, dup_e::no, {}
+    );
+    const std::string publish_status = encoders::encode_publish(
+        0, "status", "online", qos_e::at_most_once,
+        retain_e::no, dup_e::no, {}
+    );
+};
+
+using test::after;
+using namespace std::chrono_literals;
+
+using client_type = mqtt_client<test::test_stream>;
+
+void run_route_test(const shared_test_data& data, bool zero_copy) {
+    constexpr int expected_handlers_called = 3;
+    int handlers_called = 0;
+
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(data.connect)
+            .complete_with(data.success, after(0ms))
+            .reply_with(data.connack, after(0ms))
+        .send(data.publish_sensor, after(10ms))
+        .send(data.publish_status, after(20ms));
+
+    asio::io_context ioc;
+    auto executor = ioc.get_executor();
+    auto& broker = asio::make_service<test::test_broker>(
+        ioc, executor, std::move(broker_side)
+    );
+
+    client_type c(executor);
+    c.brokers("127.0.0.1,127.0.0.1") // to avoid reconnect backoff
+        .zero_copy_receive(zero_copy)
+        .async_run(asio::detached);
+    BOOST_TEST(c.zero_copy_receive() == zero_copy);
+
+    std::vector<std::string> routed;
+    topic_router router;
+    router.add("sensors/+", [&](std::string_view topic, std::string_view payload, const publish_props&) {
+        ++handlers_called;
+        BOOST_TEST(topic == "sensors/temperature");
+        BOOST_TEST(payload == "21");
+        routed.emplace_back(topic);
+    });
+    router.add("status", [&](std::string_view topic, std::string_view payload, const publish_props&) {
+        ++handlers_called;
+        BOOST_TEST(payload == "online");
+        routed.emplace_back(topic);
+        c.cancel();
+    });
+
+    async_route(c, router, [&handlers_called](error_code ec) {
+        ++handlers_called;
+        BOOST_TEST(ec == asio::error::operation_aborted);
+    });
+
+    ioc.run_for(2s);
+    BOOST_TEST(handlers_called == expected_handlers_called);
+    BOOST_TEST((routed == std::vector<std::string> { "sensors/temperature", "status" }));
+    BOOST_TEST(broker.received_all_expected());
+}
+
+BOOST_FIXTURE_TEST_CASE(route_received_messages, shared_test_data) {
+    run_route_test(*this, false);
+}
+
+BOOST_FIXTURE_TEST_CASE(route_received_publish_views, shared_test_data) {
+    run_route_test(*this, true);
+}
+
+BOOST_FIXTURE_TEST_CASE(subscribe_by_identifier, shared_test_data) {
+    constexpr int expected_handlers_called = 3;
+    int handlers_called = 0;
+
+    std::vector<subscribe_topic> topics = {
+        subscribe_topic { "sensors/+", subscribe_options {} }
+    };
+    subscribe_props sprops;
+    sprops[prop::subscription_identifier] = 1;
+    auto subscribe = encoders::encode_subscribe(1, topics, sprops);
+    auto suback = encoders::encode_suback(1, { uint8_t(0x00) }, suback_props {});
+
+    publish_props pprops;
+    pprops[prop::subscription_identifier] = { 1 };
+    auto publish = encoders::encode_publish(
+        0, "sensors/temperature", "21", qos_e::at_most_once,
+        retain_e::no, dup_e::no, pprops
+    );
+
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(connect)
+            .complete_with(success, after(0ms))
+            .reply_with(connack, after(0ms))
+        .expect(subscribe)
+            .complete_with(success, after(0ms))
+            .reply_with(suback, after(0ms))
+        .send(publish, after(10ms));
+
+    asio::io_context ioc;
+    auto executor = ioc.get_executor();
+    auto& broker = asio::make_service<test::test_broker>(
+        ioc, executor, std::move(broker_side)
+    );
+
+    client_type c(executor);
+    c.brokers("127.0.0.1,127.0.0.1") // to avoid reconnect backoff
+        .async_run(asio::detached);
+
+    topic_router router;
+    int32_t sub_id = 0;
+    async_subscribe(
+        c, router, topics, subscribe_props {},
+        [&](std::string_view topic, std::string_view, const publish_props&) {
+            ++handlers_called;
+            BOOST_TEST(topic == "sensors/temperature");
+            c.cancel();
+        },
+        [&](error_code ec, std::vector<reason_code> rcs, suback_props, int32_t id) {
+            ++handlers_called;
+            BOOST_TEST(!ec);
+            BOOST_TEST_REQUIRE(rcs.size() == 1u);
+            BOOST_TEST(rcs[0] == reason_codes::granted_qos_0);
+            BOOST_TEST(id == 1);
+            sub_id = id;
+        }
+    );
+    async_route(c, router, [&handlers_called](error_code ec) {
+        ++handlers_called;
+        BOOST_TEST(ec == asio::error::operation_aborted);
+    });
+
+    ioc.run_for(2s);
+    BOOST_TEST(handlers_called == expected_handlers_called);
+    BOOST_TEST(broker.received_all_expected());
+
+    // the identifier is released and reused
+    BOOST_TEST(router.remove_subscription(sub_id));
+    BOOST_TEST(router.empty());
+    BOOST_TEST(router.add_subscription([](auto, auto, const auto&) {}) == sub_id);
+}
+
+// the Broker does not support Subscription Identifiers
+BOOST_FIXTURE_TEST_CASE(subscribe_by_filters, shared_test_data) {
+    constexpr int expected_handlers_called = 2;
+    int handlers_called = 0;
+
+    connack_props cprops;
+    cprops[prop::subscription_identifier_available] = uint8_t(0);
+    auto no_sub_id_connack = encoders::encode_connack(
+        false, reason_codes::success.value(), cprops
+    );
+
+    std::vector<subscribe_topic> topics = {
+        subscribe_topic { "status", subscribe_options {} },
+        subscribe_topic { "sensors/+", subscribe_options {} }
+    };
+    auto subscribe = encoders::encode_subscribe(1, topics, subscribe_props {});
+    auto suback = encoders::encode_suback(
+        1, { uint8_t(0x00), uint8_t(0x87) }, suback_props {}
+    );
+
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(connect)
+            .complete_with(success, after(0ms))
+            .reply_with(no_sub_id_connack, after(0ms))
+        .expect(subscribe)
+            .complete_with(success, after(0ms))
+            .reply_with(suback, after(0ms))
+        .send(publish_status, after(10ms))
+        .send(publish_sensor, after(20ms));
+
+    asio::io_context ioc;
+    auto executor = ioc.get_executor();
+    auto& broker = asio::make_service<test::test_broker>(
+        ioc, executor, std::move(broker_side)
+    );
+
+    client_type c(executor);
+    c.brokers("127.0.0.1,127.0.0.1") // to avoid reconnect backoff
+        .async_run(asio::detached);
+
+    // routes registered before the subscription are neither replaced nor removed
+    int status_routed = 0, sensors_routed = 0, subscription_routed = 0;
+    topic_router router;
+    router.add("status", [&](auto, auto, const auto&) { ++status_routed; });
+    router.add("sensors/+", [&](auto, auto, const auto&) {
+        ++sensors_routed;
+        c.cancel();
+    });
+
+    int32_t sub_id = 0;
+    asio::steady_timer connected(ioc, 10ms);
+    connected.async_wait([&](error_code) {
+        async_subscribe(
+            c, router, topics, subscribe_props {},
+            [&](auto, auto, const auto&) { ++subscription_routed; },
+            [&](error_code ec, std::vector<reason_code> rcs, suback_props, int32_t id) {
+                ++handlers_called;
+                BOOST_TEST(!ec);
+                BOOST_TEST_REQUIRE(rcs.size() == 2u);
+                BOOST_TEST(rcs[0] == reason_codes::granted_qos_0);
+                BOOST_TEST(rcs[1] == reason_codes::not_authorized);
+                BOOST_TEST(id != 0);
+                sub_id = id;
+            }
+        );
+    });
+    async_route(c, router, [&handlers_called](error_code ec) {
+        ++handlers_called;
+        BOOST_TEST(ec == asio::error::operation_aborted);
+    });
+
+    ioc.run_for(2s);
+    BOOST_TEST(handlers_called == expected_handlers_called);
+    BOOST_TEST(broker.received_all_expected());
+
+    BOOST_TEST(status_routed == 1);
+    BOOST_TEST(sensors_routed == 1);
+    // only the route of the granted Topic remains
+    BOOST_TEST(subscription_routed == 1);
+
+    BOOST_TEST(router.remove_subscription(sub_id));
+    BOOST_TEST(router.size() == 2u);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
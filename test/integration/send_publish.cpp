@@ -13,11 +13,14 @@
 #include <boost/asio/cancellation_signal.hpp>
 #include <boost/asio/detached.hpp>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/test/unit_test.hpp>
 
 #include <chrono>
 #include <cstdint>
+#include <functional>
 #include <string>
+#include <vector>
 
 #include "test_common/message_exchange.hpp"
 #include "test_common/packet_util.hpp"
@@ -617,4 +620,377 @@ BOOST_FIXTURE_TEST_CASE(send_big_publish, shared_test_data) {
     BOOST_TEST(broker.received_all_expected());
 }
 
+void run_auto_topic_alias_test(
+    test::msg_exchange broker_side, std::vector<std::string> topics
+) {
+    const int expected_handlers_called = static_cast<int>(topics.size());
+    int handlers_called = 0;
+
+    asio::io_context ioc;
+    auto executor = ioc.get_executor();
+    auto& broker = asio::make_service<test::test_broker>(
+        ioc, executor, std::move(broker_side)
+    );
+
+    using client_type = mqtt_client<test::test_stream>;
+    client_type c(executor);
+    c.brokers("127.0.0.1,127.0.0.1") // to avoid reconnect backoff
+        .auto_topic_alias(true)
+        .async_run(asio::detached);
+
+    // each publish is started once the previous one completes
+    std::function<void (size_t)> publish = [&](size_t i) {
+        c.async_publish<qos_e::at_most_once>(
+            topics[i], "payload", retain_e::no, publish_props {},
+            [&, i](error_code ec) {
+                ++handlers_called;
+                BOOST_TEST(!ec);
+                if (i + 1 < topics.size())
+                    return publish(i + 1);
+                c.cancel();
+            }
+        );
+    };
+    publish(0);
+
+    ioc.run_for(2s);
+    BOOST_TEST(handlers_called == expected_handlers_called);
+    BOOST_TEST(broker.received_all_expected());
+}
+
+BOOST_FIXTURE_TEST_CASE(send_publish_auto_topic_alias, shared_test_data) {
+    connack_props cprops;
+    cprops[prop::topic_alias_maximum] = uint16_t(1);
+    auto alias_connack = encoders::encode_connack(false, uint8_t(0x00), cprops);
+
+    publish_props pprops;
+    pprops[prop::topic_alias] = uint16_t(1);
+
+    auto mapping_publish = encoders::encode_publish(
+        0, topic, payload, qos_e::at_most_once, retain_e::no, dup_e::no, pprops
+    );
+    auto aliased_publish = encoders::encode_publish(
+        0, "", payload, qos_e::at_most_once, retain_e::no, dup_e::no, pprops
+    );
+    // the least recently used alias is reassigned
+    auto remapping_publish = encoders::encode_publish(
+        0, "other/topic", payload, qos_e::at_most_once, retain_e::no, dup_e::no, pprops
+    );
+
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(connect)
+            .complete_with(success, after(1ms))
+            .reply_with(alias_connack, after(2ms))
+        .expect(mapping_publish)
+            .complete_with(success, after(1ms))
+        .expect(aliased_publish)
+            .complete_with(success, after(1ms))
+        .expect(remapping_publish)
+            .complete_with(success, after(1ms));
+
+    run_auto_topic_alias_test(
+        std::move(broker_side), { topic, topic, "other/topic" }
+    );
+}
+
+BOOST_FIXTURE_TEST_CASE(resend_publish_auto_topic_alias, shared_test_data) {
+    connack_props cprops;
+    cprops[prop::topic_alias_maximum] = uint16_t(10);
+    auto alias_connack = encoders::encode_connack(false, uint8_t(0x00), cprops);
+
+    publish_props pprops;
+    pprops[prop::topic_alias] = uint16_t(1);
+
+    auto mapping_publish = encoders::encode_publish(
+        0, topic, payload, qos_e::at_most_once, retain_e::no, dup_e::no, pprops
+    );
+    auto aliased_publish = encoders::encode_publish(
+        0, "", payload, qos_e::at_most_once, retain_e::no, dup_e::no, pprops
+    );
+
+    // the alias is not valid in the new Network Connection
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(connect)
+            .complete_with(success, after(1ms))
+            .reply_with(alias_connack, after(2ms))
+        .expect(mapping_publish)
+            .complete_with(success, after(1ms))
+        .expect(aliased_publish)
+            .complete_with(fail, after(1ms))
+        .expect(connect)
+            .complete_with(success, after(1ms))
+            .reply_with(alias_connack, after(2ms))
+        .expect(publish_qos0)
+            .complete_with(success, after(1ms));
+
+    run_auto_topic_alias_test(std::move(broker_side), { topic, topic });
+}
+
+BOOST_FIXTURE_TEST_CASE(try_publish, shared_test_data) {
+    // packets published before the connection is established
+    // are written together once it is
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(connect)
+            .complete_with(success, after(1ms))
+            .reply_with(connack, after(2ms))
+        .expect(publish_qos0, publish_qos0)
+            .complete_with(success, after(1ms));
+
+    asio::io_context ioc;
+    auto executor = ioc.get_executor();
+    auto& broker = asio::make_service<test::test_broker>(
+        ioc, executor, std::move(broker_side)
+    );
+
+    using client_type = mqtt_client<test::test_stream>;
+    client_type c(executor);
+    c.brokers("127.0.0.1,127.0.0.1") // to avoid reconnect backoff
+        .async_run(asio::detached);
+
+    auto ec = c.try_publish(topic, payload, retain_e::no, publish_props {});
+    BOOST_TEST(!ec);
+    ec = c.try_publish(topic, payload, retain_e::no, publish_props {});
+    BOOST_TEST(!ec);
+
+    ec = c.try_publish("invalid/#", payload, retain_e::no, publish_props {});
+    BOOST_TEST(ec == client::error::invalid_topic);
+
+    asio::steady_timer timer(executor);
+    timer.expires_after(100ms);
+    timer.async_wait([&c](error_code) { c.cancel(); });
+
+    ioc.run_for(2s);
+    BOOST_TEST(broker.received_all_expected());
+}
+
+BOOST_FIXTURE_TEST_CASE(try_publish_buffer_size, shared_test_data) {
+    // the third packet exceeds the budget and is not queued
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(connect)
+            .complete_with(success, after(1ms))
+            .reply_with(connack, after(2ms))
+        .expect(publish_qos0, publish_qos0)
+            .complete_with(success, after(1ms));
+
+    asio::io_context ioc;
+    auto executor = ioc.get_executor();
+    auto& broker = asio::make_service<test::test_broker>(
+        ioc, executor, std::move(broker_side)
+    );
+
+    using client_type = mqtt_client<test::test_stream>;
+    client_type c(executor);
+    c.brokers("127.0.0.1,127.0.0.1") // to avoid reconnect backoff
+        .try_publish_buffer_size(2 * publish_qos0.size())
+        .async_run(asio::detached);
+
+    auto ec = c.try_publish(topic, payload, retain_e::no, publish_props {});
+    BOOST_TEST(!ec);
+    ec = c.try_publish(topic, payload, retain_e::no, publish_props {});
+    BOOST_TEST(!ec);
+    ec = c.try_publish(topic, payload, retain_e::no, publish_props {});
+    BOOST_TEST(ec == asio::error::would_block);
+
+    asio::steady_timer timer(executor);
+    timer.expires_after(100ms);
+    timer.async_wait([&c](error_code) { c.cancel(); });
+
+    ioc.run_for(2s);
+    BOOST_TEST(broker.received_all_expected());
+}
+
+BOOST_FIXTURE_TEST_CASE(try_publish_drops_topic_alias, shared_test_data) {
+    connack_props cprops;
+    cprops[prop::topic_alias_maximum] = uint16_t(10);
+    auto alias_connack = encoders::encode_connack(false, uint8_t(0x00), cprops);
+
+    publish_props pprops;
+    pprops[prop::topic_alias] = uint16_t(1);
+
+    auto mapping_publish = encoders::encode_publish(
+        0, topic, payload, qos_e::at_most_once, retain_e::no, dup_e::no, pprops
+    );
+
+    // the aliased packet is not written in the new Network Connection
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(connect)
+            .complete_with(success, after(1ms))
+            .reply_with(alias_connack, after(2ms))
+        .expect(mapping_publish, publish_qos0)
+            .complete_with(fail, after(1ms))
+        .expect(connect)
+            .complete_with(success, after(1ms))
+            .reply_with(alias_connack, after(2ms))
+        .expect(publish_qos0)
+            .complete_with(success, after(1ms));
+
+    asio::io_context ioc;
+    auto executor = ioc.get_executor();
+    auto& broker = asio::make_service<test::test_broker>(
+        ioc, executor, std::move(broker_side)
+    );
+
+    using client_type = mqtt_client<test::test_stream>;
+    client_type c(executor);
+    c.brokers("127.0.0.1,127.0.0.1") // to avoid reconnect backoff
+        .async_run(asio::detached);
+
+    asio::steady_timer timer(executor);
+    timer.expires_after(20ms);
+    timer.async_wait([&](error_code) {
+        auto ec = c.try_publish(topic, payload, retain_e::no, pprops);
+        BOOST_TEST(!ec);
+        ec = c.try_publish(topic, payload, retain_e::no, publish_props {});
+        BOOST_TEST(!ec);
+
+        timer.expires_after(100ms);
+        timer.async_wait([&c](error_code) { c.cancel(); });
+    });
+
+    ioc.run_for(2s);
+    BOOST_TEST(broker.received_all_expected());
+}
+
+BOOST_FIXTURE_TEST_CASE(publish_to_validated_topic, shared_test_data) {
+    constexpr int expected_handlers_called = 2;
+    int handlers_called = 0;
+
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(connect)
+            .complete_with(success, after(1ms))
+            .reply_with(connack, after(2ms))
+        .expect(publish_qos1)
+            .complete_with(success, after(1ms))
+            .reply_with(puback, after(2ms))
+        .expect(publish_qos0)
+            .complete_with(success, after(1ms));
+
+    asio::io_context ioc;
+    auto executor = ioc.get_executor();
+    auto& broker = asio::make_service<test::test_broker>(
+        ioc, executor, std::move(broker_side)
+    );
+
+    using client_type = mqtt_client<test::test_stream>;
+    client_type c(executor);
+    c.brokers("127.0.0.1,127.0.0.1") // to avoid reconnect backoff
+        .async_run(asio::detached);
+
+    BOOST_TEST(client_type::make_topic("invalid/#").empty());
+    BOOST_TEST(client_type::make_topic("").empty());
+
+    auto valid_topic = client_type::make_topic(topic);
+    BOOST_TEST(valid_topic.name() == topic);
+
+    c.async_publish<qos_e::at_most_once>(
+        publish_topic {}, payload, retain_e::no, publish_props {},
+        [&handlers_called](error_code ec) {
+            ++handlers_called;
+            BOOST_TEST(ec == client::error::invalid_topic);
+        }
+    );
+
+    c.async_publish<qos_e::at_least_once>(
+        valid_topic, payload, retain_e::no, publish_props {},
+        [&handlers_called, &c, valid_topic](error_code ec, reason_code rc, puback_props) {
+            ++handlers_called;
+            BOOST_TEST(!ec);
+            BOOST_TEST(rc == reason_codes::success);
+
+            BOOST_TEST(!c.try_publish(valid_topic, "payload", retain_e::no, publish_props {}));
+            BOOST_TEST(
+                c.try_publish(publish_topic {}, "payload", retain_e::no, publish_props {}) ==
+                client::error::invalid_topic
+            );
+        }
+    );
+
+    asio::steady_timer timer(executor);
+    timer.expires_after(100ms);
+    timer.async_wait([&c](error_code) { c.cancel(); });
+
+    ioc.run_for(2s);
+    BOOST_TEST(handlers_called == expected_handlers_called);
+    BOOST_TEST(broker.received_all_expected());
+}
+
+BOOST_FIXTURE_TEST_CASE(publish_with_template, shared_test_data) {
+    constexpr int expected_handlers_called = 2;
+    int handlers_called = 0;
+
+    publish_props props;
+    props[prop::content_type] = "text/plain";
+    props[prop::user_property].emplace_back("key", "value");
+
+    const std::string publish_qos1_props = encoders::encode_publish(
+        1, topic, payload, qos_e::at_least_once, retain_e::no, dup_e::no, props
+    );
+    const std::string publish_qos0_props = encoders::encode_publish(
+        0, topic, payload, qos_e::at_most_once, retain_e::yes, dup_e::no, props
+    );
+
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(connect)
+            .complete_with(success, after(1ms))
+            .reply_with(connack, after(2ms))
+        .expect(publish_qos1_props)
+            .complete_with(success, after(1ms))
+            .reply_with(puback, after(2ms))
+        .expect(publish_qos0_props)
+            .complete_with(success, after(1ms));
+
+    asio::io_context ioc;
+    auto executor = ioc.get_executor();
+    auto& broker = asio::make_service<test::test_broker>(
+        ioc, executor, std::move(broker_side)
+    );
+
+    using client_type = mqtt_client<test::test_stream>;
+    client_type c(executor);
+    c.brokers("127.0.0.1,127.0.0.1") // to avoid reconnect backoff
+        .async_run(asio::detached);
+
+    publish_props alias_props;
+    alias_props[prop::topic_alias] = uint16_t(1);
+    BOOST_TEST(client_type::make_publish_template(topic, alias_props).empty());
+    BOOST_TEST(client_type::make_publish_template("invalid/+", props).empty());
+
+    auto tmpl = client_type::make_publish_template(topic, props);
+    BOOST_TEST(tmpl.topic() == topic);
+
+    c.async_publish<qos_e::at_most_once>(
+        publish_template {}, payload, retain_e::no,
+        [&handlers_called](error_code ec) {
+            ++handlers_called;
+            BOOST_TEST(ec == client::error::invalid_topic);
+        }
+    );
+
+    c.async_publish<qos_e::at_least_once>(
+        tmpl, payload, retain_e::no,
+        [&handlers_called, &c, tmpl](error_code ec, reason_code rc, puback_props) {
+            ++handlers_called;
+            BOOST_TEST(!ec);
+            BOOST_TEST(rc == reason_codes::success);
+
+            BOOST_TEST(!c.try_publish(tmpl, "payload", retain_e::yes));
+        }
+    );
+
+    asio::steady_timer timer(executor);
+    timer.expires_after(100ms);
+    timer.async_wait([&c](error_code) { c.cancel(); });
+
+    ioc.run_for(2s);
+    BOOST_TEST(handlers_called == expected_handlers_called);
+    BOOST_TEST(broker.received_all_expected());
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -474,4 +474,280 @@ BOOST_FIXTURE_TEST_CASE(cancel_resending_unsubscribe, shared_test_data) {
     run_cancellation_test<test::operation_type::unsubscribe>(std::move(broker_side));
 }
 
+// re-subscribing after session loss
+
+void run_resubscribe_test(
+    test::msg_exchange broker_side,
+    const std::vector<subscribe_topic>& topics, error_code expected_ec
+) {
+    constexpr int expected_handlers_called = 2;
+    int handlers_called = 0;
+
+    asio::io_context ioc;
+    auto executor = ioc.get_executor();
+    auto& broker = asio::make_service<test::test_broker>(
+        ioc, executor, std::move(broker_side)
+    );
+
+    using client_type = mqtt_client<test::test_stream>;
+    client_type c(executor);
+    c.brokers("127.0.0.1,127.0.0.1") // to avoid reconnect backoff
+        .auto_resubscribe(true)
+        .async_run(asio::detached);
+
+    c.async_subscribe(
+        topics, subscribe_props {},
+        [&handlers_called](error_code ec, std::vector<reason_code> rcs, suback_props) {
+            ++handlers_called;
+            BOOST_TEST(!ec);
+            BOOST_TEST(rcs.size() == 2u);
+        }
+    );
+
+    c.async_receive(
+        [&handlers_called, &c, expected_ec](
+            error_code ec, std::string topic, std::string, publish_props
+        ) {
+            ++handlers_called;
+            BOOST_TEST(ec == expected_ec);
+            if (!ec)
+                BOOST_TEST(topic == "topic");
+            c.cancel();
+        }
+    );
+
+    ioc.run_for(2s);
+    BOOST_TEST(handlers_called == expected_handlers_called);
+    BOOST_TEST(broker.received_all_expected());
+}
+
+BOOST_FIXTURE_TEST_CASE(resubscribe_after_session_loss, shared_test_data) {
+    std::vector<subscribe_topic> topics = {
+        subscribe_topic { "topic", subscribe_options {} },
+        subscribe_topic { "other", subscribe_options { qos_e::at_least_once } }
+    };
+    // re-subscribed in a single packet, in the order of Topic Filters
+    std::vector<subscribe_topic> resub_topics = { topics[1], topics[0] };
+
+    // packets
+    auto subscribe_both = encoders::encode_subscribe(1, topics, subscribe_props {});
+    auto resubscribe = encoders::encode_subscribe(1, resub_topics, subscribe_props {});
+    auto suback_both = encoders::encode_suback(
+        1, { uint8_t(0x00), uint8_t(0x01) }, suback_props {}
+    );
+    auto resuback = encoders::encode_suback(
+        1, { uint8_t(0x01), uint8_t(0x00) }, suback_props {}
+    );
+    auto publish = encoders::encode_publish(
+        0, "topic", "payload", qos_e::at_most_once, retain_e::no, dup_e::no, {}
+    );
+
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(connect)
+            .complete_with(success, after(1ms))
+            .reply_with(connack, after(2ms))
+        .expect(subscribe_both)
+            .complete_with(success, after(1ms))
+            .reply_with(suback_both, after(2ms))
+        .send(fail, after(10ms))
+        .expect(connect)
+            .complete_with(success, after(1ms))
+            .reply_with(connack, after(2ms))
+        .expect(resubscribe)
+            .complete_with(success, after(1ms))
+            .reply_with(resuback, after(2ms))
+        .send(publish, after(10ms));
+
+    run_resubscribe_test(std::move(broker_side), topics, success);
+}
+
+BOOST_FIXTURE_TEST_CASE(resubscribe_rejected_after_session_loss, shared_test_data) {
+    std::vector<subscribe_topic> topics = {
+        subscribe_topic { "other", subscribe_options {} },
+        subscribe_topic { "topic", subscribe_options {} }
+    };
+
+    // packets
+    auto subscribe_both = encoders::encode_subscribe(1, topics, subscribe_props {});
+    auto suback_both = encoders::encode_suback(
+        1, { uint8_t(0x00), uint8_t(0x00) }, suback_props {}
+    );
+    auto resuback = encoders::encode_suback(
+        1, { uint8_t(0x00), uint8_t(0x87) }, suback_props {}
+    );
+
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(connect)
+            .complete_with(success, after(1ms))
+            .reply_with(connack, after(2ms))
+        .expect(subscribe_both)
+            .complete_with(success, after(1ms))
+            .reply_with(suback_both, after(2ms))
+        .send(fail, after(10ms))
+        .expect(connect)
+            .complete_with(success, after(1ms))
+            .reply_with(connack, after(2ms))
+        .expect(subscribe_both)
+            .complete_with(success, after(1ms))
+            .reply_with(resuback, after(2ms));
+
+    run_resubscribe_test(
+        std::move(broker_side), topics, client::error::session_expired
+    );
+}
+
+// coalescing
+
+BOOST_FIXTURE_TEST_CASE(coalesce_subscribe_requests, shared_test_data) {
+    constexpr int expected_handlers_called = 3;
+    int handlers_called = 0;
+
+    subscribe_props sub_id_props;
+    sub_id_props[prop::subscription_identifier] = 5;
+
+    // packets
+    auto subscribe_coalesced = encoders::encode_subscribe(
+        1,
+        {
+            subscribe_topic { "a", subscribe_options {} },
+            subscribe_topic { "b", subscribe_options {} },
+            subscribe_topic { "c", subscribe_options {} }
+        },
+        subscribe_props {}
+    );
+    auto suback_coalesced = encoders::encode_suback(
+        1, { uint8_t(0x00), uint8_t(0x01), uint8_t(0x87) }, suback_props {}
+    );
+    auto subscribe_sub_id = encoders::encode_subscribe(
+        2, { subscribe_topic { "d", subscribe_options {} } }, sub_id_props
+    );
+    auto suback_sub_id = encoders::encode_suback(
+        2, { uint8_t(0x02) }, suback_props {}
+    );
+
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(connect)
+            .complete_with(success, after(1ms))
+            .reply_with(connack, after(2ms))
+        .expect(subscribe_coalesced, subscribe_sub_id)
+            .complete_with(success, after(1ms))
+            .reply_with(suback_coalesced, suback_sub_id, after(2ms));
+
+    asio::io_context ioc;
+    auto executor = ioc.get_executor();
+    auto& broker = asio::make_service<test::test_broker>(
+        ioc, executor, std::move(broker_side)
+    );
+
+    using client_type = mqtt_client<test::test_stream>;
+    client_type c(executor);
+    c.brokers("127.0.0.1,127.0.0.1") // to avoid reconnect backoff
+        .coalesce_subscriptions(true)
+        .async_run(asio::detached);
+
+    auto count_down = [&handlers_called, &c] {
+        if (++handlers_called == expected_handlers_called)
+            c.cancel();
+    };
+
+    c.async_subscribe(
+        subscribe_topic { "a", subscribe_options {} }, subscribe_props {},
+        [&count_down](error_code ec, std::vector<reason_code> rcs, suback_props) {
+            BOOST_TEST(!ec);
+            BOOST_TEST_REQUIRE(rcs.size() == 1u);
+            BOOST_TEST(rcs[0] == reason_codes::granted_qos_0);
+            count_down();
+        }
+    );
+    c.async_subscribe(
+        {
+            subscribe_topic { "b", subscribe_options {} },
+            subscribe_topic { "c", subscribe_options {} }
+        },
+        subscribe_props {},
+        [&count_down](error_code ec, std::vector<reason_code> rcs, suback_props) {
+            BOOST_TEST(!ec);
+            BOOST_TEST_REQUIRE(rcs.size() == 2u);
+            BOOST_TEST(rcs[0] == reason_codes::granted_qos_1);
+            BOOST_TEST(rcs[1] == reason_codes::not_authorized);
+            count_down();
+        }
+    );
+    // different properties cannot share a packet
+    c.async_subscribe(
+        subscribe_topic { "d", subscribe_options {} }, sub_id_props,
+        [&count_down](error_code ec, std::vector<reason_code> rcs, suback_props) {
+            BOOST_TEST(!ec);
+            BOOST_TEST_REQUIRE(rcs.size() == 1u);
+            BOOST_TEST(rcs[0] == reason_codes::granted_qos_2);
+            count_down();
+        }
+    );
+
+    ioc.run_for(2s);
+    BOOST_TEST(handlers_called == expected_handlers_called);
+    BOOST_TEST(broker.received_all_expected());
+}
+
+BOOST_FIXTURE_TEST_CASE(coalesce_unsubscribe_requests, shared_test_data) {
+    constexpr int expected_handlers_called = 2;
+    int handlers_called = 0;
+
+    // packets
+    auto unsubscribe_coalesced = encoders::encode_unsubscribe(
+        1, { "a", "b" }, unsubscribe_props {}
+    );
+    auto unsuback_coalesced = encoders::encode_unsuback(
+        1, { uint8_t(0x00), uint8_t(0x11) }, unsuback_props {}
+    );
+
+    test::msg_exchange broker_side;
+    broker_side
+        .expect(connect)
+            .complete_with(success, after(1ms))
+            .reply_with(connack, after(2ms))
+        .expect(unsubscribe_coalesced)
+            .complete_with(success, after(1ms))
+            .reply_with(unsuback_coalesced, after(2ms));
+
+    asio::io_context ioc;
+    auto executor = ioc.get_executor();
+    auto& broker = asio::make_service<test::test_broker>(
+        ioc, executor, std::move(broker_side)
+    );
+
+    using client_type = mqtt_client<test::test_stream>;
+    client_type c(executor);
+    c.brokers("127.0.0.1,127.0.0.1") // to avoid reconnect backoff
+        .coalesce_subscriptions(true)
+        .async_run(asio::detached);
+
+    c.async_unsubscribe(
+        "a", unsubscribe_props {},
+        [&handlers_called](error_code ec, std::vector<reason_code> rcs, unsuback_props) {
+            ++handlers_called;
+            BOOST_TEST(!ec);
+            BOOST_TEST_REQUIRE(rcs.size() == 1u);
+            BOOST_TEST(rcs[0] == reason_codes::success);
+        }
+    );
+    c.async_unsubscribe(
+        "b", unsubscribe_props {},
+        [&handlers_called, &c](error_code ec, std::vector<reason_code> rcs, unsuback_props) {
+            ++handlers_called;
+            BOOST_TEST(!ec);
+            BOOST_TEST_REQUIRE(rcs.size() == 1u);
+            BOOST_TEST(rcs[0] == reason_codes::no_subscription_existed);
+            c.cancel();
+        }
+    );
+
+    ioc.run_for(2s);
+    BOOST_TEST(handlers_called == expected_handlers_called);
+    BOOST_TEST(broker.received_all_expected());
+}
+
 BOOST_AUTO_TEST_SUITE_END();
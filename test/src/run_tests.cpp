@@ -9,6 +9,49 @@
 
 #include <boost/test/included/unit_test.hpp>
 
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "test_common/allocation_counter.hpp"
+
+namespace {
+
+// Precedes every allocation, keeping the returned memory aligned.
+struct alignas(std::max_align_t) block_header {
+    std::size_t size;
+};
+
+} // end anonymous namespace
+
+// Counts the allocations and the allocated bytes checked by the allocation
+// budget tests. The array and nothrow forms of operator new and delete call these.
+void* operator new(std::size_t size) {
+    ++boost::mqtt5::test::global_allocations;
+    void* p = std::malloc(sizeof(block_header) + size);
+    if (!p)
+        throw std::bad_alloc();
+
+    auto header = static_cast<block_header*>(p);
+    header->size = size;
+    boost::mqtt5::test::global_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    return header + 1;
+}
+
+void operator delete(void* p) noexcept {
+    if (!p)
+        return;
+    auto header = static_cast<block_header*>(p) - 1;
+    boost::mqtt5::test::global_allocated_bytes.fetch_sub(
+        header->size, std::memory_order_relaxed
+    );
+    std::free(header);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    operator delete(p);
+}
+
 boost::unit_test::test_suite* init_tests(
     int /*argc*/, char* /*argv*/[]
 ) {
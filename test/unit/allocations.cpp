@@ -0,0 +1,199 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mqtt5/types.hpp>
+
+#include <boost/mqtt5/detail/control_packet.hpp>
+
+#include <boost/mqtt5/impl/codecs/message_decoders.hpp>
+#include <boost/mqtt5/impl/codecs/message_encoders.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "test_common/allocation_counter.hpp"
+
+using namespace boost::mqtt5;
+
+/*
+    Allocation budgets of the packets on the hot paths: sending and
+    receiving PUBLISH packets and their acknowledgements.
+    Each packet is encoded or decoded once before it is measured,
+    so that recycled packet buffers are warmed up.
+*/
+
+BOOST_AUTO_TEST_SUITE(allocations/*, *boost::unit_test::disabled()*/)
+
+namespace {
+
+const std::string topic = "site/57/device/33/temperature";
+const std::string payload(100, 'p');
+
+template <typename Fun>
+size_t allocations_of(Fun&& fun) {
+    fun();
+    test::allocation_scope scope;
+    fun();
+    return scope.count();
+}
+
+// Decodes the packet the way the Client does: fixed header first,
+// then the rest of the packet.
+template <typename Decode>
+void decode_packet(const std::string& packet, Decode&& decode) {
+    detail::byte_citer it = packet.cbegin();
+    auto header = decoders::decode_fixed_header(it, packet.cend());
+    BOOST_TEST_REQUIRE(header.has_value());
+    const auto& [control_byte, remain_length] = *header;
+    BOOST_TEST(decode(control_byte, remain_length, it));
+}
+
+std::string publish_packet(qos_e qos, const publish_props& props) {
+    return encoders::encode_publish(
+        qos == qos_e::at_most_once ? 0 : 1,
+        topic, payload, qos, retain_e::no, dup_e::no, props
+    );
+}
+
+const publish_props user_props = [] {
+    publish_props props;
+    props[prop::user_property].emplace_back("source", "gateway-7");
+    props[prop::user_property].emplace_back("trace", "4bf92f3577b34da6");
+    return props;
+}();
+
+} // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(send_publish) {
+    // the encoded packet is recycled
+    auto allocs = allocations_of([] {
+        auto packet = detail::control_packet::of(
+            detail::with_pid,
+            encoders::encode_publish, uint16_t(1), topic, payload,
+            qos_e::at_least_once, retain_e::no, dup_e::no, publish_props {}
+        );
+        BOOST_TEST(packet.size() > payload.size());
+    });
+    BOOST_TEST(allocs == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(send_templated_publish) {
+    publish_template tmpl {
+        encoders::encode_publish_template(topic, user_props),
+        sizeof(uint16_t) + topic.size(), false
+    };
+    auto allocs = allocations_of([&tmpl] {
+        auto packet = detail::control_packet::of(
+            detail::with_pid,
+            encoders::encode_templated_publish, uint16_t(1), tmpl, payload,
+            qos_e::at_least_once, retain_e::no, dup_e::no
+        );
+        BOOST_TEST(packet.size() > payload.size());
+    });
+    BOOST_TEST(allocs == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(send_acks) {
+    auto allocs = allocations_of([] {
+        for (auto code : {
+            detail::control_code_e::puback, detail::control_code_e::pubrec,
+            detail::control_code_e::pubrel, detail::control_code_e::pubcomp
+        }) {
+            auto ack = detail::short_packet::ack(code, 1);
+            BOOST_TEST(ack.wire_data().size() == 5u);
+        }
+    });
+    BOOST_TEST(allocs == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(receive_publish) {
+    // the Topic and the Payload are copied into the message
+    for (auto qos : { qos_e::at_most_once, qos_e::at_least_once, qos_e::exactly_once }) {
+        auto packet = publish_packet(qos, publish_props {});
+        auto allocs = allocations_of([&packet] {
+            decode_packet(packet, [](uint8_t control_byte, uint32_t remain_length, auto& it) {
+                auto rv = decoders::decode_publish(control_byte, remain_length, it);
+                if (!rv)
+                    return false;
+
+                // the Topic Alias is looked up the way the Client does
+                auto& [topic, packet_id, flags, props, payload] = *rv;
+                return !std::as_const(props)[prop::topic_alias].has_value();
+            });
+        });
+        BOOST_TEST(allocs <= 2u);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(read_unset_props) {
+    publish_props props;
+    auto allocs = allocations_of([&props] {
+        const auto& cprops = props;
+        BOOST_TEST(!cprops[prop::topic_alias].has_value());
+        BOOST_TEST(cprops[prop::user_property].empty());
+        BOOST_TEST(cprops.visit([](const auto&, const auto&) { return true; }));
+    });
+    BOOST_TEST(allocs == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(receive_publish_view) {
+    for (auto qos : { qos_e::at_most_once, qos_e::at_least_once, qos_e::exactly_once }) {
+        auto packet = publish_packet(qos, user_props);
+        auto allocs = allocations_of([&packet] {
+            decode_packet(packet, [](uint8_t control_byte, uint32_t remain_length, auto& it) {
+                auto msg = decoders::decode_publish_raw_props(
+                    control_byte, remain_length, it
+                );
+                if (!msg)
+                    return false;
+
+                const auto& [topic, packet_id, flags, raw_props, alias, payload] = *msg;
+                publish_view view { nullptr, topic, payload, raw_props };
+                size_t num_user_props = 0;
+                for (const auto& user_prop : view.user_properties()) {
+                    std::ignore = user_prop;
+                    ++num_user_props;
+                }
+                return num_user_props == 2;
+            });
+        });
+        BOOST_TEST(allocs == 0u);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(receive_acks) {
+    auto puback = encoders::encode_puback(1, 0, puback_props {});
+    auto pubrec = encoders::encode_pubrec(1, 0, pubrec_props {});
+    auto pubcomp = encoders::encode_pubcomp(1, 0, pubcomp_props {});
+
+    auto allocs = allocations_of([&] {
+        auto decode_ack = [](auto decode) {
+            return [decode](uint8_t, uint32_t remain_length, auto& it) {
+                decoders::decode_packet_id(it, it + remain_length);
+                return decode(remain_length - uint32_t(sizeof(uint16_t)), it)
+                    .has_value();
+            };
+        };
+        decode_packet(puback, decode_ack([](uint32_t remain_length, auto& it) {
+            return decoders::decode_puback(remain_length, it);
+        }));
+        decode_packet(pubrec, decode_ack([](uint32_t remain_length, auto& it) {
+            return decoders::decode_pubrec(remain_length, it);
+        }));
+        decode_packet(pubcomp, decode_ack([](uint32_t remain_length, auto& it) {
+            return decoders::decode_pubcomp(remain_length, it);
+        }));
+    });
+    BOOST_TEST(allocs == 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,67 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mqtt5/types.hpp>
+
+#include <boost/mqtt5/detail/control_packet.hpp>
+#include <boost/mqtt5/detail/packet_buffers.hpp>
+
+#include <boost/mqtt5/impl/codecs/message_encoders.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <string>
+
+using namespace boost::mqtt5;
+
+BOOST_AUTO_TEST_SUITE(packet_buffers/*, *boost::unit_test::disabled()*/)
+
+BOOST_AUTO_TEST_CASE(buffers_are_recycled) {
+    auto s = detail::packet_buffers::acquire(1000);
+    s.assign(1000, 'x');
+    const void* data = s.data();
+
+    auto size = detail::packet_buffers::size();
+    detail::packet_buffers::release(std::move(s));
+    BOOST_TEST(detail::packet_buffers::size() == size + 1);
+
+    auto recycled = detail::packet_buffers::acquire(100);
+    BOOST_TEST(recycled.empty());
+    BOOST_TEST(static_cast<const void*>(recycled.data()) == data);
+    BOOST_TEST(detail::packet_buffers::size() == size);
+}
+
+BOOST_AUTO_TEST_CASE(large_buffers_are_not_kept) {
+    auto size = detail::packet_buffers::size();
+    detail::packet_buffers::release(std::string(1024 * 1024, 'x'));
+    detail::packet_buffers::release(std::string());
+    BOOST_TEST(detail::packet_buffers::size() == size);
+}
+
+BOOST_AUTO_TEST_CASE(control_packet_releases_buffer) {
+    const std::string payload(100, 'p');
+
+    const void* data = nullptr;
+    {
+        auto packet = detail::control_packet::of(
+            detail::with_pid,
+            encoders::encode_publish, uint16_t(1), "topic", payload,
+            qos_e::at_least_once, retain_e::no, dup_e::no, publish_props {}
+        );
+        data = packet.wire_data().data();
+    }
+
+    // the next packet is encoded into the same buffer
+    auto publish = encoders::encode_publish(
+        1, "topic", payload,
+        qos_e::at_least_once, retain_e::no, dup_e::no, publish_props {}
+    );
+    BOOST_TEST(static_cast<const void*>(publish.data()) == data);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
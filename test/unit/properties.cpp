@@ -0,0 +1,79 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mqtt5/property_types.hpp>
+#include <boost/mqtt5/types.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+using namespace boost::mqtt5;
+
+BOOST_AUTO_TEST_SUITE(properties/*, *boost::unit_test::disabled()*/)
+
+static_assert(sizeof(publish_props) == sizeof(void*));
+static_assert(sizeof(connack_props) == sizeof(void*));
+
+BOOST_AUTO_TEST_CASE(empty_properties) {
+    const publish_props props;
+    BOOST_TEST(!props[prop::content_type].has_value());
+    BOOST_TEST(!props[prop::message_expiry_interval].has_value());
+    BOOST_TEST(props[prop::user_property].empty());
+    BOOST_TEST(props[prop::subscription_identifier].empty());
+
+    int visited = 0;
+    props.visit([&visited](auto, const auto&) { ++visited; return true; });
+    BOOST_TEST(visited == 8);
+}
+
+BOOST_AUTO_TEST_CASE(copy_and_move) {
+    publish_props props;
+    props[prop::content_type] = "text/plain";
+    props[prop::user_property].emplace_back("key", "value");
+
+    publish_props copy = props;
+    copy[prop::content_type] = "application/json";
+    BOOST_TEST(*props[prop::content_type] == "text/plain");
+    BOOST_TEST(*copy[prop::content_type] == "application/json");
+    BOOST_TEST(copy[prop::user_property] == props[prop::user_property]);
+
+    publish_props moved = std::move(copy);
+    BOOST_TEST(*moved[prop::content_type] == "application/json");
+
+    copy = moved;
+    BOOST_TEST(*copy[prop::content_type] == "application/json");
+
+    copy = publish_props {};
+    BOOST_TEST(!copy[prop::content_type].has_value());
+    BOOST_TEST(copy[prop::user_property].empty());
+}
+
+BOOST_AUTO_TEST_CASE(apply_on) {
+    publish_props props;
+
+    bool unknown = props.apply_on(
+        prop::maximum_qos_t, [](auto&) { BOOST_FAIL("not a publish property"); }
+    );
+    BOOST_TEST(unknown);
+
+    unknown = props.apply_on(
+        prop::topic_alias_t,
+        [](auto& val) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(val)>, std::optional<uint16_t>>)
+                val = uint16_t(5);
+        }
+    );
+    BOOST_TEST(!unknown);
+    BOOST_TEST(*props[prop::topic_alias] == 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
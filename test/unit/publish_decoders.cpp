@@ -0,0 +1,326 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mqtt5/types.hpp>
+
+#include <boost/mqtt5/impl/codecs/base_decoders.hpp>
+#include <boost/mqtt5/impl/codecs/message_decoders.hpp>
+#include <boost/mqtt5/impl/codecs/message_encoders.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <random>
+#include <string>
+#include <tuple>
+
+using namespace boost::mqtt5;
+using byte_citer = detail::byte_citer;
+
+BOOST_AUTO_TEST_SUITE(publish_decoders/*, *boost::unit_test::disabled()*/)
+
+// The Spirit X3 grammars the hand-written decoders replaced.
+namespace reference {
+
+namespace dec = boost::mqtt5::decoders;
+namespace x3 = boost::spirit::x3;
+
+std::optional<dec::publish_message> decode_publish(
+    uint8_t control_byte, uint32_t remain_length, byte_citer& it
+) {
+    uint8_t flags = control_byte & 0b1111;
+    auto qos = qos_e((flags >> 1) & 0b11);
+
+    auto publish_ = dec::basic::scope_limit_(remain_length)[
+        dec::basic::utf8_ >>
+            dec::basic::if_(qos != qos_e::at_most_once)[x3::big_word] >>
+            x3::attr(flags) >> dec::prop::props_<publish_props> >>
+            dec::basic::verbatim_
+    ];
+    return dec::type_parse(it, it + remain_length, publish_);
+}
+
+template <typename Props>
+std::optional<std::tuple<uint8_t, Props>> decode_ack(
+    uint32_t remain_length, byte_citer& it
+) {
+    if (remain_length == 0)
+        return std::tuple<uint8_t, Props> {};
+    auto ack_ = dec::basic::scope_limit_(remain_length)[
+        x3::byte_ >> dec::prop::props_<Props>
+    ];
+    return dec::type_parse(it, it + remain_length, ack_);
+}
+
+} // end namespace reference
+
+template <typename Props>
+std::string encoded(const Props& props) {
+    std::string s;
+    s << encoders::prop::props_(props);
+    return s;
+}
+
+class generator {
+    std::mt19937 _gen { 5489u };
+
+public:
+    size_t uniform(size_t max) {
+        return std::uniform_int_distribution<size_t>(0, max)(_gen);
+    }
+
+    bool coin() {
+        return uniform(1);
+    }
+
+    std::string bytes(size_t max_len) {
+        std::string s(uniform(max_len), '\0');
+        for (auto& c : s)
+            c = char(uniform(255));
+        return s;
+    }
+
+    publish_props publish_properties() {
+        publish_props props;
+        if (coin())
+            props[prop::payload_format_indicator] = uint8_t(uniform(1));
+        if (coin())
+            props[prop::message_expiry_interval] = uint32_t(uniform(100'000));
+        if (coin())
+            props[prop::content_type] = bytes(10);
+        if (coin())
+            props[prop::correlation_data] = bytes(10);
+        if (coin())
+            props[prop::topic_alias] = uint16_t(uniform(100));
+        for (size_t i = uniform(2); i > 0; --i)
+            props[prop::subscription_identifier].push_back(
+                int32_t(uniform(268'435'455))
+            );
+        for (size_t i = uniform(2); i > 0; --i)
+            props[prop::user_property].emplace_back(bytes(5), bytes(5));
+        return props;
+    }
+
+    puback_props ack_properties() {
+        puback_props props;
+        if (coin())
+            props[prop::reason_string] = bytes(10);
+        for (size_t i = uniform(2); i > 0; --i)
+            props[prop::user_property].emplace_back(bytes(5), bytes(5));
+        return props;
+    }
+
+    // The packet itself, shortened or with a corrupted byte.
+    std::string variant(std::string body) {
+        switch (uniform(2)) {
+            case 0:
+                return body;
+            case 1:
+                return body.substr(0, uniform(body.size()));
+            default:
+                if (!body.empty())
+                    body[uniform(body.size() - 1)] = char(uniform(255));
+                return body;
+        }
+    }
+};
+
+// Splits the packet into the control byte and the bytes after the fixed header.
+std::tuple<uint8_t, std::string> split(const std::string& packet) {
+    byte_citer it = packet.cbegin();
+    auto header = decoders::decode_fixed_header(it, packet.cend());
+    return { std::get<0>(*header), std::string(it, packet.cend()) };
+}
+
+BOOST_AUTO_TEST_CASE(publish_matches_reference) {
+    constexpr int iterations = 5000;
+    generator gen;
+
+    for (int i = 0; i < iterations; ++i) {
+        auto packet = encoders::encode_publish(
+            uint16_t(gen.uniform(65535)), gen.bytes(20), gen.bytes(50),
+            qos_e(gen.uniform(3)), retain_e(gen.uniform(1)), dup_e(gen.uniform(1)),
+            gen.publish_properties()
+        );
+        auto [control_byte, body] = split(packet);
+        body = gen.variant(std::move(body));
+        auto remain_length = static_cast<uint32_t>(body.size());
+
+        byte_citer it = body.cbegin(), ref_it = body.cbegin();
+        auto rv = decoders::decode_publish(control_byte, remain_length, it);
+        auto ref = reference::decode_publish(control_byte, remain_length, ref_it);
+
+        BOOST_TEST_REQUIRE(rv.has_value() == ref.has_value());
+        BOOST_TEST_REQUIRE((it == ref_it));
+        if (!rv)
+            continue;
+
+        const auto& [topic, packet_id, flags, props, payload] = *rv;
+        const auto& [ref_topic, ref_packet_id, ref_flags, ref_props, ref_payload] = *ref;
+        BOOST_TEST(topic == ref_topic);
+        BOOST_TEST((packet_id == ref_packet_id));
+        BOOST_TEST(flags == ref_flags);
+        BOOST_TEST(encoded(props) == encoded(ref_props));
+        BOOST_TEST(payload == ref_payload);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ack_matches_reference) {
+    constexpr int iterations = 5000;
+    generator gen;
+
+    for (int i = 0; i < iterations; ++i) {
+        auto packet = encoders::encode_puback(
+            uint16_t(gen.uniform(65535)), uint8_t(gen.uniform(255)),
+            gen.ack_properties()
+        );
+        // the Packet Identifier is decoded before the rest of the packet
+        auto body = gen.variant(std::get<1>(split(packet)).substr(2));
+        auto remain_length = static_cast<uint32_t>(body.size());
+
+        byte_citer it = body.cbegin(), ref_it = body.cbegin();
+        auto rv = decoders::decode_puback(remain_length, it);
+        auto ref = reference::decode_ack<puback_props>(remain_length, ref_it);
+
+        BOOST_TEST_REQUIRE(rv.has_value() == ref.has_value());
+        BOOST_TEST_REQUIRE((it == ref_it));
+        if (!rv)
+            continue;
+
+        BOOST_TEST(std::get<0>(*rv) == std::get<0>(*ref));
+        BOOST_TEST(encoded(std::get<1>(*rv)) == encoded(std::get<1>(*ref)));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(publish_view_refers_to_packet) {
+    auto packet = encoders::encode_publish(
+        7, "topic", "payload", qos_e::at_least_once, retain_e::no, dup_e::no, {}
+    );
+    auto [control_byte, body] = split(packet);
+
+    byte_citer it = body.cbegin();
+    auto rv = decoders::decode_publish_view(
+        control_byte, static_cast<uint32_t>(body.size()), it
+    );
+    BOOST_TEST_REQUIRE(rv.has_value());
+    BOOST_TEST((it == body.cend()));
+
+    const auto& [topic, packet_id, flags, props, payload] = *rv;
+    BOOST_TEST(topic == "topic");
+    BOOST_TEST(static_cast<const void*>(topic.data()) == body.data() + 2);
+    BOOST_TEST(*packet_id == 7);
+    BOOST_TEST(payload == "payload");
+}
+
+BOOST_AUTO_TEST_CASE(raw_props_match_publish_view) {
+    constexpr int iterations = 5000;
+    generator gen;
+
+    for (int i = 0; i < iterations; ++i) {
+        auto packet = encoders::encode_publish(
+            uint16_t(gen.uniform(65535)), gen.bytes(20), gen.bytes(50),
+            qos_e(gen.uniform(3)), retain_e(gen.uniform(1)), dup_e(gen.uniform(1)),
+            gen.publish_properties()
+        );
+        auto [control_byte, body] = split(packet);
+        body = gen.variant(std::move(body));
+        auto remain_length = static_cast<uint32_t>(body.size());
+
+        byte_citer it = body.cbegin(), ref_it = body.cbegin();
+        auto rv = decoders::decode_publish_raw_props(control_byte, remain_length, it);
+        auto ref = decoders::decode_publish_view(control_byte, remain_length, ref_it);
+
+        BOOST_TEST_REQUIRE(rv.has_value() == ref.has_value());
+        BOOST_TEST_REQUIRE((it == ref_it));
+        if (!rv)
+            continue;
+
+        const auto& [topic, packet_id, flags, raw_props, topic_alias, payload] = *rv;
+        const auto& [ref_topic, ref_packet_id, ref_flags, ref_props, ref_payload] = *ref;
+        BOOST_TEST(topic == ref_topic);
+        BOOST_TEST((packet_id == ref_packet_id));
+        BOOST_TEST(flags == ref_flags);
+        BOOST_TEST((topic_alias == ref_props[prop::topic_alias]));
+        BOOST_TEST(payload == ref_payload);
+
+        publish_view view { nullptr, topic, payload, raw_props };
+        BOOST_TEST(encoded(view.props()) == encoded(ref_props));
+
+        const auto& ref_user_props = ref_props[prop::user_property];
+        size_t num_user_props = 0;
+        for (const auto& [key, val] : view.user_properties()) {
+            BOOST_TEST_REQUIRE(num_user_props < ref_user_props.size());
+            BOOST_TEST(key == ref_user_props[num_user_props].first);
+            BOOST_TEST(val == ref_user_props[num_user_props].second);
+            ++num_user_props;
+        }
+        BOOST_TEST(num_user_props == ref_user_props.size());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(user_properties_stop_at_malformed_property) {
+    publish_props props;
+    props[prop::user_property].emplace_back("key", "value");
+    auto raw = encoded(props).substr(1);
+    // the second User Property is cut short
+    raw += raw.substr(0, raw.size() - 1);
+
+    publish_view view { nullptr, "topic", "payload", raw };
+    auto it = view.user_properties().begin();
+    BOOST_TEST_REQUIRE((it != view.user_properties().end()));
+    BOOST_TEST(it->first == "key");
+    BOOST_TEST(it->second == "value");
+    BOOST_TEST((++it == view.user_properties().end()));
+}
+
+BOOST_AUTO_TEST_CASE(user_properties_with_empty_keys) {
+    publish_props props;
+    props[prop::user_property].emplace_back("", "first");
+    props[prop::user_property].emplace_back("", "second");
+    auto raw = encoded(props).substr(1);
+
+    publish_view view { nullptr, "topic", "payload", raw };
+    auto it = view.user_properties().begin();
+    auto next = std::next(it);
+    BOOST_TEST_REQUIRE((next != view.user_properties().end()));
+    BOOST_TEST((it != next));
+    BOOST_TEST(it->second == "first");
+    BOOST_TEST(next->second == "second");
+    BOOST_TEST((++it == next));
+    BOOST_TEST((++next == view.user_properties().end()));
+}
+
+BOOST_AUTO_TEST_CASE(release_discards_undecoded_props) {
+    publish_props props;
+    props[prop::content_type] = "text/plain";
+    auto raw = encoded(props).substr(1);
+
+    publish_view view { nullptr, "topic", "payload", raw };
+    BOOST_TEST(*view.props()[prop::content_type] == "text/plain");
+    view.release();
+    BOOST_TEST(*view.props()[prop::content_type] == "text/plain");
+
+    publish_view undecoded { nullptr, "topic", "payload", raw };
+    undecoded.release();
+    BOOST_TEST(!undecoded.props()[prop::content_type].has_value());
+    BOOST_TEST((undecoded.user_properties().begin() == undecoded.user_properties().end()));
+}
+
+BOOST_AUTO_TEST_CASE(property_length_out_of_bounds) {
+    // PUBACK with Reason Code 0x10 and a Property Length of 100
+    std::string body = { char(0x10), char(100), char(0x1F), char(0), char(0) };
+
+    byte_citer it = body.cbegin();
+    auto rv = decoders::decode_puback(static_cast<uint32_t>(body.size()), it);
+    BOOST_TEST(!rv.has_value());
+    BOOST_TEST((it == body.cbegin()));
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,126 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mqtt5/detail/control_packet.hpp>
+#include <boost/mqtt5/detail/internal_types.hpp>
+#include <boost/mqtt5/detail/timer_wheel.hpp>
+
+#include <boost/mqtt5/impl/replies.hpp>
+
+#include <boost/asio/error.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <string>
+
+using namespace boost::mqtt5;
+namespace asio = boost::asio;
+using error_code = boost::system::error_code;
+using detail::byte_citer;
+using detail::control_code_e;
+using detail::timer_wheel;
+
+using namespace std::chrono_literals;
+
+BOOST_AUTO_TEST_SUITE(replies/*, *boost::unit_test::disabled()*/)
+
+BOOST_AUTO_TEST_CASE(deadline_per_reply) {
+    constexpr int expected_handlers_called = 2;
+    int handlers_called = 0;
+
+    asio::io_context ioc;
+    auto& wheel = asio::use_service<timer_wheel>(ioc);
+    detail::replies<> r(ioc.get_executor());
+
+    r.async_wait_reply(
+        control_code_e::puback, 1,
+        [&handlers_called](error_code ec, byte_citer first, byte_citer last) {
+            ++handlers_called;
+            BOOST_TEST(!ec);
+            BOOST_TEST(std::string(first, last) == "puback");
+        }
+    );
+    r.async_wait_reply(
+        control_code_e::puback, 2,
+        [&handlers_called](error_code ec, byte_citer, byte_citer) {
+            ++handlers_called;
+            BOOST_TEST(ec == asio::error::operation_aborted);
+        }
+    );
+    BOOST_TEST(wheel.num_waits() == 2u);
+
+    // the deadline is removed together with the reply
+    const std::string puback = "puback";
+    r.dispatch(
+        error_code {}, control_code_e::puback, 1, puback.cbegin(), puback.cend()
+    );
+    BOOST_TEST(wheel.num_waits() == 1u);
+
+    r.cancel_unanswered();
+    BOOST_TEST(wheel.num_waits() == 0u);
+
+    auto start = timer_wheel::clock_type::now();
+    ioc.run();
+    BOOST_TEST((timer_wheel::clock_type::now() - start < 1s));
+    BOOST_TEST(handlers_called == expected_handlers_called);
+}
+
+BOOST_AUTO_TEST_CASE(resend_rearms_deadline) {
+    constexpr int expected_handlers_called = 2;
+    int handlers_called = 0;
+
+    asio::io_context ioc;
+    auto& wheel = asio::use_service<timer_wheel>(ioc);
+    detail::replies<> r(ioc.get_executor());
+
+    r.async_wait_reply(
+        control_code_e::pubrec, 1,
+        [&](error_code ec, byte_citer, byte_citer) {
+            ++handlers_called;
+            BOOST_TEST(ec == asio::error::try_again);
+            BOOST_TEST(wheel.num_waits() == 0u);
+
+            // as the PUBLISH packet waiting for its reply again
+            r.async_wait_reply(
+                control_code_e::pubrec, 1,
+                [&handlers_called](error_code ec, byte_citer, byte_citer) {
+                    ++handlers_called;
+                    BOOST_TEST(ec == asio::error::operation_aborted);
+                }
+            );
+        }
+    );
+
+    r.resend_unanswered();
+    BOOST_TEST(wheel.num_waits() == 1u);
+
+    r.cancel_unanswered();
+    BOOST_TEST(wheel.num_waits() == 0u);
+
+    ioc.run();
+    BOOST_TEST(handlers_called == expected_handlers_called);
+}
+
+BOOST_AUTO_TEST_CASE(cancel_expired_wait) {
+    constexpr int expected_handlers_called = 1;
+    int handlers_called = 0;
+
+    asio::io_context ioc;
+    detail::replies<> r(ioc.get_executor());
+
+    r.async_wait_expired([&handlers_called](error_code ec) {
+        ++handlers_called;
+        BOOST_TEST(ec == asio::error::operation_aborted);
+    });
+    r.cancel_expired_wait();
+
+    ioc.run();
+    BOOST_TEST(handlers_called == expected_handlers_called);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
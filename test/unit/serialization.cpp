@@ -8,6 +8,8 @@
 #include <boost/mqtt5/reason_codes.hpp>
 #include <boost/mqtt5/types.hpp>
 
+#include <boost/mqtt5/detail/control_packet.hpp>
+
 #include <boost/mqtt5/impl/codecs/message_decoders.hpp>
 #include <boost/mqtt5/impl/codecs/message_encoders.hpp>
 
@@ -269,6 +271,94 @@ BOOST_AUTO_TEST_CASE(test_publish) {
     BOOST_TEST(*pprops_[prop::content_type] == content_type);
 }
 
+BOOST_AUTO_TEST_CASE(test_publish_view) {
+    // testing variables
+    uint16_t packet_id = 31283;
+    std::string_view topic = "publish_topic";
+    std::string_view payload = "This is some payload I am publishing!";
+    std::string content_type = "application/octet-stream";
+
+    publish_props pprops;
+    pprops[prop::content_type] = content_type;
+
+    auto msg = encoders::encode_publish(
+        packet_id, topic, payload,
+        qos_e::exactly_once, retain_e::no, dup_e::yes,
+        pprops
+    );
+
+    byte_citer it = msg.cbegin(), last = msg.cend();
+    auto header = decoders::decode_fixed_header(it, last);
+    BOOST_TEST_REQUIRE(header.has_value());
+
+    const auto& [control_byte, remain_length] = *header;
+    auto rv = decoders::decode_publish_view(control_byte, remain_length, it);
+    BOOST_TEST_REQUIRE(rv.has_value());
+    BOOST_TEST((it == last));
+
+    const auto& [topic_, packet_id_, flags, pprops_, payload_] = *rv;
+    BOOST_TEST_REQUIRE(packet_id_.has_value());
+    BOOST_TEST(*packet_id_ == packet_id);
+    BOOST_TEST(flags == (control_byte & 0b1111));
+    BOOST_TEST(topic_ == topic);
+    BOOST_TEST(payload_ == payload);
+    BOOST_TEST(*pprops_[prop::content_type] == content_type);
+
+    // views refer to the encoded message, nothing is copied
+    BOOST_TEST((topic_.data() >= msg.data() && topic_.data() < msg.data() + msg.size()));
+    BOOST_TEST((payload_.data() + payload_.size() == msg.data() + msg.size()));
+}
+
+BOOST_AUTO_TEST_CASE(test_publish_view_empty_payload) {
+    auto msg = encoders::encode_publish(
+        0, "t", "", qos_e::at_most_once, retain_e::no, dup_e::no, {}
+    );
+
+    byte_citer it = msg.cbegin(), last = msg.cend();
+    auto header = decoders::decode_fixed_header(it, last);
+    BOOST_TEST_REQUIRE(header.has_value());
+
+    const auto& [control_byte, remain_length] = *header;
+    auto rv = decoders::decode_publish_view(control_byte, remain_length, it);
+    BOOST_TEST_REQUIRE(rv.has_value());
+
+    const auto& [topic_, packet_id_, flags, pprops_, payload_] = *rv;
+    BOOST_TEST(!packet_id_.has_value());
+    BOOST_TEST(topic_ == "t");
+    BOOST_TEST(payload_.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_templated_publish) {
+    uint16_t packet_id = 31283;
+    std::string topic = "publish_topic";
+    std::string payload(100, 'p');
+
+    publish_props pprops;
+    pprops[prop::message_expiry_interval] = 70;
+    pprops[prop::content_type] = "application/octet-stream";
+    pprops[prop::user_property].emplace_back("key", "val");
+
+    for (const auto& props : { publish_props {}, pprops }) {
+        publish_template tmpl {
+            encoders::encode_publish_template(topic, props),
+            topic.size() + 2, false
+        };
+        BOOST_TEST(tmpl.topic() == topic);
+
+        for (auto qos : { qos_e::at_most_once, qos_e::at_least_once, qos_e::exactly_once })
+            for (auto retain : { retain_e::no, retain_e::yes })
+                for (auto dup : { dup_e::no, dup_e::yes }) {
+                    auto msg = encoders::encode_templated_publish(
+                        packet_id, tmpl, payload, qos, retain, dup
+                    );
+                    auto expected = encoders::encode_publish(
+                        packet_id, topic, payload, qos, retain, dup, props
+                    );
+                    BOOST_TEST(msg == expected);
+                }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(test_large_publish) {
     // testing variables
     uint16_t packet_id = 40001;
@@ -315,7 +405,7 @@ BOOST_AUTO_TEST_CASE(test_puback) {
     auto header = decoders::decode_fixed_header(it, last);
     BOOST_TEST_REQUIRE(header.has_value());
 
-    auto packet_id_ = decoders::decode_packet_id(it);
+    auto packet_id_ = decoders::decode_packet_id(it, last);
     BOOST_TEST_REQUIRE(packet_id_.has_value());
     BOOST_TEST(*packet_id_ == packet_id);
 
@@ -351,7 +441,7 @@ BOOST_AUTO_TEST_CASE(test_pubrec) {
     auto header = decoders::decode_fixed_header(it, last);
     BOOST_TEST_REQUIRE(header.has_value());
 
-    auto packet_id_ = decoders::decode_packet_id(it);
+    auto packet_id_ = decoders::decode_packet_id(it, last);
     BOOST_TEST_REQUIRE(packet_id_.has_value());
     BOOST_TEST(*packet_id_ == packet_id);
 
@@ -387,7 +477,7 @@ BOOST_AUTO_TEST_CASE(test_pubrel) {
     auto header = decoders::decode_fixed_header(it, last);
     BOOST_TEST_REQUIRE(header.has_value());
 
-    auto packet_id_ = decoders::decode_packet_id(it);
+    auto packet_id_ = decoders::decode_packet_id(it, last);
     BOOST_TEST_REQUIRE(packet_id_.has_value());
     BOOST_TEST(*packet_id_ == packet_id);
 
@@ -423,7 +513,7 @@ BOOST_AUTO_TEST_CASE(test_pubcomp) {
     auto header = decoders::decode_fixed_header(it, last);
     BOOST_TEST_REQUIRE(header.has_value());
 
-    auto packet_id_ = decoders::decode_packet_id(it);
+    auto packet_id_ = decoders::decode_packet_id(it, last);
     BOOST_TEST_REQUIRE(packet_id_.has_value());
     BOOST_TEST(*packet_id_ == packet_id);
 
@@ -440,6 +530,19 @@ BOOST_AUTO_TEST_CASE(test_pubcomp) {
     BOOST_TEST(pprops_[prop::user_property][0].second == user_property_2);
 }
 
+BOOST_AUTO_TEST_CASE(truncated_packet_id) {
+    auto msg = encoders::encode_puback(21455, 0x00, puback_props {});
+
+    // the packet ends after the first byte of the Packet Identifier
+    byte_citer first = msg.cbegin() + 2, last = first + 1;
+    byte_citer it = first;
+    BOOST_TEST(!decoders::decode_packet_id(it, last).has_value());
+    BOOST_TEST((it == first));
+
+    BOOST_TEST(!decoders::decode_packet_id(it, first).has_value());
+    BOOST_TEST((it == first));
+}
+
 BOOST_AUTO_TEST_CASE(test_subscribe) {
     //testing variables
     int32_t sub_id = 1'234'567;
@@ -470,7 +573,7 @@ BOOST_AUTO_TEST_CASE(test_subscribe) {
     BOOST_TEST_REQUIRE(header.has_value());
 
     const auto& [control_byte, remain_length] = *header;
-    auto packet_id_ = decoders::decode_packet_id(it);
+    auto packet_id_ = decoders::decode_packet_id(it, last);
     BOOST_TEST_REQUIRE(packet_id_.has_value());
     BOOST_TEST(*packet_id_ == packet_id);
     auto rv = decoders::decode_subscribe(remain_length - sizeof(uint16_t), it);
@@ -514,7 +617,7 @@ BOOST_AUTO_TEST_CASE(test_suback) {
     BOOST_TEST_REQUIRE(header.has_value());
 
     const auto& [control_byte, remain_length] = *header;
-    auto packet_id_ = decoders::decode_packet_id(it);
+    auto packet_id_ = decoders::decode_packet_id(it, last);
     BOOST_TEST_REQUIRE(packet_id_.has_value());
     BOOST_TEST(*packet_id_ == packet_id);
     auto rv = decoders::decode_suback(remain_length - sizeof(uint16_t), it);
@@ -548,7 +651,7 @@ BOOST_AUTO_TEST_CASE(test_unsubscribe) {
     BOOST_TEST_REQUIRE(header.has_value());
 
     const auto& [control_byte, remain_length] = *header;
-    auto packet_id_ = decoders::decode_packet_id(it);
+    auto packet_id_ = decoders::decode_packet_id(it, last);
     BOOST_TEST_REQUIRE(packet_id_.has_value());
     BOOST_TEST(*packet_id_ == packet_id);
     auto rv = decoders::decode_unsubscribe(remain_length - sizeof(uint16_t), it);
@@ -583,7 +686,7 @@ BOOST_AUTO_TEST_CASE(test_unsuback) {
     BOOST_TEST_REQUIRE(header.has_value());
 
     const auto& [control_byte, remain_length] = *header;
-    auto packet_id_ = decoders::decode_packet_id(it);
+    auto packet_id_ = decoders::decode_packet_id(it, last);
     BOOST_TEST_REQUIRE(packet_id_.has_value());
     BOOST_TEST(*packet_id_ == packet_id);
     auto rv = decoders::decode_unsuback(remain_length - sizeof(uint16_t), it);
@@ -745,7 +848,7 @@ BOOST_AUTO_TEST_CASE(deserialize_user_property) {
     byte_citer it = msg.cbegin(), last = msg.cend();
     auto header = decoders::decode_fixed_header(it, last);
     BOOST_TEST_REQUIRE(header.has_value());
-    auto packet_id_ = decoders::decode_packet_id(it);
+    auto packet_id_ = decoders::decode_packet_id(it, last);
     BOOST_TEST_REQUIRE(packet_id_.has_value());
     const auto& [control_byte, remain_length] = *header;
     auto rv = decoders::decode_puback(remain_length - sizeof(uint16_t), it);
@@ -768,7 +871,7 @@ BOOST_AUTO_TEST_CASE(deserialize_empty_user_property) {
     byte_citer it = msg.cbegin(), last = msg.cend();
     auto header = decoders::decode_fixed_header(it, last);
     BOOST_TEST_REQUIRE(header.has_value());
-    auto packet_id_ = decoders::decode_packet_id(it);
+    auto packet_id_ = decoders::decode_packet_id(it, last);
     BOOST_TEST_REQUIRE(packet_id_.has_value());
     const auto& [control_byte, remain_length] = *header;
     auto rv = decoders::decode_puback(remain_length - sizeof(uint16_t), it);
@@ -791,7 +894,7 @@ BOOST_AUTO_TEST_CASE(malformed_user_property) {
     byte_citer it = msg.cbegin(), last = msg.cend();
     auto header = decoders::decode_fixed_header(it, last);
     BOOST_TEST_REQUIRE(header.has_value());
-    auto packet_id_ = decoders::decode_packet_id(it);
+    auto packet_id_ = decoders::decode_packet_id(it, last);
     BOOST_TEST_REQUIRE(packet_id_.has_value());
     const auto& [control_byte, remain_length] = *header;
     auto rv = decoders::decode_puback(remain_length - sizeof(uint16_t), it);
@@ -808,11 +911,33 @@ BOOST_AUTO_TEST_CASE(malformed_reason_string) {
     byte_citer it = msg.cbegin(), last = msg.cend();
     auto header = decoders::decode_fixed_header(it, last);
     BOOST_TEST_REQUIRE(header.has_value());
-    auto packet_id_ = decoders::decode_packet_id(it);
+    auto packet_id_ = decoders::decode_packet_id(it, last);
     BOOST_TEST_REQUIRE(packet_id_.has_value());
     const auto& [control_byte, remain_length] = *header;
     auto rv = decoders::decode_puback(remain_length - sizeof(uint16_t), it);
     BOOST_TEST(!rv);
 }
 
+BOOST_AUTO_TEST_CASE(test_short_packets) {
+    using detail::control_code_e;
+    using detail::short_packet;
+
+    uint16_t packet_id = 40213;
+
+    auto puback = short_packet::ack(control_code_e::puback, packet_id);
+    BOOST_TEST(puback.wire_data() == encoders::encode_puback(packet_id, 0, {}));
+    BOOST_TEST(puback.packet_id() == packet_id);
+
+    auto pubrec = short_packet::ack(control_code_e::pubrec, packet_id);
+    BOOST_TEST(pubrec.wire_data() == encoders::encode_pubrec(packet_id, 0, {}));
+
+    auto pubrel = short_packet::ack(control_code_e::pubrel, packet_id);
+    BOOST_TEST(pubrel.wire_data() == encoders::encode_pubrel(packet_id, 0, {}));
+
+    auto pubcomp = short_packet::ack(control_code_e::pubcomp, packet_id);
+    BOOST_TEST(pubcomp.wire_data() == encoders::encode_pubcomp(packet_id, 0, {}));
+
+    BOOST_TEST(short_packet::pingreq().wire_data() == encoders::encode_pingreq());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -10,7 +10,10 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <cstddef>
+#include <random>
 #include <string>
+#include <string_view>
 
 BOOST_AUTO_TEST_SUITE(utf8_mqtt/*, *boost::unit_test::disabled()*/)
 
@@ -149,4 +152,129 @@ BOOST_AUTO_TEST_CASE(shared_topic_filter_validation) {
     BOOST_CHECK(validate_shared_topic_filter("$share/grp/topic/+", false) == validation_result::has_wildcard_character);
 }
 
+namespace reference {
+
+using namespace boost::mqtt5::detail;
+
+// Validation one code point at a time, as done before
+// the runs of plain ASCII characters were skipped in blocks.
+
+template <typename ValidSizeCondition, typename ValidCondition>
+validation_result validate_impl(
+    std::string_view str,
+    ValidSizeCondition&& size_condition, ValidCondition&& condition
+) {
+    if (!size_condition(str.size()))
+        return validation_result::invalid;
+
+    validation_result result;
+    while (!str.empty()) {
+        int c = pop_front_unichar(str);
+
+        result = validate_mqtt_utf8_char(c);
+        if (!condition(result))
+            return result;
+    }
+
+    return validation_result::valid;
+}
+
+validation_result validate_topic_filter(std::string_view str) {
+    if (!is_valid_topic_size(str.size()))
+        return validation_result::invalid;
+
+    if (str.back() == '#') {
+        str.remove_suffix(1);
+
+        if (!str.empty() && str.back() != '/')
+            return validation_result::invalid;
+    }
+
+    int last_c = -1;
+    while (!str.empty()) {
+        int c = pop_front_unichar(str);
+
+        bool is_valid_single_lvl = (c == '+') &&
+            (str.empty() || str.front() == '/') &&
+            (last_c == -1 || last_c == '/');
+
+        if (validate_mqtt_utf8_char(c) == validation_result::valid || is_valid_single_lvl) {
+            last_c = c;
+            continue;
+        }
+
+        return validation_result::invalid;
+    }
+
+    return validation_result::valid;
+}
+
+} // end namespace reference
+
+// Mostly plain ASCII with occasional wildcards, separators,
+// control characters, multibyte sequences and stray bytes.
+std::string random_string(std::mt19937& rng, size_t max_size) {
+    static const std::string specials[] = {
+        "#", "+", "/", "\x00", "\x1F", "\x7F",
+        to_str(0x9F), to_str(0xA0), to_str(0xD800), to_str(0xFDD0),
+        to_str(0x1F600), to_str(0x1FFFF), "\xC3", "\x80", "\xF0\x9F", "\xFF"
+    };
+    constexpr size_t num_specials = sizeof(specials) / sizeof(specials[0]);
+
+    std::uniform_int_distribution<size_t> size_dist(0, max_size);
+    std::uniform_int_distribution<int> printable(0x20, 0x7E);
+    std::uniform_int_distribution<int> pick(0, 99);
+    std::uniform_int_distribution<size_t> special(0, num_specials - 1);
+
+    size_t size = size_dist(rng);
+    std::string s;
+    while (s.size() < size) {
+        if (pick(rng) < 95)
+            s += char(printable(rng));
+        else
+            s += specials[special(rng)];
+    }
+    return s;
+}
+
+BOOST_AUTO_TEST_CASE(plain_ascii_prefix_blocks) {
+    using namespace boost::mqtt5::detail;
+
+    std::string buffer(200, 'a');
+    for (size_t offset = 0; offset < 32; ++offset)
+        for (size_t size = 0; size + offset <= 100; ++size) {
+            std::string_view s(buffer.data() + offset, size);
+            BOOST_TEST(plain_ascii_prefix(s) == size);
+        }
+
+    const char stoppers[] = { '\x00', '\x1F', '\x7F', '\x80', '\xFF', '#', '+' };
+    for (char stopper : stoppers)
+        for (size_t pos = 0; pos < 100; ++pos) {
+            std::string s(100, 'a');
+            s[pos] = stopper;
+            BOOST_TEST(plain_ascii_prefix(s) == pos);
+            if (pos != 0)
+                BOOST_TEST(plain_ascii_prefix(std::string_view(s).substr(1)) == pos - 1);
+        }
+
+    BOOST_TEST(plain_ascii_prefix(" ~/$") == 4u);
+}
+
+BOOST_AUTO_TEST_CASE(fuzz_equivalence) {
+    using namespace boost::mqtt5::detail;
+
+    std::mt19937 rng(1234);
+    for (int i = 0; i < 20'000; ++i) {
+        auto s = random_string(rng, i % 10 ? 48 : 300);
+
+        BOOST_TEST_CONTEXT("string: " << s) {
+            BOOST_TEST((validate_mqtt_utf8(s) ==
+                reference::validate_impl(s, is_valid_string_size, is_utf8)));
+            BOOST_TEST((validate_topic_name(s) ==
+                reference::validate_impl(s, is_valid_topic_size, is_utf8_no_wildcard)));
+            BOOST_TEST((validate_topic_filter(s) == reference::validate_topic_filter(s)));
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -51,6 +51,33 @@ BOOST_AUTO_TEST_CASE(pid_overrun) {
     BOOST_TEST(handlers_called == expected_handlers_called);
 }
 
+BOOST_AUTO_TEST_CASE(coalesced_pid_overrun) {
+    constexpr int expected_handlers_called = 1;
+    int handlers_called = 0;
+
+    asio::io_context ioc;
+    using client_service_type = test::overrun_client<asio::ip::tcp::socket>;
+    auto svc_ptr = std::make_shared<client_service_type>(ioc.get_executor());
+    svc_ptr->coalesce_subscriptions(true);
+
+    auto handler = [&handlers_called](error_code ec, std::vector<reason_code> rcs, suback_props) {
+        ++handlers_called;
+        BOOST_TEST(ec == client::error::pid_overrun);
+        BOOST_TEST_REQUIRE(rcs.size() == 1u);
+        BOOST_TEST(rcs[0] == reason_codes::empty);
+    };
+
+    detail::subscribe_op<
+        client_service_type, decltype(handler)
+    > { svc_ptr, std::move(handler) }
+    .perform(
+        { { "topic", { qos_e::exactly_once } } }, subscribe_props {}
+    );
+
+    ioc.run_for(std::chrono::milliseconds(500));
+    BOOST_TEST(handlers_called == expected_handlers_called);
+}
+
 void run_test(
     error_code expected_ec, const std::vector<subscribe_topic>& topics,
     const subscribe_props& sprops = {}, const connack_props& cprops = {}
@@ -0,0 +1,154 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mqtt5/types.hpp>
+
+#include <boost/mqtt5/detail/control_packet.hpp>
+#include <boost/mqtt5/detail/subscription_registry.hpp>
+
+#include <boost/mqtt5/impl/codecs/message_encoders.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <string>
+
+using namespace boost::mqtt5;
+
+BOOST_AUTO_TEST_SUITE(subscription_registry/*, *boost::unit_test::disabled()*/)
+
+BOOST_AUTO_TEST_CASE(registry_disabled) {
+    detail::subscription_registry registry;
+    registry.add({ "topic", subscribe_options {} }, subscribe_props {});
+    BOOST_TEST(registry.empty());
+}
+
+BOOST_AUTO_TEST_CASE(registry_add_remove) {
+    detail::subscription_registry registry(true);
+
+    subscribe_props props;
+    props[prop::subscription_identifier] = 7;
+
+    registry.add({ "a", subscribe_options {} }, subscribe_props {});
+    registry.add({ "b", subscribe_options {} }, props);
+    registry.add({ "c", subscribe_options {} }, props);
+    BOOST_TEST(registry.size() == 3u);
+
+    // subscribing to the same Topic Filter replaces the Subscription
+    auto opts = subscribe_options { qos_e::at_most_once };
+    registry.add({ "b", opts }, subscribe_props {});
+    BOOST_TEST(registry.size() == 3u);
+
+    auto batches = registry.batches(detail::default_max_send_size);
+    BOOST_TEST_REQUIRE(batches.size() == 2u);
+    for (const auto& batch : batches) {
+        if (batch.props[prop::subscription_identifier].has_value()) {
+            BOOST_TEST_REQUIRE(batch.topics.size() == 1u);
+            BOOST_TEST(batch.topics[0].topic_filter == "c");
+        }
+        else {
+            BOOST_TEST(batch.topics.size() == 2u);
+            for (const auto& topic : batch.topics)
+                if (topic.topic_filter == "b")
+                    BOOST_TEST((topic.sub_opts.max_qos == qos_e::at_most_once));
+        }
+    }
+
+    registry.remove("a");
+    registry.remove("b");
+    registry.remove("unknown");
+    BOOST_TEST(registry.size() == 1u);
+    BOOST_TEST(registry.batches(detail::default_max_send_size).size() == 1u);
+
+    registry.remove("c");
+    BOOST_TEST(registry.empty());
+    BOOST_TEST(registry.batches(detail::default_max_send_size).empty());
+}
+
+BOOST_AUTO_TEST_CASE(registry_batches_respect_max_packet_size) {
+    constexpr size_t num_filters = 5000;
+    constexpr size_t max_packet_size = 1024;
+
+    detail::subscription_registry registry(true);
+    for (size_t i = 0; i < num_filters; ++i)
+        registry.add(
+            { "site/" + std::to_string(i) + "/temperature", subscribe_options {} },
+            subscribe_props {}
+        );
+
+    auto round = registry.round();
+    auto batches = registry.batches(max_packet_size);
+    BOOST_TEST(registry.round() != round);
+
+    size_t num_topics = 0;
+    for (size_t i = 0; i < batches.size(); ++i) {
+        const auto& batch = batches[i];
+        auto encoded = encoders::encode_subscribe(1, batch.topics, batch.props);
+        BOOST_TEST(encoded.size() <= max_packet_size);
+        num_topics += batch.topics.size();
+
+        // the packet is full if the next Topic Filter would not fit in it
+        if (i + 1 < batches.size()) {
+            auto topics = batch.topics;
+            topics.push_back(batches[i + 1].topics.front());
+            BOOST_TEST(
+                encoders::encode_subscribe(1, topics, batch.props).size() >
+                max_packet_size
+            );
+        }
+    }
+    BOOST_TEST(num_topics == num_filters);
+}
+
+BOOST_AUTO_TEST_CASE(registry_many_groups) {
+    constexpr int num_groups = 2000;
+
+    auto props_of = [](int i) {
+        subscribe_props props;
+        props[prop::subscription_identifier] = i + 1;
+        // equal User Properties in every other group
+        props[prop::user_property].emplace_back("group", std::to_string(i % 2));
+        return props;
+    };
+
+    // interleaved, so that consecutive additions never share a group
+    detail::subscription_registry registry(true);
+    for (int round = 0; round < 2; ++round)
+        for (int i = 0; i < num_groups; ++i)
+            registry.add(
+                {
+                    std::to_string(round) + "/" + std::to_string(i),
+                    subscribe_options {}
+                },
+                props_of(i)
+            );
+    BOOST_TEST(registry.size() == 2u * num_groups);
+
+    auto batches = registry.batches(detail::default_max_send_size);
+    BOOST_TEST_REQUIRE(batches.size() == size_t(num_groups));
+    for (const auto& batch : batches) {
+        BOOST_TEST_REQUIRE(batch.topics.size() == 2u);
+        auto i = std::stoi(batch.topics[0].topic_filter.substr(2));
+        BOOST_TEST(*batch.props[prop::subscription_identifier] == i + 1);
+        BOOST_TEST(batch.topics[1].topic_filter == "1/" + std::to_string(i));
+    }
+
+    // emptied groups are reused
+    for (int round = 0; round < 2; ++round)
+        for (int i = 0; i < num_groups; i += 2)
+            registry.remove(std::to_string(round) + "/" + std::to_string(i));
+    registry.add({ "new", subscribe_options {} }, props_of(num_groups));
+    registry.add({ "0/1", subscribe_options {} }, props_of(1));
+
+    batches = registry.batches(detail::default_max_send_size);
+    BOOST_TEST(batches.size() == size_t(num_groups / 2 + 1));
+    // the lowest emptied group is reused first
+    BOOST_TEST_REQUIRE(batches[0].topics.size() == 1u);
+    BOOST_TEST(batches[0].topics[0].topic_filter == "new");
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,287 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mqtt5/detail/client_timer.hpp>
+#include <boost/mqtt5/detail/timer_wheel.hpp>
+
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/deferred.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/experimental/parallel_group.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+using namespace boost::mqtt5;
+using error_code = boost::system::error_code;
+using detail::timer_wheel;
+using detail::wheel_timer;
+
+namespace asio = boost::asio;
+namespace asioex = boost::asio::experimental;
+
+using namespace std::chrono_literals;
+using clock_type = timer_wheel::clock_type;
+using duration = clock_type::duration;
+
+BOOST_AUTO_TEST_SUITE(timer_wheel_unit/*, *boost::unit_test::disabled()*/)
+
+BOOST_AUTO_TEST_CASE(expiry_order) {
+    constexpr int expected_handlers_called = 3;
+    std::vector<int> order;
+
+    asio::io_context ioc;
+    wheel_timer t0(ioc.get_executor()), t1(ioc.get_executor()), t2(ioc.get_executor());
+
+    auto start = clock_type::now();
+    auto wait = [&order, start](wheel_timer& t, int n, duration d) {
+        t.expires_after(d);
+        t.async_wait([&order, start, n, d](error_code ec) {
+            order.push_back(n);
+            BOOST_TEST(!ec);
+            // rounded up to the tick, never early
+            BOOST_TEST((clock_type::now() - start >= d));
+        });
+    };
+    wait(t0, 0, 350ms);
+    wait(t1, 1, 50ms);
+    wait(t2, 2, 200ms);
+
+    ioc.run();
+    BOOST_TEST(int(order.size()) == expected_handlers_called);
+    BOOST_TEST((order == std::vector<int> { 1, 2, 0 }));
+}
+
+BOOST_AUTO_TEST_CASE(shared_wheel) {
+    asio::io_context ioc;
+    wheel_timer t0(ioc.get_executor()), t1(ioc.get_executor());
+
+    auto& wheel = asio::use_service<timer_wheel>(ioc);
+    BOOST_TEST(wheel.num_waits() == 0u);
+
+    t0.expires_after(10s);
+    t0.async_wait([](error_code) {});
+    t1.expires_after(10s);
+    t1.async_wait([](error_code) {});
+    BOOST_TEST(wheel.num_waits() == 2u);
+
+    t0.cancel();
+    t1.cancel();
+    BOOST_TEST(wheel.num_waits() == 0u);
+    ioc.run();
+}
+
+BOOST_AUTO_TEST_CASE(cancel_wait) {
+    constexpr int expected_handlers_called = 1;
+    int handlers_called = 0;
+
+    asio::io_context ioc;
+    wheel_timer timer(ioc.get_executor());
+
+    timer.expires_after(10s);
+    timer.async_wait([&handlers_called](error_code ec) {
+        ++handlers_called;
+        BOOST_TEST(ec == asio::error::operation_aborted);
+    });
+    asio::post(ioc, [&timer] { BOOST_TEST(timer.cancel() == 1u); });
+
+    // the wheel stops ticking once it has no pending waits
+    auto start = clock_type::now();
+    ioc.run();
+    BOOST_TEST((clock_type::now() - start < 1s));
+    BOOST_TEST(handlers_called == expected_handlers_called);
+}
+
+BOOST_AUTO_TEST_CASE(expires_after_cancels_wait) {
+    constexpr int expected_handlers_called = 2;
+    int handlers_called = 0;
+
+    asio::io_context ioc;
+    wheel_timer timer(ioc.get_executor());
+
+    timer.expires_after(10s);
+    timer.async_wait([&handlers_called](error_code ec) {
+        ++handlers_called;
+        BOOST_TEST(ec == asio::error::operation_aborted);
+    });
+
+    BOOST_TEST(timer.expires_after(100ms) == 1u);
+    timer.async_wait([&handlers_called](error_code ec) {
+        ++handlers_called;
+        BOOST_TEST(!ec);
+    });
+
+    ioc.run();
+    BOOST_TEST(handlers_called == expected_handlers_called);
+}
+
+BOOST_AUTO_TEST_CASE(per_operation_cancellation) {
+    constexpr int expected_handlers_called = 1;
+    int handlers_called = 0;
+
+    asio::io_context ioc;
+    wheel_timer timer(ioc.get_executor());
+    asio::cancellation_signal signal;
+
+    timer.expires_after(10s);
+    timer.async_wait(
+        asio::bind_cancellation_slot(
+            signal.slot(),
+            [&handlers_called](error_code ec) {
+                ++handlers_called;
+                BOOST_TEST(ec == asio::error::operation_aborted);
+            }
+        )
+    );
+    asio::post(ioc, [&signal] {
+        signal.emit(asio::cancellation_type_t::terminal);
+    });
+
+    ioc.run();
+    BOOST_TEST(handlers_called == expected_handlers_called);
+}
+
+BOOST_AUTO_TEST_CASE(wait_longer_than_revolution) {
+    int handlers_called = 0;
+
+    asio::io_context ioc;
+    wheel_timer timer(ioc.get_executor());
+
+    // lands in the slot of the first tick, one revolution later
+    timer.expires_after(timer_wheel::tick * (timer_wheel::num_slots + 1));
+    timer.async_wait([&handlers_called](error_code ec) {
+        ++handlers_called;
+        BOOST_TEST(ec == asio::error::operation_aborted);
+    });
+
+    ioc.run_for(500ms);
+    BOOST_TEST(handlers_called == 0);
+
+    timer.cancel();
+    ioc.restart();
+    ioc.run();
+    BOOST_TEST(handlers_called == 1);
+}
+
+BOOST_AUTO_TEST_CASE(never_expires) {
+    int handlers_called = 0;
+
+    asio::io_context ioc;
+    wheel_timer timer(ioc.get_executor());
+
+    // as the keep alive timer when the Keep Alive is 0
+    timer.expires_after(duration((std::numeric_limits<duration::rep>::max)()));
+    timer.async_wait([&handlers_called](error_code ec) {
+        ++handlers_called;
+        BOOST_TEST(ec == asio::error::operation_aborted);
+    });
+
+    ioc.run_for(300ms);
+    BOOST_TEST(handlers_called == 0);
+    BOOST_TEST(asio::use_service<timer_wheel>(ioc).num_waits() == 1u);
+
+    timer.cancel();
+    ioc.restart();
+    ioc.run();
+    BOOST_TEST(handlers_called == 1);
+}
+
+// as the read timer raced against a read in read_op
+BOOST_AUTO_TEST_CASE(parallel_group_wait_for_one) {
+    constexpr int expected_handlers_called = 1;
+    int handlers_called = 0;
+
+    asio::io_context ioc;
+    asio::steady_timer read(ioc);
+    wheel_timer timeout(ioc.get_executor());
+
+    read.expires_after(50ms);
+    timeout.expires_after(10s);
+
+    auto start = clock_type::now();
+    asioex::make_parallel_group(
+        read.async_wait(asio::deferred),
+        timeout.async_wait(asio::deferred)
+    ).async_wait(
+        asioex::wait_for_one(),
+        [&handlers_called](
+            std::array<std::size_t, 2> ord, error_code read_ec, error_code timeout_ec
+        ) {
+            ++handlers_called;
+            BOOST_TEST(ord[0] == 0u);
+            BOOST_TEST(!read_ec);
+            BOOST_TEST(timeout_ec == asio::error::operation_aborted);
+        }
+    );
+
+    ioc.run();
+    BOOST_TEST((clock_type::now() - start < 1s));
+    BOOST_TEST(handlers_called == expected_handlers_called);
+}
+
+BOOST_AUTO_TEST_CASE(client_timer_use_wheel) {
+    constexpr int expected_handlers_called = 2;
+    int handlers_called = 0;
+
+    asio::io_context ioc;
+    detail::client_timer timer(ioc.get_executor());
+
+    // a steady timer unless the wheel is opted into
+    timer.expires_after(50ms);
+    timer.async_wait([&handlers_called](error_code ec) {
+        ++handlers_called;
+        BOOST_TEST(!ec);
+    });
+    ioc.run();
+    BOOST_TEST(asio::has_service<timer_wheel>(ioc) == false);
+
+    timer.use_wheel(true);
+    timer.expires_after(50ms);
+    timer.async_wait([&handlers_called](error_code ec) {
+        ++handlers_called;
+        BOOST_TEST(!ec);
+    });
+    BOOST_TEST(asio::use_service<timer_wheel>(ioc).num_waits() == 1u);
+    ioc.restart();
+    ioc.run();
+
+    BOOST_TEST(handlers_called == expected_handlers_called);
+}
+
+BOOST_AUTO_TEST_CASE(remove_wait) {
+    int handlers_called = 0;
+
+    asio::io_context ioc;
+    auto& wheel = asio::use_service<timer_wheel>(ioc);
+    timer_wheel::entry e;
+
+    wheel.schedule(
+        e, clock_type::now() + 10s,
+        [&handlers_called](error_code) { ++handlers_called; },
+        ioc.get_executor()
+    );
+    BOOST_TEST(wheel.num_waits() == 1u);
+
+    // as a reply received before its deadline
+    wheel.remove(e);
+    BOOST_TEST(wheel.num_waits() == 0u);
+
+    auto start = clock_type::now();
+    ioc.run();
+    BOOST_TEST((clock_type::now() - start < 1s));
+    BOOST_TEST(handlers_called == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
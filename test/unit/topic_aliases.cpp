@@ -0,0 +1,122 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mqtt5/detail/topic_aliases.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+
+using namespace boost::mqtt5;
+
+BOOST_AUTO_TEST_SUITE(topic_aliases/*, *boost::unit_test::disabled()*/)
+
+BOOST_AUTO_TEST_CASE(inbound_aliases) {
+    detail::inbound_topic_aliases aliases;
+    BOOST_TEST(!aliases.valid(1));
+
+    aliases.reset(3);
+    BOOST_TEST(!aliases.valid(0));
+    BOOST_TEST(aliases.valid(3));
+    BOOST_TEST(!aliases.valid(4));
+    BOOST_TEST(!aliases.find(1));
+
+    aliases.insert(2, "topic");
+    auto mapped = aliases.find(2);
+    BOOST_TEST(*mapped == "topic");
+
+    // remapping does not affect topics already handed out
+    aliases.insert(2, "other");
+    BOOST_TEST(*mapped == "topic");
+    BOOST_TEST(*aliases.find(2) == "other");
+
+    aliases.reset(3);
+    BOOST_TEST(!aliases.find(2));
+}
+
+BOOST_AUTO_TEST_CASE(outbound_aliases_disabled) {
+    detail::outbound_topic_aliases aliases;
+    aliases.reset(10);
+    BOOST_TEST(aliases.acquire("topic").alias == 0);
+}
+
+BOOST_AUTO_TEST_CASE(outbound_aliases_confirmation) {
+    detail::outbound_topic_aliases aliases(true);
+    aliases.reset(10);
+
+    auto first = aliases.acquire("topic");
+    BOOST_TEST(first.alias == 1);
+    BOOST_TEST(!first.alias_only);
+
+    // the mapping PUBLISH has not been written yet
+    auto second = aliases.acquire("topic");
+    BOOST_TEST(second.alias == 1);
+    BOOST_TEST(!second.alias_only);
+
+    aliases.release(first, true);
+    aliases.release(second, false);
+
+    auto third = aliases.acquire("topic");
+    BOOST_TEST(third.alias == 1);
+    BOOST_TEST(third.alias_only);
+    aliases.release(third, true);
+
+    BOOST_TEST(aliases.acquire("other").alias == 2);
+}
+
+BOOST_AUTO_TEST_CASE(outbound_aliases_lru) {
+    detail::outbound_topic_aliases aliases(true);
+    aliases.reset(2);
+
+    auto a = aliases.acquire("a");
+    auto b = aliases.acquire("b");
+    aliases.release(a, true);
+    aliases.release(b, true);
+
+    // "a" becomes the most recently used
+    aliases.release(aliases.acquire("a"), true);
+
+    auto c = aliases.acquire("c");
+    BOOST_TEST(c.alias == b.alias);
+    BOOST_TEST(!c.alias_only);
+
+    // both aliases are used by unwritten PUBLISH packets
+    auto a2 = aliases.acquire("a");
+    BOOST_TEST(a2.alias_only);
+    BOOST_TEST(aliases.acquire("d").alias == 0);
+
+    aliases.release(c, true);
+    auto d = aliases.acquire("d");
+    BOOST_TEST(d.alias == c.alias);
+
+    // a release of an assignment made before the mapping was reassigned is ignored
+    aliases.release(c, true);
+    aliases.release(d, true);
+    aliases.release(a2, true);
+    BOOST_TEST(aliases.acquire("d").alias_only);
+}
+
+BOOST_AUTO_TEST_CASE(outbound_aliases_reset) {
+    detail::outbound_topic_aliases aliases(true);
+    aliases.reset(2);
+
+    auto a = aliases.acquire("a");
+    auto generation = aliases.generation();
+    aliases.reset(2);
+    BOOST_TEST(aliases.generation() != generation);
+
+    // releases from the previous Network Connection are ignored
+    aliases.release(a, true);
+    auto a2 = aliases.acquire("a");
+    BOOST_TEST(a2.alias == 1);
+    BOOST_TEST(!a2.alias_only);
+
+    aliases.reset(0);
+    BOOST_TEST(aliases.acquire("a").alias == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,238 @@
+//
+// Copyright (c) 2023-2025 Ivica Siladic, Bruno Iljazovic, Korina Simicevic
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mqtt5/error.hpp>
+#include <boost/mqtt5/topic_router.hpp>
+#include <boost/mqtt5/types.hpp>
+
+#include <boost/mqtt5/detail/topic_trie.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace boost::mqtt5;
+
+BOOST_AUTO_TEST_SUITE(topic_routing/*, *boost::unit_test::disabled()*/)
+
+std::vector<uint32_t> match(const detail::topic_trie& trie, std::string_view topic) {
+    std::vector<uint32_t> rv;
+    trie.match(topic, [&rv](uint32_t value) { rv.push_back(value); });
+    std::sort(rv.begin(), rv.end());
+    return rv;
+}
+
+using values = std::vector<uint32_t>;
+
+BOOST_AUTO_TEST_CASE(trie_exact_match) {
+    detail::topic_trie trie;
+    trie.insert("sport/tennis/player1", 1);
+    trie.insert("sport/tennis", 2);
+    trie.insert("/sport", 3);
+    trie.insert("sport/", 4);
+
+    BOOST_TEST(trie.size() == 4u);
+    BOOST_TEST(match(trie, "sport/tennis/player1") == values { 1 });
+    BOOST_TEST(match(trie, "sport/tennis") == values { 2 });
+    BOOST_TEST(match(trie, "/sport") == values { 3 });
+    BOOST_TEST(match(trie, "sport/") == values { 4 });
+    BOOST_TEST(match(trie, "sport").empty());
+    BOOST_TEST(match(trie, "sport/tennis/player2").empty());
+}
+
+BOOST_AUTO_TEST_CASE(trie_multi_level_wildcard) {
+    detail::topic_trie trie;
+    trie.insert("sport/tennis/player1/#", 1);
+    trie.insert("#", 2);
+
+    BOOST_TEST(match(trie, "sport/tennis/player1") == (values { 1, 2 }));
+    BOOST_TEST(match(trie, "sport/tennis/player1/ranking") == (values { 1, 2 }));
+    BOOST_TEST(match(trie, "sport/tennis/player1/score/wimbledon") == (values { 1, 2 }));
+    BOOST_TEST(match(trie, "sport/tennis") == values { 2 });
+}
+
+BOOST_AUTO_TEST_CASE(trie_single_level_wildcard) {
+    detail::topic_trie trie;
+    trie.insert("sport/tennis/+", 1);
+    trie.insert("sport/+", 2);
+    trie.insert("+/+", 3);
+    trie.insert("/+", 4);
+    trie.insert("+", 5);
+
+    BOOST_TEST(match(trie, "sport/tennis/player1") == values { 1 });
+    BOOST_TEST(match(trie, "sport/tennis/player2") == values { 1 });
+    BOOST_TEST(match(trie, "sport/tennis/player1/ranking").empty());
+    BOOST_TEST(match(trie, "sport") == values { 5 });
+    BOOST_TEST(match(trie, "sport/") == (values { 2, 3 }));
+    BOOST_TEST(match(trie, "/finance") == (values { 3, 4 }));
+}
+
+BOOST_AUTO_TEST_CASE(trie_dollar_topics) {
+    detail::topic_trie trie;
+    trie.insert("#", 1);
+    trie.insert("+/monitor/Clients", 2);
+    trie.insert("$SYS/#", 3);
+    trie.insert("$SYS/monitor/+", 4);
+
+    BOOST_TEST(match(trie, "$SYS/monitor/Clients") == (values { 3, 4 }));
+    BOOST_TEST(match(trie, "SYS/monitor/Clients") == (values { 1, 2 }));
+}
+
+BOOST_AUTO_TEST_CASE(trie_insert_erase) {
+    detail::topic_trie trie;
+    BOOST_TEST(trie.insert("a/b/c", 1) == detail::topic_trie::npos);
+    BOOST_TEST(trie.insert("a/b/c", 2) == 1u);
+    BOOST_TEST(trie.insert("a/+/#", 3) == detail::topic_trie::npos);
+    BOOST_TEST(trie.size() == 2u);
+
+    BOOST_TEST(trie.find("a/b/c") == 2u);
+    BOOST_TEST(trie.find("a/+/#") == 3u);
+    BOOST_TEST(trie.find("a/b") == detail::topic_trie::npos);
+
+    BOOST_TEST(trie.erase("a/b") == detail::topic_trie::npos);
+    BOOST_TEST(trie.erase("a/b/c") == 2u);
+    BOOST_TEST(trie.erase("a/b/c") == detail::topic_trie::npos);
+    BOOST_TEST(match(trie, "a/b/c") == values { 3 });
+
+    BOOST_TEST(trie.erase("a/+/#") == 3u);
+    BOOST_TEST(trie.empty());
+    BOOST_TEST(match(trie, "a/b/c").empty());
+
+    // erased nodes are reused
+    trie.insert("x/y/z", 4);
+    BOOST_TEST(match(trie, "x/y/z") == values { 4 });
+}
+
+BOOST_AUTO_TEST_CASE(router_route) {
+    topic_router router;
+    std::vector<std::string> calls;
+
+    auto handler = [&calls](std::string name) {
+        return [&calls, name](
+            std::string_view topic, std::string_view payload, const publish_props&
+        ) {
+            calls.push_back(name + ":" + std::string(topic) + ":" + std::string(payload));
+        };
+    };
+
+    BOOST_TEST(!router.add("sensors/+/temperature", handler("temp")));
+    BOOST_TEST(!router.add("sensors/#", handler("all")));
+    BOOST_TEST(!router.add("$share/group/sensors/kitchen/+", handler("shared")));
+    BOOST_TEST(router.size() == 3u);
+
+    BOOST_TEST(router.route("sensors/kitchen/temperature", "21", publish_props {}) == 3u);
+    std::sort(calls.begin(), calls.end());
+    BOOST_TEST(calls == (std::vector<std::string> {
+        "all:sensors/kitchen/temperature:21",
+        "shared:sensors/kitchen/temperature:21",
+        "temp:sensors/kitchen/temperature:21"
+    }));
+
+    calls.clear();
+    BOOST_TEST(router.route("sensors/hall/humidity", "40", publish_props {}) == 1u);
+    BOOST_TEST(calls == std::vector<std::string> { "all:sensors/hall/humidity:40" });
+
+    calls.clear();
+    BOOST_TEST(router.route("actuators/door", "open", publish_props {}) == 0u);
+    BOOST_TEST(calls.empty());
+}
+
+BOOST_AUTO_TEST_CASE(router_same_routing_key) {
+    topic_router router;
+    int first = 0, second = 0, third = 0;
+
+    router.add("a/+", [&first](auto, auto, const auto&) { ++first; });
+    router.add("$share/g1/a/+", [&second](auto, auto, const auto&) { ++second; });
+    router.add("$share/g2/a/+", [&third](auto, auto, const auto&) { ++third; });
+
+    BOOST_TEST(router.route("a/b", "", publish_props {}) == 3u);
+    BOOST_TEST((first == 1 && second == 1 && third == 1));
+
+    BOOST_TEST(router.remove("$share/g1/a/+"));
+    BOOST_TEST(!router.remove("$share/g1/a/+"));
+    BOOST_TEST(router.route("a/b", "", publish_props {}) == 2u);
+    BOOST_TEST((first == 2 && second == 1 && third == 2));
+
+    BOOST_TEST(router.remove("a/+"));
+    BOOST_TEST(router.route("a/b", "", publish_props {}) == 1u);
+    BOOST_TEST((first == 2 && second == 1 && third == 3));
+
+    BOOST_TEST(router.remove("$share/g2/a/+"));
+    BOOST_TEST(router.route("a/b", "", publish_props {}) == 0u);
+    BOOST_TEST(router.empty());
+}
+
+BOOST_AUTO_TEST_CASE(router_replace_handler) {
+    topic_router router;
+    int first = 0, second = 0;
+
+    router.add("a/b", [&first](auto, auto, const auto&) { ++first; });
+    router.add("a/b", [&second](auto, auto, const auto&) { ++second; });
+    BOOST_TEST(router.size() == 1u);
+
+    router.route("a/b", "", publish_props {});
+    BOOST_TEST((first == 0 && second == 1));
+}
+
+BOOST_AUTO_TEST_CASE(router_invalid_filters) {
+    topic_router router;
+    auto noop = [](auto, auto, const auto&) {};
+
+    BOOST_TEST(router.add("", noop) == client::error::invalid_topic);
+    BOOST_TEST(router.add("a/#/b", noop) == client::error::invalid_topic);
+    BOOST_TEST(router.add("a+/b", noop) == client::error::invalid_topic);
+    BOOST_TEST(router.add("$share/group", noop) == client::error::invalid_topic);
+    BOOST_TEST(router.add("$share//a", noop) == client::error::invalid_topic);
+    BOOST_TEST(router.empty());
+    BOOST_TEST(!router.remove("a/#/b"));
+}
+
+BOOST_AUTO_TEST_CASE(router_subscription_ids) {
+    topic_router router;
+    int first = 0, second = 0, by_filter = 0;
+
+    auto id_1 = router.add_subscription([&first](auto, auto, const auto&) { ++first; });
+    auto id_2 = router.add_subscription([&second](auto, auto, const auto&) { ++second; });
+    BOOST_TEST(id_1 == 1);
+    BOOST_TEST(id_2 == 2);
+    BOOST_TEST(router.size() == 2u);
+
+    publish_props props;
+    props[prop::subscription_identifier] = { id_2, id_1, 42 };
+    BOOST_TEST(router.route("any/topic", "", props) == 2u);
+    BOOST_TEST((first == 1 && second == 1));
+
+    // without Subscription Identifiers only Topic Filters are matched
+    router.add("any/+", [&by_filter](auto, auto, const auto&) { ++by_filter; });
+    BOOST_TEST(router.route("any/topic", "", publish_props {}) == 1u);
+    BOOST_TEST((first == 1 && second == 1 && by_filter == 1));
+
+    props[prop::subscription_identifier] = id_1;
+    BOOST_TEST(router.route("any/topic", "", props) == 2u);
+    BOOST_TEST((first == 2 && second == 1 && by_filter == 2));
+
+    BOOST_TEST(router.remove_subscription(id_1));
+    BOOST_TEST(!router.remove_subscription(id_1));
+    BOOST_TEST(!router.remove_subscription(0));
+    BOOST_TEST(!router.remove_subscription(42));
+    BOOST_TEST(router.route("other", "", props) == 0u);
+    BOOST_TEST(first == 2);
+
+    // identifiers of removed subscriptions are reused
+    BOOST_TEST(router.add_subscription([](auto, auto, const auto&) {}) == id_1);
+    BOOST_TEST(router.size() == 3u);
+
+    router.clear();
+    BOOST_TEST(router.empty());
+    BOOST_TEST(router.add_subscription([](auto, auto, const auto&) {}) == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
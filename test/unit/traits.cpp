@@ -9,6 +9,7 @@
 
 #include <boost/mqtt5/detail/any_authenticator.hpp>
 #include <boost/mqtt5/detail/async_traits.hpp>
+#include <boost/mqtt5/detail/channel_traits.hpp>
 
 #include <boost/asio/async_result.hpp>
 #include <boost/asio/ip/tcp.hpp>
@@ -16,6 +17,8 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/type_traits/remove_cv_ref.hpp>
 
+#include <cstddef>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -83,6 +86,33 @@ void tcp_layers_test() {
     BOOST_STATIC_ASSERT(std::is_same_v<boost::remove_cv_ref_t<decltype(llayer)>, tcp_layer>);
 }
 
+// an allocator referring to an arena, as its state
+template <typename T>
+struct arena_allocator {
+    using value_type = T;
+    void* arena = nullptr;
+
+    arena_allocator() = default;
+    template <typename U>
+    arena_allocator(const arena_allocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(std::size_t n) { return std::allocator<T>().allocate(n); }
+    void deallocate(T* p, std::size_t n) { std::allocator<T>().deallocate(p, n); }
+
+    template <typename U>
+    bool operator==(const arena_allocator<U>& other) const { return arena == other.arena; }
+    template <typename U>
+    bool operator!=(const arena_allocator<U>& other) const { return arena != other.arena; }
+};
+
+// the channel buffer never uses a default-constructed stateful allocator
+BOOST_STATIC_ASSERT(std::is_same_v<
+    detail::channel_allocator_t<std::allocator<void>, int>, std::allocator<int>
+>);
+BOOST_STATIC_ASSERT(std::is_same_v<
+    detail::channel_allocator_t<arena_allocator<void>, int>, std::allocator<int>
+>);
+
 #ifdef BOOST_MQTT5_EXTRA_DEPS
 
 namespace beast = boost::beast;